@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../main.c ../panelEvents.c ../panelNv.c ../buttonscan.c ../max6951.c ../../VLCBlib_PIC/boot.c ../../VLCBlib_PIC/can18_can_2.c ../../VLCBlib_PIC/event_acknowledge.c ../../VLCBlib_PIC/event_coe.c ../../VLCBlib_PIC/event_producer_happening.c ../../VLCBlib_PIC/event_teach_large.c ../../VLCBlib_PIC/messageQueue.c ../../VLCBlib_PIC/mns.c ../../VLCBlib_PIC/nv.c ../../VLCBlib_PIC/nvm.c ../../VLCBlib_PIC/statusLeds2.c ../../VLCBlib_PIC/ticktime.c ../../VLCBlib_PIC/timedResponse.c ../../VLCBlib_PIC/vlcb.c ../../VLCBlib_PIC/event_consumer_simple.c
+SOURCEFILES_QUOTED_IF_SPACED=../main.c ../panelEvents.c ../panelNv.c ../buttonscan.c ../max6951.c ../fastClock.c ../startup.c ../ledSnapshot.c ../flashSchedule.c ../scheduler.c ../portArbiter.c ../profile.c ../panelDiag.c ../latency.c ../busMonitor.c ../opCost.c ../trace.c ../ledTimer.c ../../VLCBlib_PIC/boot.c ../../VLCBlib_PIC/can18_can_2.c ../../VLCBlib_PIC/event_acknowledge.c ../../VLCBlib_PIC/event_coe.c ../../VLCBlib_PIC/event_producer_happening.c ../../VLCBlib_PIC/event_teach_large.c ../../VLCBlib_PIC/messageQueue.c ../../VLCBlib_PIC/mns.c ../../VLCBlib_PIC/nv.c ../../VLCBlib_PIC/nvm.c ../../VLCBlib_PIC/statusLeds2.c ../../VLCBlib_PIC/ticktime.c ../../VLCBlib_PIC/timedResponse.c ../../VLCBlib_PIC/vlcb.c ../../VLCBlib_PIC/event_consumer_simple.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.p1 ${OBJECTDIR}/_ext/1472/panelEvents.p1 ${OBJECTDIR}/_ext/1472/panelNv.p1 ${OBJECTDIR}/_ext/1472/buttonscan.p1 ${OBJECTDIR}/_ext/1472/max6951.p1 ${OBJECTDIR}/_ext/1954642981/boot.p1 ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1 ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1 ${OBJECTDIR}/_ext/1954642981/event_coe.p1 ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1 ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1 ${OBJECTDIR}/_ext/1954642981/messageQueue.p1 ${OBJECTDIR}/_ext/1954642981/mns.p1 ${OBJECTDIR}/_ext/1954642981/nv.p1 ${OBJECTDIR}/_ext/1954642981/nvm.p1 ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1 ${OBJECTDIR}/_ext/1954642981/ticktime.p1 ${OBJECTDIR}/_ext/1954642981/timedResponse.p1 ${OBJECTDIR}/_ext/1954642981/vlcb.p1 ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.p1.d ${OBJECTDIR}/_ext/1472/panelEvents.p1.d ${OBJECTDIR}/_ext/1472/panelNv.p1.d ${OBJECTDIR}/_ext/1472/buttonscan.p1.d ${OBJECTDIR}/_ext/1472/max6951.p1.d ${OBJECTDIR}/_ext/1954642981/boot.p1.d ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1.d ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1.d ${OBJECTDIR}/_ext/1954642981/event_coe.p1.d ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1.d ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1.d ${OBJECTDIR}/_ext/1954642981/messageQueue.p1.d ${OBJECTDIR}/_ext/1954642981/mns.p1.d ${OBJECTDIR}/_ext/1954642981/nv.p1.d ${OBJECTDIR}/_ext/1954642981/nvm.p1.d ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1.d ${OBJECTDIR}/_ext/1954642981/ticktime.p1.d ${OBJECTDIR}/_ext/1954642981/timedResponse.p1.d ${OBJECTDIR}/_ext/1954642981/vlcb.p1.d ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.p1 ${OBJECTDIR}/_ext/1472/panelEvents.p1 ${OBJECTDIR}/_ext/1472/panelNv.p1 ${OBJECTDIR}/_ext/1472/buttonscan.p1 ${OBJECTDIR}/_ext/1472/max6951.p1 ${OBJECTDIR}/_ext/1472/fastClock.p1 ${OBJECTDIR}/_ext/1472/startup.p1 ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 ${OBJECTDIR}/_ext/1472/flashSchedule.p1 ${OBJECTDIR}/_ext/1472/scheduler.p1 ${OBJECTDIR}/_ext/1472/portArbiter.p1 ${OBJECTDIR}/_ext/1472/profile.p1 ${OBJECTDIR}/_ext/1472/panelDiag.p1 ${OBJECTDIR}/_ext/1472/latency.p1 ${OBJECTDIR}/_ext/1472/busMonitor.p1 ${OBJECTDIR}/_ext/1472/opCost.p1 ${OBJECTDIR}/_ext/1472/trace.p1 ${OBJECTDIR}/_ext/1472/ledTimer.p1 ${OBJECTDIR}/_ext/1954642981/boot.p1 ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1 ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1 ${OBJECTDIR}/_ext/1954642981/event_coe.p1 ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1 ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1 ${OBJECTDIR}/_ext/1954642981/messageQueue.p1 ${OBJECTDIR}/_ext/1954642981/mns.p1 ${OBJECTDIR}/_ext/1954642981/nv.p1 ${OBJECTDIR}/_ext/1954642981/nvm.p1 ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1 ${OBJECTDIR}/_ext/1954642981/ticktime.p1 ${OBJECTDIR}/_ext/1954642981/timedResponse.p1 ${OBJECTDIR}/_ext/1954642981/vlcb.p1 ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.p1.d ${OBJECTDIR}/_ext/1472/panelEvents.p1.d ${OBJECTDIR}/_ext/1472/panelNv.p1.d ${OBJECTDIR}/_ext/1472/buttonscan.p1.d ${OBJECTDIR}/_ext/1472/max6951.p1.d ${OBJECTDIR}/_ext/1472/fastClock.p1.d ${OBJECTDIR}/_ext/1472/startup.p1.d ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d ${OBJECTDIR}/_ext/1472/scheduler.p1.d ${OBJECTDIR}/_ext/1472/portArbiter.p1.d ${OBJECTDIR}/_ext/1472/profile.p1.d ${OBJECTDIR}/_ext/1472/panelDiag.p1.d ${OBJECTDIR}/_ext/1472/latency.p1.d ${OBJECTDIR}/_ext/1472/busMonitor.p1.d ${OBJECTDIR}/_ext/1472/opCost.p1.d ${OBJECTDIR}/_ext/1472/trace.p1.d ${OBJECTDIR}/_ext/1472/ledTimer.p1.d ${OBJECTDIR}/_ext/1954642981/boot.p1.d ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1.d ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1.d ${OBJECTDIR}/_ext/1954642981/event_coe.p1.d ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1.d ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1.d ${OBJECTDIR}/_ext/1954642981/messageQueue.p1.d ${OBJECTDIR}/_ext/1954642981/mns.p1.d ${OBJECTDIR}/_ext/1954642981/nv.p1.d ${OBJECTDIR}/_ext/1954642981/nvm.p1.d ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1.d ${OBJECTDIR}/_ext/1954642981/ticktime.p1.d ${OBJECTDIR}/_ext/1954642981/timedResponse.p1.d ${OBJECTDIR}/_ext/1954642981/vlcb.p1.d ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1472/main.p1 ${OBJECTDIR}/_ext/1472/panelEvents.p1 ${OBJECTDIR}/_ext/1472/panelNv.p1 ${OBJECTDIR}/_ext/1472/buttonscan.p1 ${OBJECTDIR}/_ext/1472/max6951.p1 ${OBJECTDIR}/_ext/1954642981/boot.p1 ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1 ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1 ${OBJECTDIR}/_ext/1954642981/event_coe.p1 ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1 ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1 ${OBJECTDIR}/_ext/1954642981/messageQueue.p1 ${OBJECTDIR}/_ext/1954642981/mns.p1 ${OBJECTDIR}/_ext/1954642981/nv.p1 ${OBJECTDIR}/_ext/1954642981/nvm.p1 ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1 ${OBJECTDIR}/_ext/1954642981/ticktime.p1 ${OBJECTDIR}/_ext/1954642981/timedResponse.p1 ${OBJECTDIR}/_ext/1954642981/vlcb.p1 ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1
+OBJECTFILES=${OBJECTDIR}/_ext/1472/main.p1 ${OBJECTDIR}/_ext/1472/panelEvents.p1 ${OBJECTDIR}/_ext/1472/panelNv.p1 ${OBJECTDIR}/_ext/1472/buttonscan.p1 ${OBJECTDIR}/_ext/1472/max6951.p1 ${OBJECTDIR}/_ext/1472/fastClock.p1 ${OBJECTDIR}/_ext/1472/startup.p1 ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 ${OBJECTDIR}/_ext/1472/flashSchedule.p1 ${OBJECTDIR}/_ext/1472/scheduler.p1 ${OBJECTDIR}/_ext/1472/portArbiter.p1 ${OBJECTDIR}/_ext/1472/profile.p1 ${OBJECTDIR}/_ext/1472/panelDiag.p1 ${OBJECTDIR}/_ext/1472/latency.p1 ${OBJECTDIR}/_ext/1472/busMonitor.p1 ${OBJECTDIR}/_ext/1472/opCost.p1 ${OBJECTDIR}/_ext/1472/trace.p1 ${OBJECTDIR}/_ext/1472/ledTimer.p1 ${OBJECTDIR}/_ext/1954642981/boot.p1 ${OBJECTDIR}/_ext/1954642981/can18_can_2.p1 ${OBJECTDIR}/_ext/1954642981/event_acknowledge.p1 ${OBJECTDIR}/_ext/1954642981/event_coe.p1 ${OBJECTDIR}/_ext/1954642981/event_producer_happening.p1 ${OBJECTDIR}/_ext/1954642981/event_teach_large.p1 ${OBJECTDIR}/_ext/1954642981/messageQueue.p1 ${OBJECTDIR}/_ext/1954642981/mns.p1 ${OBJECTDIR}/_ext/1954642981/nv.p1 ${OBJECTDIR}/_ext/1954642981/nvm.p1 ${OBJECTDIR}/_ext/1954642981/statusLeds2.p1 ${OBJECTDIR}/_ext/1954642981/ticktime.p1 ${OBJECTDIR}/_ext/1954642981/timedResponse.p1 ${OBJECTDIR}/_ext/1954642981/vlcb.p1 ${OBJECTDIR}/_ext/1954642981/event_consumer_simple.p1
 
 # Source Files
-SOURCEFILES=../main.c ../panelEvents.c ../panelNv.c ../buttonscan.c ../max6951.c ../../VLCBlib_PIC/boot.c ../../VLCBlib_PIC/can18_can_2.c ../../VLCBlib_PIC/event_acknowledge.c ../../VLCBlib_PIC/event_coe.c ../../VLCBlib_PIC/event_producer_happening.c ../../VLCBlib_PIC/event_teach_large.c ../../VLCBlib_PIC/messageQueue.c ../../VLCBlib_PIC/mns.c ../../VLCBlib_PIC/nv.c ../../VLCBlib_PIC/nvm.c ../../VLCBlib_PIC/statusLeds2.c ../../VLCBlib_PIC/ticktime.c ../../VLCBlib_PIC/timedResponse.c ../../VLCBlib_PIC/vlcb.c ../../VLCBlib_PIC/event_consumer_simple.c
+SOURCEFILES=../main.c ../panelEvents.c ../panelNv.c ../buttonscan.c ../max6951.c ../fastClock.c ../startup.c ../ledSnapshot.c ../flashSchedule.c ../scheduler.c ../portArbiter.c ../profile.c ../panelDiag.c ../latency.c ../busMonitor.c ../opCost.c ../trace.c ../ledTimer.c ../../VLCBlib_PIC/boot.c ../../VLCBlib_PIC/can18_can_2.c ../../VLCBlib_PIC/event_acknowledge.c ../../VLCBlib_PIC/event_coe.c ../../VLCBlib_PIC/event_producer_happening.c ../../VLCBlib_PIC/event_teach_large.c ../../VLCBlib_PIC/messageQueue.c ../../VLCBlib_PIC/mns.c ../../VLCBlib_PIC/nv.c ../../VLCBlib_PIC/nvm.c ../../VLCBlib_PIC/statusLeds2.c ../../VLCBlib_PIC/ticktime.c ../../VLCBlib_PIC/timedResponse.c ../../VLCBlib_PIC/vlcb.c ../../VLCBlib_PIC/event_consumer_simple.c
 
 
 
@@ -128,6 +128,110 @@ ${OBJECTDIR}/_ext/1472/max6951.p1: ../max6951.c  nbproject/Makefile-${CND_CONF}.
 	@-${MV} ${OBJECTDIR}/_ext/1472/max6951.d ${OBJECTDIR}/_ext/1472/max6951.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/max6951.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1472/fastClock.p1: ../fastClock.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/fastClock.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/fastClock.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/fastClock.p1 ../fastClock.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/fastClock.d ${OBJECTDIR}/_ext/1472/fastClock.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/fastClock.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/startup.p1: ../startup.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/startup.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/startup.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/startup.p1 ../startup.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/startup.d ${OBJECTDIR}/_ext/1472/startup.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/startup.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/ledSnapshot.p1: ../ledSnapshot.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 ../ledSnapshot.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/ledSnapshot.d ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/flashSchedule.p1: ../flashSchedule.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/flashSchedule.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/flashSchedule.p1 ../flashSchedule.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/flashSchedule.d ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/scheduler.p1: ../scheduler.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/scheduler.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/scheduler.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/scheduler.p1 ../scheduler.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/scheduler.d ${OBJECTDIR}/_ext/1472/scheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/scheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/portArbiter.p1: ../portArbiter.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/portArbiter.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/portArbiter.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/portArbiter.p1 ../portArbiter.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/portArbiter.d ${OBJECTDIR}/_ext/1472/portArbiter.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/portArbiter.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/profile.p1: ../profile.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/profile.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/profile.p1 ../profile.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/profile.d ${OBJECTDIR}/_ext/1472/profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/panelDiag.p1: ../panelDiag.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/panelDiag.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/panelDiag.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/panelDiag.p1 ../panelDiag.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/panelDiag.d ${OBJECTDIR}/_ext/1472/panelDiag.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/panelDiag.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/latency.p1: ../latency.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/latency.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/latency.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/latency.p1 ../latency.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/latency.d ${OBJECTDIR}/_ext/1472/latency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/latency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/busMonitor.p1: ../busMonitor.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/busMonitor.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/busMonitor.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/busMonitor.p1 ../busMonitor.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/busMonitor.d ${OBJECTDIR}/_ext/1472/busMonitor.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/busMonitor.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/opCost.p1: ../opCost.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/opCost.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/opCost.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/opCost.p1 ../opCost.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/opCost.d ${OBJECTDIR}/_ext/1472/opCost.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/opCost.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/trace.p1: ../trace.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/trace.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/trace.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/trace.p1 ../trace.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/trace.d ${OBJECTDIR}/_ext/1472/trace.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/trace.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/ledTimer.p1: ../ledTimer.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledTimer.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledTimer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/ledTimer.p1 ../ledTimer.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/ledTimer.d ${OBJECTDIR}/_ext/1472/ledTimer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/ledTimer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1954642981/boot.p1: ../../VLCBlib_PIC/boot.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1954642981" 
 	@${RM} ${OBJECTDIR}/_ext/1954642981/boot.p1.d 
@@ -289,6 +393,110 @@ ${OBJECTDIR}/_ext/1472/max6951.p1: ../max6951.c  nbproject/Makefile-${CND_CONF}.
 	@-${MV} ${OBJECTDIR}/_ext/1472/max6951.d ${OBJECTDIR}/_ext/1472/max6951.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/max6951.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1472/fastClock.p1: ../fastClock.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/fastClock.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/fastClock.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/fastClock.p1 ../fastClock.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/fastClock.d ${OBJECTDIR}/_ext/1472/fastClock.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/fastClock.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/startup.p1: ../startup.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/startup.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/startup.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/startup.p1 ../startup.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/startup.d ${OBJECTDIR}/_ext/1472/startup.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/startup.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/ledSnapshot.p1: ../ledSnapshot.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/ledSnapshot.p1 ../ledSnapshot.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/ledSnapshot.d ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/ledSnapshot.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/flashSchedule.p1: ../flashSchedule.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/flashSchedule.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/flashSchedule.p1 ../flashSchedule.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/flashSchedule.d ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/flashSchedule.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/scheduler.p1: ../scheduler.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/scheduler.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/scheduler.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/scheduler.p1 ../scheduler.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/scheduler.d ${OBJECTDIR}/_ext/1472/scheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/scheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/portArbiter.p1: ../portArbiter.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/portArbiter.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/portArbiter.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/portArbiter.p1 ../portArbiter.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/portArbiter.d ${OBJECTDIR}/_ext/1472/portArbiter.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/portArbiter.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/profile.p1: ../profile.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/profile.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/profile.p1 ../profile.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/profile.d ${OBJECTDIR}/_ext/1472/profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/panelDiag.p1: ../panelDiag.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/panelDiag.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/panelDiag.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/panelDiag.p1 ../panelDiag.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/panelDiag.d ${OBJECTDIR}/_ext/1472/panelDiag.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/panelDiag.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/latency.p1: ../latency.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/latency.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/latency.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/latency.p1 ../latency.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/latency.d ${OBJECTDIR}/_ext/1472/latency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/latency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/busMonitor.p1: ../busMonitor.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/busMonitor.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/busMonitor.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/busMonitor.p1 ../busMonitor.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/busMonitor.d ${OBJECTDIR}/_ext/1472/busMonitor.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/busMonitor.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/opCost.p1: ../opCost.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/opCost.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/opCost.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/opCost.p1 ../opCost.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/opCost.d ${OBJECTDIR}/_ext/1472/opCost.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/opCost.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/trace.p1: ../trace.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/trace.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/trace.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/trace.p1 ../trace.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/trace.d ${OBJECTDIR}/_ext/1472/trace.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/trace.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1472/ledTimer.p1: ../ledTimer.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledTimer.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/ledTimer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fno-short-double -fno-short-float -memi=wordwrite -mrom=800-1EFFF -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -I"../../VLCB-defs" -I"../" -I"../../VLCBlib_PIC" -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1472/ledTimer.p1 ../ledTimer.c 
+	@-${MV} ${OBJECTDIR}/_ext/1472/ledTimer.d ${OBJECTDIR}/_ext/1472/ledTimer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1472/ledTimer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1954642981/boot.p1: ../../VLCBlib_PIC/boot.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1954642981" 
 	@${RM} ${OBJECTDIR}/_ext/1954642981/boot.p1.d 
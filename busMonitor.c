@@ -0,0 +1,370 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * CAN bus traffic monitor.
+ *
+ * Every received message is counted by class as it is processed. The counts
+ * are kept in BUS_SLOTS slots of BUS_SLOT_TIME so that the total over the
+ * last second can be kept up to date cheaply. Frames sent by the panel, 
+ * dropped frames and lost arbitrations are taken from the CAN service's 
+ * counters.
+ *
+ * The utilisation is the percentage of CAN_FRAMES_PER_SECOND used by the
+ * frames seen over the last second. The queueing delay is estimated from the
+ * number of frames waiting in the TX buffers. High water marks are kept for
+ * each class, the utilisation and the queueing delay. The values can be read
+ * using RDGN, see panelDiag.c.
+ *
+ * The gap between timed responses is also set here. It is scaled between 
+ * NV_RESPONSE_DELAY_MIN and NV_RESPONSE_DELAY by whichever is the higher of
+ * the TX buffer occupancy and the bus utilisation, so SOD and NV reads go 
+ * quickly on a quiet bus and back off on a busy one. It is also stretched
+ * whilst a button being debounced is about to send an event so the button's 
+ * event goes first.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include <stddef.h>
+#include "vlcb.h"
+#include "module.h"
+#include "can.h"
+#include "ticktime.h"
+#include "timedResponse.h"
+#include "busMonitor.h"
+#include "buttonscan.h"
+
+uint16_t busHighWater[NUM_BUS_CLASSES];
+uint8_t busUtilisationHighWater;
+uint8_t busQueueDelayHighWater;
+
+/*
+ * The CAN service diagnostics counted for BUS_CLASS_TX onwards.
+ */
+static const uint8_t canCounterDiagnostic[NUM_BUS_CLASSES - BUS_CLASS_TX] = {
+    CAN_DIAG_TX_MESSAGES,
+    CAN_DIAG_TX_BUFFER_OVERRUN,
+    CAN_DIAG_RX_BUFFER_OVERRUN,
+    CAN_DIAG_LOST_ARBITRATION
+};
+
+static uint8_t slotCount[BUS_SLOTS][NUM_BUS_CLASSES];
+static uint8_t currentCount[NUM_BUS_CLASSES];   // counts for the slot being filled
+static uint16_t windowCount[NUM_BUS_CLASSES];   // sum of slotCount
+static uint8_t oldestSlot;
+static uint8_t lastSlotTotal;                   // received frames in the last complete slot
+static TickValue slotStart;
+static uint16_t lastCanCount[NUM_BUS_CLASSES - BUS_CLASS_TX];
+static uint8_t queueDelay;
+static uint8_t responseDelayMin;
+static uint8_t responseDelayMax;
+static uint8_t responseDelay;                   // the delay last given to the library
+
+/**
+ * Get one of the CAN service's counters.
+ * @param diagnostic the CAN_DIAG_ code
+ * @return the count, which wraps
+ */
+static uint16_t canCounter(uint8_t diagnostic) {
+    DiagnosticVal * d;
+    
+    d = canService.getDiagnostic(diagnostic);
+    if (d == NULL) {
+        return 0;
+    }
+    return (uint16_t)d->asUint;
+}
+
+/**
+ * Start monitoring. Called once at power up.
+ */
+void busMonitorInit(void) {
+    uint8_t slot;
+    uint8_t cls;
+    
+    for (slot = 0; slot < BUS_SLOTS; slot++) {
+        for (cls = 0; cls < NUM_BUS_CLASSES; cls++) {
+            slotCount[slot][cls] = 0;
+        }
+    }
+    for (cls = 0; cls < NUM_BUS_CLASSES; cls++) {
+        currentCount[cls] = 0;
+        windowCount[cls] = 0;
+    }
+    oldestSlot = 0;
+    lastSlotTotal = 0;
+    slotStart.val = tickGet();
+    for (cls = BUS_CLASS_TX; cls < NUM_BUS_CLASSES; cls++) {
+        lastCanCount[cls - BUS_CLASS_TX] = canCounter(canCounterDiagnostic[cls - BUS_CLASS_TX]);
+    }
+    queueDelay = 0;
+    busMonitorReset();
+}
+
+/**
+ * Clear the high water marks.
+ */
+void busMonitorReset(void) {
+    uint8_t cls;
+    
+    for (cls = 0; cls < NUM_BUS_CLASSES; cls++) {
+        busHighWater[cls] = 0;
+    }
+    busUtilisationHighWater = 0;
+    busQueueDelayHighWater = 0;
+}
+
+/**
+ * Count a received message. Called for every message the library processes.
+ * @param m the message
+ */
+void busMonitorMessage(Message * m) {
+    uint8_t cls;
+    
+    switch (m->opc) {
+        case OPC_ACON:
+        case OPC_ACOF:
+        case OPC_ASON:
+        case OPC_ASOF:
+        case OPC_ACON1:
+        case OPC_ACOF1:
+        case OPC_ASON1:
+        case OPC_ASOF1:
+        case OPC_ACON2:
+        case OPC_ACOF2:
+        case OPC_ASON2:
+        case OPC_ASOF2:
+        case OPC_ACON3:
+        case OPC_ACOF3:
+        case OPC_ASON3:
+        case OPC_ASOF3:
+            cls = BUS_CLASS_EVENT;
+            break;
+        case OPC_AREQ:
+        case OPC_ASRQ:
+        case OPC_ARON:
+        case OPC_AROF:
+        case OPC_ARSON:
+        case OPC_ARSOF:
+        case OPC_ARON1:
+        case OPC_AROF1:
+        case OPC_ARSON1:
+        case OPC_ARSOF1:
+        case OPC_ARON2:
+        case OPC_AROF2:
+        case OPC_ARSON2:
+        case OPC_ARSOF2:
+        case OPC_ARON3:
+        case OPC_AROF3:
+        case OPC_ARSON3:
+        case OPC_ARSOF3:
+            cls = BUS_CLASS_RESPONSE;
+            break;
+        default:
+            cls = BUS_CLASS_CONFIG;
+            break;
+    }
+    if (currentCount[cls] < 0xFF) {
+        currentCount[cls]++;
+    }
+}
+
+/**
+ * Set the gap between timed responses from the current TX buffer occupancy 
+ * and bus utilisation.
+ */
+static void updateResponseDelay(void) {
+    uint8_t load;
+    uint8_t occupancy;
+    uint8_t delay;
+    
+    if (responseDelayMin >= responseDelayMax) {
+        return;     // fixed delay
+    }
+    occupancy = (uint8_t)(((uint16_t)(TX_FIFO_DEPTH - txBuffersFree()) * 100) / TX_FIFO_DEPTH);
+    load = busUtilisation();
+    if (occupancy > load) {
+        load = occupancy;
+    }
+    if (keyEventPending()) {
+        load = 100;     // a button event is on its way, let it go first
+    }
+    delay = responseDelayMin + (uint8_t)(((uint16_t)(responseDelayMax - responseDelayMin) * load) / 100);
+    if (delay != responseDelay) {
+        responseDelay = delay;
+        setTimedResponseDelay(delay);
+    }
+}
+
+/**
+ * Set the range of the gap between timed responses. If min is not less than
+ * max then max is always used.
+ * @param min the gap when the bus is quiet (ms)
+ * @param max the gap when the bus is busy (ms)
+ */
+void setResponseDelayBounds(uint8_t min, uint8_t max) {
+    responseDelayMin = min;
+    responseDelayMax = max;
+    responseDelay = max;    // start cautious, updateResponseDelay() will bring it down
+    setTimedResponseDelay(max);
+}
+
+/**
+ * Move on to the next slot, dropping the oldest from the window.
+ */
+static void nextSlot(void) {
+    uint8_t cls;
+    uint16_t total;
+    
+    total = 0;
+    for (cls = 0; cls < NUM_BUS_CLASSES; cls++) {
+        windowCount[cls] -= slotCount[oldestSlot][cls];
+        slotCount[oldestSlot][cls] = currentCount[cls];
+        windowCount[cls] += currentCount[cls];
+        if (cls < BUS_CLASS_TX) {
+            total += currentCount[cls];
+        }
+        currentCount[cls] = 0;
+        if (windowCount[cls] > busHighWater[cls]) {
+            busHighWater[cls] = windowCount[cls];
+        }
+    }
+    lastSlotTotal = (total > 0xFF) ? 0xFF : (uint8_t)total;
+    if (++oldestSlot >= BUS_SLOTS) {
+        oldestSlot = 0;
+    }
+}
+
+/**
+ * Close the current slot once its time is up. Should be called at least 
+ * every BUS_SLOT_TIME.
+ */
+void busMonitorPoll(void) {
+    uint8_t cls;
+    uint16_t count;
+    uint16_t delta;
+    uint8_t slots;
+    uint8_t utilisation;
+    
+    updateResponseDelay();
+    
+    // a frame joining the back of the TX queue waits for those in front of it
+    count = (uint16_t)(TX_FIFO_DEPTH - txBuffersFree()) * 1000;
+    queueDelay = (uint8_t)((count + CAN_FRAMES_PER_SECOND - 1) / CAN_FRAMES_PER_SECOND);
+    if (queueDelay > busQueueDelayHighWater) {
+        busQueueDelayHighWater = queueDelay;
+    }
+    
+    if (tickTimeSince(slotStart) < (uint32_t)BUS_SLOT_TIME * ONE_MILI_SECOND) {
+        return;
+    }
+    for (cls = BUS_CLASS_TX; cls < NUM_BUS_CLASSES; cls++) {
+        count = canCounter(canCounterDiagnostic[cls - BUS_CLASS_TX]);
+        delta = count - lastCanCount[cls - BUS_CLASS_TX];
+        lastCanCount[cls - BUS_CLASS_TX] = count;
+        currentCount[cls] = (delta > 0xFF) ? 0xFF : (uint8_t)delta;
+    }
+    
+    // catch up if we weren't called for a while, the missed slots are empty
+    slots = 0;
+    do {
+        nextSlot();
+        slotStart.val += (uint32_t)BUS_SLOT_TIME * ONE_MILI_SECOND;
+    } while ((++slots < BUS_SLOTS) && 
+            (tickTimeSince(slotStart) >= (uint32_t)BUS_SLOT_TIME * ONE_MILI_SECOND));
+    if (slots >= BUS_SLOTS) {
+        slotStart.val = tickGet();
+    }
+    
+    utilisation = busUtilisation();
+    if (utilisation > busUtilisationHighWater) {
+        busUtilisationHighWater = utilisation;
+    }
+}
+
+/**
+ * @param cls the BUS_CLASS_
+ * @return the number of frames of the class in the last second
+ */
+uint16_t busFrames(uint8_t cls) {
+    return windowCount[cls];
+}
+
+/**
+ * Estimate how long a frame queued now would wait before being sent, from 
+ * the number of frames already in the TX buffers.
+ * @return the delay in ms
+ */
+uint8_t busQueueDelay(void) {
+    return queueDelay;
+}
+
+/**
+ * @return the number of frames received in the last BUS_SLOT_TIME
+ */
+uint8_t busLastSlotFrames(void) {
+    return lastSlotTotal;
+}
+
+/**
+ * Estimate how busy the bus is.
+ * @return the percentage of the bus capacity used over the last second
+ */
+uint8_t busUtilisation(void) {
+    uint16_t frames;
+    
+    frames = windowCount[BUS_CLASS_EVENT] + windowCount[BUS_CLASS_RESPONSE] + 
+            windowCount[BUS_CLASS_CONFIG] + windowCount[BUS_CLASS_TX];
+    if (frames >= CAN_FRAMES_PER_SECOND) {
+        return 100;
+    }
+    return (uint8_t)(((uint32_t)frames * 100) / CAN_FRAMES_PER_SECOND);
+}
+
+/**
+ * Get the number of messages which can be put into the CAN transmit buffers
+ * without them overflowing.
+ * @return the number of free TX buffers
+ */
+uint8_t txBuffersFree(void) {
+    DiagnosticVal * d;
+    
+    d = canService.getDiagnostic(CAN_DIAG_TX_BUFFER_USAGE);
+    if (d == NULL) {
+        return 1;
+    }
+    if (d->asInt >= TX_FIFO_DEPTH) {
+        return 0;
+    }
+    return (uint8_t)(TX_FIFO_DEPTH - d->asInt);
+}
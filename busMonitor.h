@@ -0,0 +1,75 @@
+#ifndef _BUSMONITOR_H_
+#define _BUSMONITOR_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Monitor of the CAN bus traffic, so the panel can tell how busy the bus is.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+
+// Length of each slot of the sliding window (ms)
+#define BUS_SLOT_TIME       100
+// Number of slots in the sliding window, a window of 1 second
+#define BUS_SLOTS           10
+
+// Traffic classes
+#define BUS_CLASS_EVENT     0   // received accessory events
+#define BUS_CLASS_RESPONSE  1   // received accessory state responses and requests
+#define BUS_CLASS_CONFIG    2   // everything else received, mostly configuration
+#define BUS_CLASS_TX        3   // frames sent by this panel
+#define BUS_CLASS_TX_DROPPED 4  // frames this panel couldn't queue for sending
+#define BUS_CLASS_RX_DROPPED 5  // frames lost because the RX buffers were full
+#define BUS_CLASS_LOST_ARB  6   // times this panel lost arbitration
+#define NUM_BUS_CLASSES     7
+#define NUM_BUS_TRAFFIC_CLASSES 4   // the classes which are frames on the bus
+
+extern uint16_t busHighWater[NUM_BUS_CLASSES];
+extern uint8_t busUtilisationHighWater;
+extern uint8_t busQueueDelayHighWater;
+
+void busMonitorInit(void);
+void busMonitorReset(void);
+void busMonitorMessage(Message * m);
+void busMonitorPoll(void);
+uint16_t busFrames(uint8_t cls);
+uint8_t busLastSlotFrames(void);
+uint8_t busUtilisation(void);
+uint8_t busQueueDelay(void);
+uint8_t txBuffersFree(void);
+void setResponseDelayBounds(uint8_t min, uint8_t max);
+
+#endif
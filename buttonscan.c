@@ -51,6 +51,10 @@
 #include "panelEvents.h"
 #include "nv.h"
 #include "event_producer.h"
+#include "profile.h"
+#include "latency.h"
+#include "trace.h"
+#include "ledSnapshot.h"
 
 typedef union {
     uint8_t val;   
@@ -77,23 +81,151 @@ typedef union {
 ByteBits keyInputState[COLUMN_OUTPUTS];  // after debounce
 ByteBits keyOutputState[COLUMN_OUTPUTS]; // after toggle
 ByteNibbles debounceCounters[COLUMN_OUTPUTS*ROW_INPUTS/2];  // 4 bits per counter
+static uint8_t debouncing[COLUMN_OUTPUTS];  // rows with a non zero debounce counter
+static TickValue lastScanTime;
+
+#ifdef KEYSCAN_ISR
+/*
+ * Samples from the timer interrupt. Single producer (the ISR) single consumer
+ * (keyScan()) so each index is only written by one side and no locking is
+ * needed. keyScan() drains the buffer every KEY_SCAN_INTERVAL, in which the
+ * ISR reads every column once. The buffer holds one less than its size so it 
+ * is sized to keep at least two full scans in case the main loop is late.
+ */
+#if COLUMN_OUTPUTS < 8
+#define SAMPLE_BUFFER_SIZE  16      // must be a power of 2
+#elif COLUMN_OUTPUTS < 16
+#define SAMPLE_BUFFER_SIZE  32
+#elif COLUMN_OUTPUTS < 32
+#define SAMPLE_BUFFER_SIZE  64
+#elif COLUMN_OUTPUTS < 64
+#define SAMPLE_BUFFER_SIZE  128
+#else
+#error "Too many columns for the key scan sample buffer"
+#endif
+static uint8_t sampleColumn[SAMPLE_BUFFER_SIZE];
+static uint8_t sampleRows[SAMPLE_BUFFER_SIZE];
+static volatile uint8_t sampleHead;     // written only by the ISR
+static volatile uint8_t sampleTail;     // written only by keyScan()
+static uint8_t isrColumn;               // next column for the ISR to read
+volatile uint16_t keyScanOverruns;
+#endif
 #define PB(c,r) ((c)*ROW_INPUTS + (r))
 #define COUNTER_INDEX(c,r)   (PB(c,r)/2)
 
+/*
+ * The PB flags NVs for each column as bit masks, one bit per row, so the scan
+ * doesn't need to read the NVs. Rebuilt by buildPbMasks() when a PB flags NV
+ * changes.
+ */
+static uint8_t toggleMask[COLUMN_OUTPUTS];
+static uint8_t polarityMask[COLUMN_OUTPUTS];
+static uint8_t sendOnMask[COLUMN_OUTPUTS];
+static uint8_t sendOffMask[COLUMN_OUTPUTS];
+
 #define DEBOUNCE_DELAY  4   // 40ms
 
+/*
+ * Row gather tables. Each table maps one nibble of PORTA or PORTB to the row
+ * bits it carries, so a column is read from a single snapshot of each port. 
+ * The tables are generated from the KBD_INPn_PORT and KBD_INPn_BIT 
+ * definitions in matrix.h.
+ */
+#define ROW_TERM(r, port, shift, n) \
+    ((KBD_PORT_ID(KBD_INP##r##_PORT) == (port)) ? (((((n) << (shift)) >> KBD_INP##r##_BIT) & 1) << (r)) : 0)
+#if ROW_INPUTS >3
+#define NIBBLE_ROWS(port, shift, n)  (uint8_t)(ROW_TERM(0, port, shift, n) | \
+    ROW_TERM(1, port, shift, n) | ROW_TERM(2, port, shift, n) | ROW_TERM(3, port, shift, n) | \
+    ROW_TERM(4, port, shift, n) | ROW_TERM(5, port, shift, n) | ROW_TERM(6, port, shift, n) | \
+    ROW_TERM(7, port, shift, n))
+#else
+#define NIBBLE_ROWS(port, shift, n)  (uint8_t)(ROW_TERM(0, port, shift, n) | \
+    ROW_TERM(1, port, shift, n) | ROW_TERM(2, port, shift, n) | ROW_TERM(3, port, shift, n))
+#endif
+#define NIBBLE_TABLE(port, shift)   { \
+    NIBBLE_ROWS(port, shift, 0),  NIBBLE_ROWS(port, shift, 1),  NIBBLE_ROWS(port, shift, 2),  NIBBLE_ROWS(port, shift, 3), \
+    NIBBLE_ROWS(port, shift, 4),  NIBBLE_ROWS(port, shift, 5),  NIBBLE_ROWS(port, shift, 6),  NIBBLE_ROWS(port, shift, 7), \
+    NIBBLE_ROWS(port, shift, 8),  NIBBLE_ROWS(port, shift, 9),  NIBBLE_ROWS(port, shift, 10), NIBBLE_ROWS(port, shift, 11), \
+    NIBBLE_ROWS(port, shift, 12), NIBBLE_ROWS(port, shift, 13), NIBBLE_ROWS(port, shift, 14), NIBBLE_ROWS(port, shift, 15)}
+
+static const uint8_t rowsFromPortA[2][16] = {
+    NIBBLE_TABLE(KBD_PORT_A, 0), 
+    NIBBLE_TABLE(KBD_PORT_A, 4)
+};
+static const uint8_t rowsFromPortB[2][16] = {
+    NIBBLE_TABLE(KBD_PORT_B, 0), 
+    NIBBLE_TABLE(KBD_PORT_B, 4)
+};
+
+/*
+ * Read the row inputs for the currently strobed column. A macro so the ISR 
+ * doesn't have to call out.
+ */
+#define READ_ROWS(rows)     { \
+    uint8_t portA = PORTA; \
+    uint8_t portB = PORTB; \
+    rows = rowsFromPortA[0][portA & 0x0F] | rowsFromPortA[1][portA >> 4] | \
+           rowsFromPortB[0][portB & 0x0F] | rowsFromPortB[1][portB >> 4]; \
+}
+
+/*
+ * Strobe a column active low. The native columns are bits of COL_LAT, the
+ * extra columns are outputs of the shift register chain. These are macros so
+ * the ISR doesn't have to call out.
+ */
+#define NATIVE_STROBE(col)  {COL_LAT |= COLUMN_MASK; COL_LAT &= (uint8_t)~((0b00000001 << (col)) & COLUMN_MASK);}
+#if EXTRA_COLUMNS > 0
+#define NO_EXTRA_COLUMN     0xFF
+/*
+ * Reload the whole shift register chain with just the given column active, 
+ * or none with NO_EXTRA_COLUMN, and latch it to the outputs. The whole chain 
+ * is reloaded each time as the SPI traffic to the MAX chips also clocks it. 
+ * The last column is shifted first. All the native strobes are left inactive.
+ */
+#define EXT_LOAD(col)   { \
+    uint8_t extCol; \
+    COL_LAT |= COLUMN_MASK; \
+    for (extCol = COLUMN_OUTPUTS; extCol > NATIVE_COLUMNS; ) { \
+        extCol--; \
+        EXT_DATA = (extCol != (col)); \
+        EXT_CLOCK = 0; \
+        EXT_CLOCK = 1; \
+    } \
+    EXT_LATCH = 1; \
+    EXT_LATCH = 0; \
+    COL_LAT |= COLUMN_MASK; \
+}
+#define STROBE_COLUMN(col)  if ((col) < NATIVE_COLUMNS) NATIVE_STROBE(col) else EXT_LOAD(col)
+#else
+#define STROBE_COLUMN(col)  NATIVE_STROBE(col)
+#endif
+
 // forward declarations
-void sendPBEvent(uint8_t pb, uint8_t state, uint8_t flags);
+void sendPBEvent(uint8_t pb, uint8_t state, uint8_t col, uint8_t mask);
+static uint8_t readRows(void);
+static void debounceColumn(uint8_t col, uint8_t rows);
 
 /**
  * Initialise the button scanning.
  */
 void initKeyscan(void) {
     uint8_t col;
-    uint8_t        strobeMask;
     
     // Keypad strobe  output pins - intialise all high
     COL_LAT |= COLUMN_MASK;  
+    KBD_STROBE0_TRIS = 0;
+    KBD_STROBE1_TRIS = 0;
+    KBD_STROBE2_TRIS = 0;
+    KBD_STROBE3_TRIS = 0;
+    KBD_STROBE4_TRIS = 0;
+    KBD_STROBE5_TRIS = 0;
+    KBD_STROBE6_TRIS = 0;
+    KBD_STROBE7_TRIS = 0;
+#if EXTRA_COLUMNS > 0
+    EXT_LATCH = 0;
+    EXT_LATCH_TRIS = 0;
+    EXT_LOAD(NO_EXTRA_COLUMN);      // the shift registers power up with random outputs
+#endif
                     
     // Keypad strobe  input pins
     KBD_INP0_TRIS = 1;
@@ -109,35 +241,66 @@ void initKeyscan(void) {
     
     // now initialise the matrix data with current matrix state
     for ( col = 0; col < COLUMN_OUTPUTS; col++) {
-        strobeMask = ~((0b00000001 << col) & COLUMN_MASK);    // Shifting column from bit 0
-        COL_LAT |= COLUMN_MASK;                                 // Set all strobe column bits
-        COL_LAT &= strobeMask;                                  // Clear strobe bit to active low for this column
+        buildPbMasks(col);
+        STROBE_COLUMN(col);                                     // Clear strobe bit to active low for this column
 
         // Read in the value strobed by the outputs
-        keyInputState[col].val = 0;
-        keyInputState[col].bits.b0 = KBD_INP0;
-        keyInputState[col].bits.b1 = KBD_INP1;
-        keyInputState[col].bits.b2 = KBD_INP2;
-        keyInputState[col].bits.b3 = KBD_INP3;
-        keyInputState[col].bits.b4 = KBD_INP4;
-        keyInputState[col].bits.b5 = KBD_INP5;
-        keyInputState[col].bits.b6 = KBD_INP6;
-        keyInputState[col].bits.b7 = KBD_INP7;
+        keyInputState[col].val = readRows();
         
-        keyOutputState[col].val = keyInputState[col].val;
+        // buttons are active low, polarity inverts the output
+        keyOutputState[col].val = keyInputState[col].val ^ (uint8_t)~polarityMask[col];
         
     }  // for each column strobe group
+#if EXTRA_COLUMNS > 0
+    EXT_LOAD(NO_EXTRA_COLUMN);
+#endif
     
     // zero the debounce counters
     for (col = 0; col < COLUMN_OUTPUTS*ROW_INPUTS/2; col++) {
         debounceCounters[col].val = 0;
     }
+    for (col = 0; col < COLUMN_OUTPUTS; col++) {
+        debouncing[col] = 0;
+    }
+}
+
+/**
+ * Rebuild the cached copy of the PB flags NVs for a column.
+ * @param col the column
+ */
+void buildPbMasks(uint8_t col) {
+    uint8_t row;
+    uint8_t flags;
+    uint8_t mask;
+    
+    toggleMask[col] = 0;
+    polarityMask[col] = 0;
+    sendOnMask[col] = 0;
+    sendOffMask[col] = 0;
+    for (row = 0, mask = 1; row < ROW_INPUTS; row++, mask <<= 1) {
+        flags = (uint8_t)getNV(NV_PB_FLAGS + PB(col, row));
+        if (flags & NV_PB_FLAGS_TOGGLE) toggleMask[col] |= mask;
+        if (flags & NV_PB_FLAGS_POLARITY) polarityMask[col] |= mask;
+        if (flags & NV_PB_FLAGS_SEND_ON) sendOnMask[col] |= mask;
+        if (flags & NV_PB_FLAGS_SEND_OFF) sendOffMask[col] |= mask;
+    }
 }
 
 /**
- * This routine does one scan of the keypad, updating any debounce counts. It returns the value
- * of the currently pressed key, when the press has been debounced.
- * IF no valid key (or combination) is  pressed, or there has been no change, then 0xFF is returned.
+ * Read the row inputs for the currently strobed column.
+ * @return one bit per row
+ */
+static uint8_t readRows(void) {
+    uint8_t rows;
+    
+    READ_ROWS(rows);
+    return rows;
+}
+
+/**
+ * This routine does one scan of the keypad, updating any debounce counts. 
+ * When a change has been stable for DEBOUNCE_DELAY scans the output state is
+ * updated and the PB's event is sent.
  *
  * NOTE: this code is optimised by using specific binary patterns for the bit masks.
  * These are defined in matrix.h which is application hardware specific.
@@ -149,72 +312,182 @@ void initKeyscan(void) {
  * The SPI routines must leave all SPI device CS signals disabled and the SPI module disabled to enable normal I/O operation
  * Interrupts are disabled during the strobe out and read in sequence in case LCD or SPI operations happen in the ISR
  *
- * This routine does NOT block during the debounce, and should be called repeatedly from the main loop,
- * It will return the new keycode when the debounce period has completed.
+ * This routine does NOT block during the debounce, and should be called repeatedly from the main loop.
+ * With KEYSCAN_ISR the columns are read by the timer interrupt and this 
+ * processes the samples it has collected.
  */
 void keyScan( void ) {
+#ifdef KEYSCAN_ISR
+    uint8_t tail;
+    
+    lastScanTime.val = tickGet();
+    tail = sampleTail;
+    while (tail != sampleHead) {
+        debounceColumn(sampleColumn[tail], sampleRows[tail]);
+        tail = (tail + 1) & (SAMPLE_BUFFER_SIZE - 1);
+        sampleTail = tail;      // frees the entry for the ISR
+    }
+#else
     uint8_t col;
-    uint8_t strobeMask;
-    uint8_t flags;
     
+    lastScanTime.val = tickGet();
     for ( col = 0; col < COLUMN_OUTPUTS; col++) {
-        strobeMask = ~((0b00000001 << col) & COLUMN_MASK);    // Shifting column from bit 0
-        COL_LAT |= COLUMN_MASK;                                 // Set all strobe column bits
-        COL_LAT &= strobeMask;                                  // Clear strobe bit to active low for this column
-
-        // Check each button read in the value strobed by the outputs
-        if (keyInputState[col].bits.b0 != KBD_INP0) {
-            if (debounceCounters[COUNTER_INDEX(col, 0)].nibbles.lower == DEBOUNCE_DELAY) {
-                debounceCounters[COUNTER_INDEX(col, 0)].nibbles.lower = 0;
-                keyInputState[col].bits.b0 = KBD_INP0;
-                
-                flags = (uint8_t)getNV(NV_PB_FLAGS+PB(col,0));
-                if (flags & NV_PB_FLAGS_TOGGLE) {
-                    keyOutputState[col].bits.b0 = ! keyOutputState[col].bits.b0;
-                } else {
-                    if (flags & NV_PB_FLAGS_POLARITY) {
-                        keyOutputState[col].bits.b0 = KBD_INP0;
-                    } else {
-                        keyOutputState[col].bits.b0 = ! KBD_INP0;
-                    }
-                }
-                sendPBEvent(PB(col,0), keyOutputState[col].bits.b0, flags);
-            } else {
-                debounceCounters[COUNTER_INDEX(col, 0)].nibbles.lower++;
+        STROBE_COLUMN(col);                                     // Clear strobe bit to active low for this column
+
+        debounceColumn(col, readRows());
+    }  // for each column strobe group
+#if EXTRA_COLUMNS > 0
+    EXT_LOAD(NO_EXTRA_COLUMN);
+#endif
+#endif
+}   // keyscan
+
+/**
+ * Update the debounce counts for a column and handle any debounced changes.
+ * @param col the column
+ * @param rows the row inputs read for the column
+ */
+static void debounceColumn(uint8_t col, uint8_t rows) {
+    uint8_t row;
+    uint8_t changed;
+    uint8_t mask;
+    uint8_t counter;
+    ByteNibbles * counters;
+    
+    changed = rows ^ keyInputState[col].val;
+    if ((changed | debouncing[col]) == 0) {
+        return;     // nothing happening in this column
+    }
+
+    // Check each button in the column
+    for (row = 0, mask = 1; row < ROW_INPUTS; row++, mask <<= 1) {
+        counters = &debounceCounters[COUNTER_INDEX(col, row)];
+        counter = (row & 1) ? counters->nibbles.upper : counters->nibbles.lower;
+        if ( ! (changed & mask)) {
+            // back to the debounced state
+            if (counter) {
+                LATENCY_PRESS_CANCEL(PB(col,row));      // just a bounce
             }
+            counter = 0;
+        } else if (counter < DEBOUNCE_DELAY) {
+            if (counter == 0) {
+                LATENCY_PRESS_START(PB(col,row));
+            }
+            counter++;
+        } else {
+            counter = 0;
+            keyInputState[col].val ^= mask;
+            if ( ! (toggleMask[col] & mask)) {
+                keyOutputState[col].val = (keyOutputState[col].val & (uint8_t)~mask) | 
+                        ((keyInputState[col].val ^ (uint8_t)~polarityMask[col]) & mask);
+                sendPBEvent(PB(col,row), keyOutputState[col].val & mask, col, mask);
+                SNAPSHOT_CHANGED();
+            } else if ( ! (keyInputState[col].val & mask)) {
+                // toggle on each press, the buttons are active low
+                keyOutputState[col].val ^= mask;
+                sendPBEvent(PB(col,row), keyOutputState[col].val & mask, col, mask);
+                SNAPSHOT_CHANGED();
+            }
+            LATENCY_PRESS_CANCEL(PB(col,row));      // if no event was sent
         }
-        if (keyInputState[col].bits.b1 != KBD_INP1) {
-            
-        }
-        if (keyInputState[col].bits.b2 != KBD_INP2) {
-            
-        }
-        if (keyInputState[col].bits.b3 != KBD_INP3) {
-            
-        }
-        if (keyInputState[col].bits.b4 != KBD_INP4) {
-            
-        }
-        if (keyInputState[col].bits.b5 != KBD_INP5) {
-            
-        }
-        if (keyInputState[col].bits.b6 != KBD_INP6) {
-            
+        if (row & 1) {
+            counters->nibbles.upper = counter;
+        } else {
+            counters->nibbles.lower = counter;
         }
-        if (keyInputState[col].bits.b7 != KBD_INP7) {
-            
+        if (counter) {
+            debouncing[col] |= mask;
+        } else {
+            debouncing[col] &= (uint8_t)~mask;
         }
-    }  // for each column strobe group
-}   // keyscan
+    }
+}
+
+#ifdef KEYSCAN_ISR
+/**
+ * Start the timer which reads a column on each interrupt. Should be called
+ * once the start up delay is over.
+ */
+void startKeyscanTimer(void) {
+    sampleHead = 0;
+    sampleTail = 0;
+    isrColumn = 0;
+#if defined(_18FXXQ83_FAMILY_)
+    T2CLKCON = 0x01;        // Fosc/4
+    T2HLT = 0x00;           // free running
+    T2PR = KEYSCAN_TIMER_PERIOD;
+    T2TMR = 0;
+    T2CON = 0xF0;           // on, 1:128 prescale, 1:1 postscale
+#endif
+#if defined(_18F66K80_FAMILY_)
+    PR2 = KEYSCAN_TIMER_PERIOD;
+    TMR2 = 0;
+    T2CON = 0x26;           // on, 1:16 prescale, 1:5 postscale
+    IPR1bits.TMR2IP = 0;
+#endif
+    KEYSCAN_TIMER_IF = 0;
+    KEYSCAN_TIMER_IE = 1;
+}
+
+/**
+ * Timer interrupt. Reads the next column and puts the result into the sample
+ * buffer for keyScan(). 
+ * mxBegin() claims the pins shared with the strobes through the port arbiter,
+ * which holds this interrupt off, so the two never overlap. A column read which
+ * falls due in an SPI session runs as soon as mxEnd() releases the pins. The strobes are all left inactive afterwards, which also leaves the
+ * MAX chip deselected. Extra columns in the shift registers take longer as the
+ * whole chain is loaded to select the column and again to deselect it.
+ */
+#if defined(_18FXXQ83_FAMILY_)
+void __interrupt(irq(TMR2), base(IVT_BASE), low_priority) keyScanIsr(void) {
+#endif
+#if defined(_18F66K80_FAMILY_)
+void keyScanIsr(void) {
+#endif
+    uint8_t rows;
+    uint8_t head;
+    uint8_t next;
+    
+    KEYSCAN_TIMER_IF = 0;
+    PROFILE_START(PROFILE_KEYSCAN_ISR);
+    STROBE_COLUMN(isrColumn);                               // Clear strobe bit for this column
+    NOP();                                                  // let the inputs settle
+    NOP();
+    READ_ROWS(rows);
+    COL_LAT |= COLUMN_MASK;                                 // All strobes inactive
+#if EXTRA_COLUMNS > 0
+    if (isrColumn >= NATIVE_COLUMNS) {
+        EXT_LOAD(NO_EXTRA_COLUMN);
+    }
+#endif
+    
+    head = sampleHead;
+    next = (head + 1) & (SAMPLE_BUFFER_SIZE - 1);
+    if (next == sampleTail) {
+        keyScanOverruns++;      // main loop hasn't kept up, drop the sample
+    } else {
+        sampleColumn[head] = isrColumn;
+        sampleRows[head] = rows;
+        sampleHead = next;      // publish the sample
+    }
+    if (++isrColumn >= COLUMN_OUTPUTS) {
+        isrColumn = 0;
+    }
+    PROFILE_END(PROFILE_KEYSCAN_ISR);
+}
+#endif
 
-void sendPBEvent(uint8_t pb, uint8_t state, uint8_t flags) {
+void sendPBEvent(uint8_t pb, uint8_t state, uint8_t col, uint8_t mask) {
+    TRACE(TRACE_PRODUCED, pb, state ? 1 : 0, 0);
     if (state) {
-        if (flags & NV_PB_FLAGS_SEND_ON) {
+        if (sendOnMask[col] & mask) {
             sendProducedEvent((Happening)(PB_2_HAPPENING(pb)), EVENT_ON);
+            LATENCY_PRESS_END(pb);
         }
     } else {
-        if (flags & NV_PB_FLAGS_SEND_OFF) {
+        if (sendOffMask[col] & mask) {
             sendProducedEvent((Happening) (PB_2_HAPPENING(pb)), EVENT_OFF);
+            LATENCY_PRESS_END(pb);
         }
     }
 }
@@ -241,6 +514,88 @@ EventState getKeyState(uint8_t pb) {
     return EVENT_UNKNOWN;
 }
 
+/**
+ * Scan the keys if it is time to.
+ */
+void keyScanPoll(void) {
+    if (tickTimeSince(lastScanTime) >= KEY_SCAN_INTERVAL) {
+        keyScan();
+    }
+}
+
+/**
+ * @return TRUE if any button is part way through its debounce
+ */
+Boolean keyDebounceActive(void) {
+    uint8_t col;
+    
+    for (col = 0; col < COLUMN_OUTPUTS; col++) {
+        if (debouncing[col]) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * Work out which buttons of a column would send an event if the edge they
+ * are being debounced towards were accepted.
+ * @param col the column
+ * @return one bit per row
+ */
+static uint8_t eventRows(uint8_t col) {
+    uint8_t newInput;
+    uint8_t newOutput;
+    uint8_t rows;
+    
+    newInput = (uint8_t)~keyInputState[col].val;
+    // the output follows the input
+    newOutput = newInput ^ (uint8_t)~polarityMask[col];
+    rows = (uint8_t)~toggleMask[col] & ((newOutput & sendOnMask[col]) | ((uint8_t)~newOutput & sendOffMask[col]));
+    // the output changes on each press, the buttons are active low
+    newOutput = (uint8_t)~keyOutputState[col].val;
+    rows |= toggleMask[col] & (uint8_t)~newInput & ((newOutput & sendOnMask[col]) | ((uint8_t)~newOutput & sendOffMask[col]));
+    return rows;
+}
+
+/**
+ * @return TRUE if a button being debounced will send an event when its 
+ * debounce completes
+ */
+Boolean keyEventPending(void) {
+    uint8_t col;
+    
+    for (col = 0; col < COLUMN_OUTPUTS; col++) {
+        if (debouncing[col] & eventRows(col)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * Get the output state of the buttons in a column, one bit per row.
+ * @param col the column
+ * @return the output states after toggle
+ */
+uint8_t getColumnOutputState(uint8_t col) {
+    return keyOutputState[col].val;
+}
+
+/**
+ * Put back previously saved output states for the toggle buttons in a column.
+ * The other buttons keep following their inputs.
+ * @param col the column
+ * @param state the saved output states, one bit per row
+ */
+void restoreToggleState(uint8_t col, uint8_t state) {
+    uint8_t mask;
+    
+    mask = toggleMask[col];
+    keyOutputState[col].val = (keyOutputState[col].val & (uint8_t)~mask) | (state & mask);
+    SNAPSHOT_CHANGED();
+}
+
 #ifdef RETURN_LOOKUP
 /**
  *  Return lookup keycode value as a uint8_t from the strobe results array
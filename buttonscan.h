@@ -56,6 +56,31 @@
 #include "matrix.h"
 
 #define KEY_DEBOUNCE_TIME   TWENTY_MILI_SECOND
+#define KEY_SCAN_INTERVAL   (10*ONE_MILI_SECOND)
+#ifdef KEYSCAN_ISR
+// Timer 2 period for one column, so every column is read every 10ms
+#if defined(_18FXXQ83_FAMILY_)
+#define KEYSCAN_TIMER_PERIOD    (1250/COLUMN_OUTPUTS - 1)   // 125kHz after prescale
+#endif
+#if defined(_18F66K80_FAMILY_)
+#define KEYSCAN_TIMER_PERIOD    (2000/COLUMN_OUTPUTS - 1)   // 1MHz after prescale, 1:5 postscale
+#endif
+#if defined(_18FXXQ83_FAMILY_)
+#define KEYSCAN_TIMER_IE        PIE3bits.TMR2IE
+#define KEYSCAN_TIMER_IF        PIR3bits.TMR2IF
+#endif
+#if defined(_18F66K80_FAMILY_)
+#define KEYSCAN_TIMER_IE        PIE1bits.TMR2IE
+#define KEYSCAN_TIMER_IF        PIR1bits.TMR2IF
+#endif
+// Hold off the key scan interrupt, e.g. whilst the pins shared with the strobes
+// are in use. IPEN is not set so GIEL would not hold it off.
+#define holdKeyScan(state)      {state = KEYSCAN_TIMER_IE; KEYSCAN_TIMER_IE = 0;}
+#define resumeKeyScan(state)    {KEYSCAN_TIMER_IE = state;}
+#else
+#define holdKeyScan(state)      {state = FALSE;}
+#define resumeKeyScan(state)
+#endif
 
 #define CR  0x13
 
@@ -71,7 +96,20 @@ typedef union
 // Function prototypes
 void initKeyscan(void);
 void keyScan( void );
+void keyScanPoll( void );
+void buildPbMasks(uint8_t col);
+Boolean keyDebounceActive(void);
+Boolean keyEventPending(void);
 EventState getKeyState(uint8_t pb);
+uint8_t getColumnOutputState(uint8_t col);
+#ifdef KEYSCAN_ISR
+extern volatile uint16_t keyScanOverruns;
+void startKeyscanTimer(void);
+#if defined(_18F66K80_FAMILY_)
+void keyScanIsr(void);
+#endif
+#endif
+void restoreToggleState(uint8_t col, uint8_t state);
 
 #endif
 
@@ -0,0 +1,124 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Fast clock display for the CANPANEL.
+ *
+ * The FCLK messages broadcast by the layout clock are shown as HH:MM on a
+ * window of 4 consecutive digits starting at the digit set by NV_FAST_CLOCK.
+ * Only the digits which change are written to the MAX6951 so a normal minute
+ * tick costs a single SPI command. The decode mask for the window is sent
+ * once when the clock mode is set up, not on every digit.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+#include "nv.h"
+#include "fastClock.h"
+#include "max6951.h"
+
+// Decimal point used as the separator between hours and minutes
+#define CLOCK_SEPARATOR     0x80
+#define NOT_SHOWN           0xFF
+
+static uint8_t clockOffset;                         // first digit of the window, NOT_SHOWN when disabled
+static uint8_t clockShown[FAST_CLOCK_DIGITS];       // what is currently on the digits
+static uint8_t clockMask;                           // the digits of the window
+
+/**
+ * Set up the clock window from the NVs. Called at power up and whenever the
+ * clock mode changes.
+ */
+void fastClockInit(void) {
+    uint8_t i;
+    uint8_t window;
+
+    // give up any previous window
+    setDecodeMask(getDecodeMask() & (uint8_t)~clockMask);
+    clockMask = 0;
+    
+    window = (uint8_t)getNV(NV_FAST_CLOCK);
+    if ((window == 0) || (window > (8 - FAST_CLOCK_DIGITS + 1))) {
+        clockOffset = NOT_SHOWN;
+        return;
+    }
+    clockOffset = window - 1;
+    for (i=0; i<FAST_CLOCK_DIGITS; i++) {
+        clockShown[i] = NOT_SHOWN;
+    }
+    // hex decode for the whole window, sent once
+    clockMask = (uint8_t)(((1<<FAST_CLOCK_DIGITS)-1) << clockOffset);
+    setDecodeMask(getDecodeMask() | clockMask);
+}
+
+/**
+ * @return the digits used by the clock, which need hex decode
+ */
+uint8_t fastClockDecodeMask(void) {
+    return clockMask;
+}
+
+/**
+ * Handle an FCLK message. 
+ * Format is OPC_FCLK <mins><hrs><wdmon><div><mday><temp>
+ * 
+ * @param m the received message
+ * @return PROCESSED if it was a fast clock message
+ */
+Processed fastClockMessage(Message * m) {
+    uint8_t digits[FAST_CLOCK_DIGITS];
+    uint8_t i;
+
+    if (m->opc != OPC_FCLK) {
+        return NOT_PROCESSED;
+    }
+    if (clockOffset == NOT_SHOWN) {
+        return PROCESSED;
+    }
+    if ((m->len < 3) || (m->bytes[0] > 59) || (m->bytes[1] > 23)) {
+        return PROCESSED;
+    }
+    digits[0] = m->bytes[1] / 10;
+    digits[1] = (m->bytes[1] % 10) | CLOCK_SEPARATOR;
+    digits[2] = m->bytes[0] / 10;
+    digits[3] = m->bytes[0] % 10;
+    
+    // only write the digits which have changed
+    for (i=0; i<FAST_CLOCK_DIGITS; i++) {
+        if (digits[i] != clockShown[i]) {
+            setDigit(clockOffset + i, digits[i]);
+            clockShown[i] = digits[i];
+        }
+    }
+    return PROCESSED;
+}
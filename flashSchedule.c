@@ -0,0 +1,141 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Flash write scheduling for the CANPANEL.
+ *
+ * An erase/write of the program flash, used for the event table and on the
+ * 18F66K80 for the NVs as well, stops the CPU for several milliseconds. The
+ * library asks APP_isSuitableTimeToWriteFlash() before writing a block, and
+ * again before erasing it, and spins until it is told GOOD_TIME. 
+ * 
+ * Nothing but the interrupts runs whilst it spins so holding a write back
+ * there would stall the key scan, the LEDs and the CAN receive processing for
+ * as long as it was held. The library writes the block straight after teaching
+ * an event, from within its message handling, and keeps the write flags to 
+ * itself, so a write can't be queued for later either. Every write is 
+ * therefore allowed at once. The writes which start with LED changes or a 
+ * button debounce pending are counted, as they are the ones which are seen.
+ * Once a write has been allowed every further ask returns GOOD_TIME until the
+ * main loop runs again, and the time until it does is recorded as the stall.
+ * 
+ * flashQuietTime() tells work of our own, which can simply try again later,
+ * whether a write now would get in the way of a burst of consumed events, 
+ * the LEDs or the buttons.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "flashSchedule.h"
+#include "buttonscan.h"
+#include "max6951.h"
+#include "profile.h"
+
+FlashStats flashStats;
+
+static TickValue lastConsumedEvent;
+static TickValue allowedTime;
+static Boolean stalled;                 // a write has been allowed and the main loop hasn't run since
+#ifdef PROFILE
+static uint16_t profileStall;
+#endif
+
+/**
+ * Convert a tick count to a saturated 16 bit value.
+ */
+static uint16_t saturate(uint32_t ticks) {
+    return (ticks > 0xFFFF) ? 0xFFFF : (uint16_t)ticks;
+}
+
+/**
+ * Record that a consumed event has been processed.
+ */
+void flashNoteConsumedEvent(void) {
+    lastConsumedEvent.val = tickGet();
+}
+
+/**
+ * @return TRUE if a burst of consumed events is in progress
+ */
+static Boolean eventBurst(void) {
+    return tickTimeSince(lastConsumedEvent) < FLASH_BURST_GAP;
+}
+
+/**
+ * Check, without waiting or counting, whether now is a good time for a write
+ * which can be tried again later.
+ * @return TRUE if nothing would be held up by a write
+ */
+Boolean flashQuietTime(void) {
+    return ! (eventBurst() || ledFlushPending() || keyDebounceActive());
+}
+
+/**
+ * Called by the library before a flash erase or write. The write is never 
+ * held back as the library spins until it is allowed, the collisions and the
+ * stall are recorded instead.
+ * @return GOOD_TIME
+ */
+ValidTime flashWriteAllowed(void) {
+    if (stalled) {
+        return GOOD_TIME;       // already allowed, the library asks again to erase
+    }
+    if (ledFlushPending() || keyDebounceActive()) {
+        flashStats.collisions++;
+    }
+    flashStats.writes++;
+    allowedTime.val = tickGet();
+    stalled = TRUE;
+#ifdef PROFILE
+    profileStall = profileTime();
+#endif
+    return GOOD_TIME;
+}
+
+/**
+ * Called at the start of each main loop to measure how long the loop was 
+ * stalled by a write.
+ */
+void flashScheduleLoop(void) {
+    if (stalled) {
+        stalled = FALSE;
+#ifdef PROFILE
+        profileRecord(PROFILE_FLASH_WRITE, profileStall);
+#endif
+        flashStats.lastStall = saturate(tickTimeSince(allowedTime));
+        if (flashStats.lastStall > flashStats.maxStall) {
+            flashStats.maxStall = flashStats.lastStall;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef _FLASHSCHEDULE_H_
+#define _FLASHSCHEDULE_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Measure the flash writes and tell our own deferrable work when a write
+ * would get in the way of the key scan and the LEDs.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "nvm.h"
+#include "ticktime.h"
+
+// Consumed events closer together than this are treated as a burst
+#define FLASH_BURST_GAP         (50*ONE_MILI_SECOND)
+
+/*
+ * Times are in ticks (16us) and saturate at 0xFFFF.
+ */
+typedef struct {
+    uint16_t writes;        // writes allowed
+    uint16_t collisions;    // writes started with LED changes or a debounce pending
+    uint16_t lastStall;     // from being allowed until the main loop runs again
+    uint16_t maxStall;
+} FlashStats;
+
+extern FlashStats flashStats;
+
+void flashNoteConsumedEvent(void);
+ValidTime flashWriteAllowed(void);
+Boolean flashQuietTime(void);
+void flashScheduleLoop(void);
+
+#endif
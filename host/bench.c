@@ -0,0 +1,515 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Benchmarks of the firmware in the host build.
+ *
+ * Each scenario is run in a process of its own, as a node can only be powered
+ * up once per process. It sets up and settles a node, then measures the work
+ * the firmware does for the scenario alone. The results are written as JSON
+ * and may be compared with a baseline, failing if any of them is worse by more
+ * than the tolerance. Every metric is one where lower is better.
+ *
+ *   bench [-o results.json] [-c baseline.json] [-t percent]
+ *
+ * The virtual clock makes the results the same on every run, so a small
+ * tolerance only allows for a change of compiler.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "hostCosts.h"
+#include "hostNode.h"
+#include "hostProfile.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#ifdef PROFILE
+#include "profile.h"
+#endif
+
+#define NODE_NN         256
+#define EVENT_NN        0x0102
+#define SETTLE_MS       3000
+#define DEFAULT_TOLERANCE   2.0     // percent
+
+#define MAX_METRICS     128
+#define MAX_OUTPUT      8192
+
+typedef struct {
+    char scenario[32];
+    char metric[32];
+    double value;
+} Metric;
+
+typedef struct {
+    const char * name;
+    void (* run)(void);
+} Scenario;
+
+static HostStats startStats;
+static FILE * results;
+
+/**
+ * Give up on a scenario whose outcome is wrong, as its numbers mean nothing.
+ */
+static void benchFail(const char * scenario, const char * why) {
+    fprintf(stderr, "%s: %s\n", scenario, why);
+    exit(1);
+}
+
+static void newNode(void) {
+    HostConfig config = {NODE_NN, 10, CAN_DEFAULT_BIT_RATE};
+
+    hostReset();
+    hostConfigure(&config);
+}
+
+static void sendEvent(uint8_t opc, uint16_t nodeNumber, uint16_t eventNumber) {
+    uint8_t bytes[4] = {nodeNumber >> 8, nodeNumber & 0xFF, eventNumber >> 8, eventNumber & 0xFF};
+
+    hostReceiveMessage(5, opc, bytes);
+}
+
+/**
+ * The cycles a five byte frame, an ACON, takes on the bus.
+ */
+static uint64_t eventFrameCycles(void) {
+    HostFrame f;
+
+    memset(&f, 0, sizeof(f));
+    f.id = 0x57F;
+    f.len = 5;
+    f.data[0] = OPC_ACON;
+    return canFrameBits(&f) * canBitCycles(CAN_DEFAULT_BIT_RATE);
+}
+
+static void benchStart(void) {
+    hostRunFor(MS_CYCLES(SETTLE_MS));
+    hostClearWorst();
+#ifdef PROFILE
+    resetProfile();
+#endif
+    hostGetStats(&startStats);
+}
+
+static void benchEnd(const char * name) {
+    HostStats s;
+
+    hostGetStats(&s);
+    fprintf(results, "    \"%s\": {\n", name);
+    fprintf(results, "        \"spiTransactions\": %u,\n", s.spiTransactions - startStats.spiTransactions);
+    fprintf(results, "        \"getNvCalls\": %u,\n", s.getNvCalls - startStats.getNvCalls);
+    fprintf(results, "        \"getEvsCalls\": %u,\n", s.getEvsCalls - startStats.getEvsCalls);
+    fprintf(results, "        \"flashErases\": %u,\n", s.flashErases - startStats.flashErases);
+    fprintf(results, "        \"flashWrites\": %u,\n", s.flashWrites - startStats.flashWrites);
+    fprintf(results, "        \"eepromWrites\": %u,\n", s.eepromWrites - startStats.eepromWrites);
+    fprintf(results, "        \"messagesSent\": %u,\n", s.messagesSent - startStats.messagesSent);
+    fprintf(results, "        \"busyCycles\": %llu,\n",
+            (unsigned long long)((s.cycles - s.idleCycles) - (startStats.cycles - startStats.idleCycles)));
+    fprintf(results, "        \"worstLoopCycles\": %u,\n", s.worstLoopCycles);
+    fprintf(results, "        \"worstInterruptCycles\": %u,\n", s.worstInterruptCycles);
+    fprintf(results, "        \"profile\": ");
+    hostProfileJson(results);
+    fprintf(results, "\n    }");
+}
+
+/**
+ * The LEDs of a 64 LED route set on a dark panel. An event has room for nine
+ * actions, so the route is eight events of eight LEDs sent back to back, as a
+ * route is by the controller which sets it.
+ */
+static void routeChange(void) {
+    uint8_t route;
+    uint8_t i;
+
+    newNode();
+    hostPowerUp();
+    for (route = 0; route < 8; route++) {
+        for (i = 0; i < 8; i++) {
+            hostTeach(EVENT_NN, route + 1, 1 + 2*i, route*8 + i + 1);
+            hostTeach(EVENT_NN, route + 1, 2 + 2*i, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+        }
+    }
+    benchStart();
+    for (route = 0; route < 8; route++) {
+        sendEvent(OPC_ACON, EVENT_NN, route + 1);
+        hostRunFor(eventFrameCycles());
+    }
+    hostRunFor(MS_CYCLES(200));
+    for (i = 1; i <= 64; i++) {
+        if (hostLedState(i) != 3) {
+            benchFail("routeChange", "an LED of the route isn't on");
+        }
+    }
+    benchEnd("routeChange");
+}
+
+/**
+ * 500 events a second for two seconds, over 64 taught events of one LED each.
+ */
+static void flood(void) {
+    uint16_t i;
+    uint16_t en;
+
+    newNode();
+    hostPowerUp();
+    for (i = 0; i < 64; i++) {
+        hostTeach(EVENT_NN, i + 1, 1, i + 1);
+        hostTeach(EVENT_NN, i + 1, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+    }
+    benchStart();
+    for (i = 0; i < 1000; i++) {
+        en = (i * 7) % 64 + 1;
+        sendEvent(((i / 64) & 1) ? OPC_ACOF : OPC_ACON, EVENT_NN, en);
+        hostRunFor(MS_CYCLES(2));
+    }
+    hostRunFor(MS_CYCLES(100));
+    benchEnd("flood");
+}
+
+/**
+ * A switch which bounces every one to five ms for two seconds before it
+ * settles closed. The debounce sees the switch only at each key scan, so a
+ * bounce may get through; the messages sent show how many.
+ */
+static void bounceStorm(void) {
+    uint32_t seed;
+    uint32_t t;
+    uint8_t down;
+    HostStats s;
+
+    newNode();
+    hostSetNv(NV_PB_FLAGS + 10, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF);
+    hostPowerUp();
+    hostTeach(NODE_NN, 11, 0, PB_2_HAPPENING(10));
+    benchStart();
+    seed = 1;
+    down = 0;
+    for (t = 0; t < 2000; ) {
+        seed = seed * 1103515245 + 12345;
+        down = ! down;
+        hostSetButton(10, down);
+        hostRunFor(MS_CYCLES(1 + (seed >> 16) % 5));
+        t += 1 + (seed >> 16) % 5;
+    }
+    hostSetButton(10, 1);
+    hostRunFor(MS_CYCLES(200));
+    hostGetStats(&s);
+    if (s.messagesSent == startStats.messagesSent) {
+        benchFail("bounceStorm", "the settled switch wasn't sent");
+    }
+    benchEnd("bounceStorm");
+}
+
+/**
+ * A start of day of 64 buttons, asked for by a consumed event.
+ */
+static void startOfDay(void) {
+    uint8_t pb;
+    HostStats s;
+
+    newNode();
+    for (pb = 0; pb < 64; pb++) {
+        hostSetNv(NV_PB_FLAGS + pb, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF | NV_PB_FLAGS_ENABLE_SOD);
+    }
+    hostPowerUp();
+    for (pb = 0; pb < 64; pb++) {
+        hostTeach(NODE_NN, 100 + pb, 0, PB_2_HAPPENING(pb));
+    }
+    hostTeach(EVENT_NN, 1, 1, ACTION_SPECIALS);
+    hostTeach(EVENT_NN, 1, 2, ACTION_SPECIAL_SOD);
+    benchStart();
+    sendEvent(OPC_ACON, EVENT_NN, 1);
+    hostRunFor(MS_CYCLES(3000));
+    hostGetStats(&s);
+    if (s.messagesSent - startStats.messagesSent < 64) {
+        benchFail("startOfDay", "not every button was sent");
+    }
+    benchEnd("startOfDay");
+}
+
+static uint8_t acked;
+
+static void watchAck(const HostFrame * frame) {
+    if ((frame->len > 0) && (frame->data[0] == OPC_WRACK)) {
+        acked = 1;
+    }
+}
+
+/**
+ * Send a teaching message and wait for its WRACK, as the FCU does.
+ */
+static void teachStep(uint8_t len, uint8_t opc, const uint8_t * bytes) {
+    uint16_t ms;
+
+    acked = 0;
+    hostReceiveMessage(len, opc, bytes);
+    for (ms = 0; ! acked; ms++) {
+        if (ms > 1000) {
+            benchFail("reteach", "a teaching message wasn't acknowledged");
+        }
+        hostRunFor(MS_CYCLES(1));
+    }
+}
+
+static void evlrn(uint16_t eventNumber, uint8_t evIndex, uint8_t evVal) {
+    uint8_t bytes[6] = {EVENT_NN >> 8, EVENT_NN & 0xFF, eventNumber >> 8, eventNumber & 0xFF, evIndex, evVal};
+
+    teachStep(7, OPC_EVLRN, bytes);
+}
+
+/**
+ * The FCU clearing the node's events and teaching its whole table again,
+ * 64 produced events and 64 consumed events of two LEDs each.
+ */
+static void reteach(void) {
+    uint8_t nn[2] = {NODE_NN >> 8, NODE_NN & 0xFF};
+    uint8_t i;
+
+    newNode();
+    hostPowerUp();
+    txObserver = watchAck;
+    benchStart();
+    hostReceiveMessage(3, OPC_NNLRN, nn);
+    teachStep(3, OPC_NNCLR, nn);
+    for (i = 0; i < 64; i++) {
+        evlrn(200 + i, 1, PB_2_HAPPENING(i));
+    }
+    for (i = 0; i < 64; i++) {
+        evlrn(i + 1, 2, 2*i + 1);
+        evlrn(i + 1, 3, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+        evlrn(i + 1, 4, 2*i + 2);
+        evlrn(i + 1, 5, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+    }
+    hostReceiveMessage(3, OPC_NNULN, nn);
+    hostRunFor(MS_CYCLES(100));
+    benchEnd("reteach");
+}
+
+static const Scenario scenarios[] = {
+    {"routeChange", routeChange},
+    {"flood", flood},
+    {"bounceStorm", bounceStorm},
+    {"startOfDay", startOfDay},
+    {"reteach", reteach},
+};
+
+#define NUM_SCENARIOS   (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/**
+ * Run a scenario in a child process.
+ * @return 0 if it ran, with its JSON in out
+ */
+static int runScenario(const Scenario * scenario, char * out, size_t size) {
+    int fds[2];
+    pid_t pid;
+    size_t len;
+    ssize_t n;
+    int status;
+
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        results = fdopen(fds[1], "w");
+        scenario->run();
+        fclose(results);
+        _exit(0);
+    }
+    close(fds[1]);
+    len = 0;
+    while ((n = read(fds[0], out + len, size - 1 - len)) > 0) {
+        len += n;
+    }
+    out[len] = '\0';
+    close(fds[0]);
+    if ((waitpid(pid, &status, 0) < 0) || ! WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Read the metrics from the JSON written by benchEnd(), a scenario per line
+ * at the first indent and a number per line at the second. Anything else,
+ * such as the profile, isn't compared.
+ * @return the number of metrics
+ */
+static int parseMetrics(const char * text, Metric * metrics, int count) {
+    char scenario[32] = "";
+    char name[32];
+    double value;
+    const char * line;
+
+    for (line = text; (line != NULL) && *line; line = strchr(line, '\n'), line = line ? line + 1 : NULL) {
+        if ((strncmp(line, "    \"", 5) == 0) && (sscanf(line + 5, "%31[^\"]\": {", name) == 1)) {
+            strcpy(scenario, name);
+        } else if ((strncmp(line, "        \"", 9) == 0)
+                && (sscanf(line + 9, "%31[^\"]\": %lf", name, &value) == 2)
+                && (count < MAX_METRICS)) {
+            strcpy(metrics[count].scenario, scenario);
+            strcpy(metrics[count].metric, name);
+            metrics[count].value = value;
+            count++;
+        }
+    }
+    return count;
+}
+
+static int readFile(const char * path, char * text, size_t size) {
+    FILE * f;
+    size_t len;
+
+    f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    len = fread(text, 1, size - 1, f);
+    text[len] = '\0';
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @return the number of metrics worse than the baseline by more than the tolerance
+ */
+static int compare(const Metric * now, int nowCount, const Metric * base, int baseCount, double tolerance) {
+    int regressions;
+    int i;
+    int j;
+    double limit;
+
+    regressions = 0;
+    for (i = 0; i < nowCount; i++) {
+        for (j = 0; j < baseCount; j++) {
+            if ((strcmp(now[i].scenario, base[j].scenario) == 0) && (strcmp(now[i].metric, base[j].metric) == 0)) {
+                break;
+            }
+        }
+        if (j == baseCount) {
+            printf("%s.%s: not in the baseline\n", now[i].scenario, now[i].metric);
+            continue;
+        }
+        limit = base[j].value * (1.0 + tolerance / 100.0);
+        if (now[i].value > limit) {
+            printf("%s.%s: %.0f, baseline %.0f: REGRESSION\n", now[i].scenario, now[i].metric, now[i].value, base[j].value);
+            regressions++;
+        } else if (now[i].value < base[j].value * (1.0 - tolerance / 100.0)) {
+            printf("%s.%s: %.0f, baseline %.0f: improved, update the baseline\n", now[i].scenario, now[i].metric, now[i].value, base[j].value);
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char ** argv) {
+    static char text[NUM_SCENARIOS * MAX_OUTPUT];
+    static char baseText[NUM_SCENARIOS * MAX_OUTPUT];
+    static Metric now[MAX_METRICS];
+    static Metric base[MAX_METRICS];
+    const char * outPath = NULL;
+    const char * basePath = NULL;
+    double tolerance = DEFAULT_TOLERANCE;
+    size_t len;
+    int nowCount;
+    int baseCount;
+    int failed;
+    int opt;
+    unsigned i;
+    FILE * out;
+
+    while ((opt = getopt(argc, argv, "o:c:t:")) != -1) {
+        switch (opt) {
+            case 'o':
+                outPath = optarg;
+                break;
+            case 'c':
+                basePath = optarg;
+                break;
+            case 't':
+                tolerance = atof(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-o results.json] [-c baseline.json] [-t percent]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    failed = 0;
+    strcpy(text, "{\n");
+    for (i = 0; i < NUM_SCENARIOS; i++) {
+        len = strlen(text);
+        if (runScenario(&scenarios[i], text + len, MAX_OUTPUT) != 0) {
+            fprintf(stderr, "%s: failed to run\n", scenarios[i].name);
+            text[len] = '\0';
+            failed = 1;
+            continue;
+        }
+        strcat(text, (i + 1 < NUM_SCENARIOS) ? ",\n" : "\n");
+    }
+    strcat(text, "}\n");
+
+    out = stdout;
+    if (outPath != NULL) {
+        out = fopen(outPath, "w");
+        if (out == NULL) {
+            perror(outPath);
+            return 2;
+        }
+    }
+    fputs(text, out);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    if (basePath != NULL) {
+        if (readFile(basePath, baseText, sizeof(baseText)) != 0) {
+            perror(basePath);
+            return 2;
+        }
+        nowCount = parseMetrics(text, now, 0);
+        baseCount = parseMetrics(baseText, base, 0);
+        if (compare(now, nowCount, base, baseCount, tolerance) > 0) {
+            failed = 1;
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,194 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * CAN frame timing and text.
+ *
+ * The length of a frame on the bus is worked out bit by bit, with the CRC and
+ * the stuff bits it really has, rather than from a worst case.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "hostCosts.h"
+#include "canBus.h"
+
+/**
+ * The bits of a frame from SOF to the end of the CRC, which is the part
+ * which is bit stuffed.
+ */
+static uint8_t frameBits(const HostFrame * frame, uint8_t * bits) {
+    uint8_t n;
+    uint8_t i;
+    uint8_t b;
+    uint16_t crc;
+    uint8_t stuffed;
+
+    n = 0;
+    bits[n++] = 0;                              // SOF
+    for (i = 0; i < 11; i++) {
+        bits[n++] = (frame->id >> (10 - i)) & 1;
+    }
+    bits[n++] = 0;                              // RTR
+    bits[n++] = 0;                              // IDE
+    bits[n++] = 0;                              // r0
+    for (i = 0; i < 4; i++) {
+        bits[n++] = (frame->len >> (3 - i)) & 1;
+    }
+    for (i = 0; i < frame->len; i++) {
+        for (b = 0; b < 8; b++) {
+            bits[n++] = (frame->data[i] >> (7 - b)) & 1;
+        }
+    }
+    crc = 0;
+    stuffed = n;
+    for (i = 0; i < stuffed; i++) {
+        uint8_t next = bits[i] ^ ((crc >> 14) & 1);
+
+        crc = (uint16_t)((crc << 1) & 0x7FFF);
+        if (next) {
+            crc ^= 0x4599;
+        }
+    }
+    for (i = 0; i < 15; i++) {
+        bits[n++] = (crc >> (14 - i)) & 1;
+    }
+    return n;
+}
+
+/**
+ * @return the bit times a frame takes, including its stuff bits and the
+ * interframe space
+ */
+uint16_t canFrameBits(const HostFrame * frame) {
+    uint8_t bits[128];
+    uint8_t n;
+    uint8_t i;
+    uint8_t run;
+    uint8_t level;
+    uint16_t total;
+
+    n = frameBits(frame, bits);
+    total = n;
+    run = 0;
+    level = 2;
+    for (i = 0; i < n; i++) {
+        if (bits[i] == level) {
+            run++;
+        } else {
+            level = bits[i];
+            run = 1;
+        }
+        if (run == 5) {
+            // the stuff bit is the opposite level and starts a new run
+            total++;
+            level = !level;
+            run = 1;
+        }
+    }
+    // CRC delimiter, ACK slot and delimiter, EOF and interframe space
+    return (uint16_t)(total + 1 + 2 + 7 + 3);
+}
+
+uint64_t canBitCycles(uint32_t bitRate) {
+    return (uint64_t)CYCLES_PER_US * 1000000 / bitRate;
+}
+
+/**
+ * Write a frame as GridConnect text, e.g. :SB020N9001020007; where the
+ * four hex digits are the SIDH and SIDL registers, the identifier shifted
+ * up by five bits.
+ * @param text CAN_TEXT_SIZE bytes
+ */
+void canFrameText(const HostFrame * frame, char * text) {
+    uint8_t i;
+
+    text += sprintf(text, ":S%04XN", (unsigned)(frame->id << 5) & 0xFFE0);
+    for (i = 0; (i < frame->len) && (i < 8); i++) {
+        text += sprintf(text, "%02X", frame->data[i]);
+    }
+    strcpy(text, ";");
+}
+
+static int hexDigit(char c) {
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * Read a standard data frame from GridConnect text. Extended and remote
+ * frames aren't used by VLCB and aren't accepted.
+ * @return the text after the frame, or NULL if it isn't a frame
+ */
+const char * canFrameParse(const char * text, HostFrame * frame) {
+    uint16_t sid;
+    uint8_t i;
+    int hi;
+    int lo;
+
+    if ((text[0] != ':') || (text[1] != 'S')) {
+        return NULL;
+    }
+    text += 2;
+    sid = 0;
+    for (i = 0; i < 4; i++) {
+        hi = hexDigit(*text++);
+        if (hi < 0) {
+            return NULL;
+        }
+        sid = (uint16_t)((sid << 4) | hi);
+    }
+    if (*text++ != 'N') {
+        return NULL;
+    }
+    memset(frame, 0, sizeof(*frame));
+    frame->id = sid >> 5;
+    while (*text != ';') {
+        hi = hexDigit(text[0]);
+        lo = (hi < 0) ? -1 : hexDigit(text[1]);
+        if ((lo < 0) || (frame->len == 8)) {
+            return NULL;
+        }
+        frame->data[frame->len++] = (uint8_t)((hi << 4) | lo);
+        text += 2;
+    }
+    return text + 1;
+}
@@ -0,0 +1,67 @@
+#ifndef _CANBUS_H_
+#define _CANBUS_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * CAN frames as they go between the host build's nodes, how long they
+ * occupy the bus, and their GridConnect text form as used by CAN USB
+ * interfaces and the logs they make.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+
+#define CAN_DEFAULT_BIT_RATE    125000
+
+/**
+ * A standard data frame. The identifier is made as by the VLCB library, the
+ * priority in bits 8 to 10 and the CANID in bits 0 to 6, so the lower value
+ * wins arbitration.
+ */
+typedef struct {
+    uint16_t id;
+    uint8_t len;
+    uint8_t data[8];
+    uint64_t time;          // cycle queued for transmission or received
+} HostFrame;
+
+// the longest GridConnect frame, :SxxxxN and 8 data bytes then ; and the NUL
+#define CAN_TEXT_SIZE           25
+
+uint16_t canFrameBits(const HostFrame * frame);
+uint64_t canBitCycles(uint32_t bitRate);
+void canFrameText(const HostFrame * frame, char * text);
+const char * canFrameParse(const char * text, HostFrame * frame);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef _HOSTCOSTS_H_
+#define _HOSTCOSTS_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The time charged to the virtual clock, in instruction cycles of the
+ * PIC18F27Q83 at 64MHz (16 cycles per us).
+ *
+ * The firmware runs natively so its own instructions can't be counted. The
+ * clock is instead charged for each SFR access, each call of a firmware
+ * function and each call into the library. The library costs are estimates
+ * of the XC8 code, and the NVM and SPI times are typical data sheet values.
+ * The resulting times are good for comparing one build or scenario with
+ * another, not as absolute measurements.
+ *
+ * @date October 2026
+ */
+
+#define CYCLES_PER_US           16
+#define CYCLES_PER_TICK         256         // ticktime's 16us tick
+#define MS_CYCLES(ms)           ((uint64_t)(ms) * 1000 * CYCLES_PER_US)
+
+#define COST_SFR_ACCESS         1           // a MOVF/MOVWF/BSF/BCF
+#define COST_FUNCTION_CALL      8           // CALL, RETURN and argument passing
+#define COST_INTERRUPT          20          // vectoring plus context save and restore
+#define COST_SPI_BYTE           8           // 8 bits at 16MHz
+
+#define COST_TICK_GET           20
+#define COST_GET_NV             12
+#define COST_EEPROM_READ        20
+#define COST_FLASH_READ         15          // TBLRD or the block buffer
+#define COST_FLASH_BUFFER_WRITE 25
+#define COST_SEND_MESSAGE       150         // build the frame in the TX FIFO
+#define COST_RECEIVE_MESSAGE    120         // copy a frame out of the RX FIFO
+#define COST_SERVICE_DISPATCH   40          // offer a message to one service
+#define COST_HASH_LOOKUP        30          // hash plus chain walk overhead of findEvent()
+#define COST_POLL               150         // the library's poll() with nothing to do
+#define COST_LOOP               100         // the rest of the main loop
+
+#define COST_EEPROM_WRITE       MS_CYCLES(4)    // interrupts run during the write
+#define COST_FLASH_ERASE        MS_CYCLES(10)   // the CPU is stalled
+#define COST_FLASH_WRITE        MS_CYCLES(10)   // the CPU is stalled
+#define COST_FLASH_LOAD         300             // read a block into the buffer
+
+#endif
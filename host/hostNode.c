@@ -0,0 +1,362 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Runs a CANPANEL node in the host build.
+ *
+ * The main loop is the library's, poll() then loop(), with each pass timed on
+ * the virtual clock. Between passes, when no frame is waiting and no task is
+ * due, the clock is moved straight on to the next time the loop has something
+ * to do. The key scan interrupt still happens on time whilst it is idle. This
+ * is what lets a node run many times faster than real time.
+ *
+ * A node given a bit rate has a bus of its own, where each frame it sends
+ * takes the time it would on the wire and nothing else is sent. Otherwise
+ * the frames are left in the TX FIFO for the caller, such as the bus of
+ * hostSim.c, to send.
+ *
+ * @date October 2026
+ */
+
+#include <string.h>
+#include "vlcb.h"
+#include "nv.h"
+#include "event_teach.h"
+#include "module.h"
+#include "scheduler.h"
+#include "hostCosts.h"
+#include "sfrMock.h"
+#include "panelModel.h"
+#include "vlcbMock.h"
+#include "hostNode.h"
+
+void (* txObserver)(const HostFrame * frame);
+
+static HostConfig config;
+static uint8_t configured;
+static uint8_t nvValues[NV_NUM + 1];
+static uint8_t nvSet[NV_NUM + 1];
+static uint8_t running;
+static struct {
+    uint16_t nodeNumber;
+    uint16_t eventNumber;
+    uint8_t evNum;
+    uint8_t evVal;
+} teaching[HOST_MAX_TEACHING];    // EVs taught before power up
+static uint16_t numTeaching;
+static uint32_t loops;
+static uint32_t worstLoopCycles;
+static uint64_t busFreeAt;          // own bus, end of the frame being sent
+static uint8_t busSending;
+
+/**
+ * A blank node, as newly programmed.
+ */
+void hostReset(void) {
+    sfrReset();
+    modelReset();
+    libReset();
+    memset(&config, 0, sizeof(config));
+    config.bitRate = CAN_DEFAULT_BIT_RATE;
+    configured = 0;
+    memset(nvSet, 0, sizeof(nvSet));
+    numTeaching = 0;
+    running = 0;
+    loops = 0;
+    worstLoopCycles = 0;
+    busFreeAt = 0;
+    busSending = 0;
+    txObserver = NULL;
+}
+
+void hostConfigure(const HostConfig * c) {
+    config = *c;
+    configured = 1;
+}
+
+/**
+ * Set an NV. Before power up it is stored as if set on an earlier run,
+ * afterwards it is set as by an NVSET.
+ */
+void hostSetNv(uint8_t index, uint8_t value) {
+    if (index > NV_NUM) {
+        return;
+    }
+    if (running) {
+        setNV(index, value);
+        return;
+    }
+    nvValues[index] = value;
+    nvSet[index] = 1;
+}
+
+/**
+ * Teach an EV, as by an EVLRN. Before power up it is kept until the first
+ * power up factory reset is done, as if taught on an earlier run.
+ * @return 0 or the error, which is CMDERR_TOO_MANY_EVENTS if too many are
+ * kept before power up
+ */
+uint8_t hostTeach(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal) {
+    if (running) {
+        return APP_addEvent(nodeNumber, eventNumber, evNum, evVal, FALSE);
+    }
+    if (numTeaching >= HOST_MAX_TEACHING) {
+        return CMDERR_TOO_MANY_EVENTS;
+    }
+    teaching[numTeaching].nodeNumber = nodeNumber;
+    teaching[numTeaching].eventNumber = eventNumber;
+    teaching[numTeaching].evNum = evNum;
+    teaching[numTeaching].evVal = evVal;
+    numTeaching++;
+    return 0;
+}
+
+/**
+ * Store the configuration and teach the events once the first power up
+ * factory reset is done.
+ */
+static void applyConfig(void) {
+    uint8_t i;
+    uint16_t t;
+
+    if (configured) {
+        libSetEeprom(NN_ADDRESS, config.nodeNumber >> 8);
+        libSetEeprom(NN_ADDRESS + 1, config.nodeNumber & 0xFF);
+        libSetEeprom(MODE_ADDRESS, MODE_NORMAL);
+        libSetEeprom(CANID_ADDRESS, config.canId);
+    }
+    for (i = 1; i <= NV_NUM; i++) {
+        if (nvSet[i]) {
+            libSetEeprom(NV_ADDRESS + i, nvValues[i]);
+        }
+    }
+    for (t = 0; t < numTeaching; t++) {
+        APP_addEvent(teaching[t].nodeNumber, teaching[t].eventNumber, teaching[t].evNum, teaching[t].evVal, FALSE);
+    }
+}
+
+void hostPowerUp(void) {
+    libMain(applyConfig);
+    running = 1;
+}
+
+/**
+ * Send the frames from the TX FIFO on the node's own bus. Each one goes
+ * when it is queued or when the previous one is finished.
+ */
+static void ownBus(void) {
+    const HostFrame * f;
+    uint64_t start;
+
+    if (config.bitRate == 0) {
+        return;
+    }
+    for (;;) {
+        if (busSending) {
+            if (hostCycles() < busFreeAt) {
+                return;
+            }
+            if (txObserver != NULL) {
+                txObserver(canTxHead());
+            }
+            canTxRemove();
+            busSending = 0;
+        }
+        f = canTxHead();
+        if (f == NULL) {
+            return;
+        }
+        start = (f->time > busFreeAt) ? f->time : busFreeAt;
+        busFreeAt = start + canFrameBits(f) * canBitCycles(config.bitRate);
+        busSending = 1;
+    }
+}
+
+/**
+ * The next cycle at which the main loop has something to do.
+ */
+static uint64_t nextDue(uint64_t until) {
+    uint64_t due;
+    uint64_t t;
+    uint8_t i;
+
+    due = until;
+    for (i = 0; i < NUM_TASKS; i++) {
+        t = ((uint64_t)taskStats[i].lastRun.val + tasks[i].period) * CYCLES_PER_TICK;
+        if (t < due) {
+            due = t;
+        }
+    }
+    t = libNextDue();
+    if (t < due) {
+        due = t;
+    }
+    if (busSending && (busFreeAt < due)) {
+        due = busFreeAt;
+    }
+    return due;
+}
+
+/**
+ * Run the main loop until the clock reaches a cycle.
+ */
+void hostRunUntil(uint64_t cycle) {
+    uint64_t start;
+    uint64_t due;
+
+    while (hostCycles() < cycle) {
+        start = hostCycles();
+        libPoll();
+        loop();
+        hostCharge(COST_LOOP);
+        loops++;
+        if (hostCycles() - start > worstLoopCycles) {
+            worstLoopCycles = (uint32_t)(hostCycles() - start);
+        }
+        ownBus();
+        if (! canRxPending()) {
+            due = nextDue(cycle);
+            if (due > hostCycles()) {
+                hostIdleUntil(due);
+                ownBus();
+            }
+        }
+    }
+}
+
+/**
+ * Start measuring the worst loop and interrupt times afresh.
+ */
+void hostClearWorst(void) {
+    worstLoopCycles = 0;
+    sfrStats.worstInterruptCycles = 0;
+}
+
+void hostRunFor(uint64_t cycles) {
+    hostRunUntil(hostCycles() + cycles);
+}
+
+uint64_t hostNow(void) {
+    return hostCycles();
+}
+
+/**
+ * A frame arrives from the bus now.
+ * @return 0 if it was lost because the RX FIFO was full
+ */
+uint8_t hostReceive(const HostFrame * frame) {
+    HostFrame f;
+
+    f = *frame;
+    f.time = hostCycles();
+    return canRxPush(&f);
+}
+
+/**
+ * A message arrives from another node.
+ * @param len the length including the opcode
+ */
+uint8_t hostReceiveMessage(uint8_t len, uint8_t opc, const uint8_t * bytes) {
+    HostFrame f;
+
+    memset(&f, 0, sizeof(f));
+    f.id = 0x57F;
+    f.len = len;
+    f.data[0] = opc;
+    if (len > 1) {
+        memcpy(&f.data[1], bytes, len - 1);
+    }
+    return hostReceive(&f);
+}
+
+void hostSetButton(uint8_t pb, uint8_t down) {
+    modelSetButton(pb, down);
+}
+
+/**
+ * @param led the LED, 1 based
+ * @return as modelLedPlanes()
+ */
+uint8_t hostLedState(uint8_t led) {
+    return modelLedPlanes(led);
+}
+
+void hostGetStats(HostStats * s) {
+    uint8_t chip;
+
+    memset(s, 0, sizeof(*s));
+    s->cycles = sfrStats.cycles;
+    s->idleCycles = sfrStats.idleCycles;
+    s->loops = loops;
+    s->worstLoopCycles = worstLoopCycles;
+    s->functionCalls = sfrStats.functionCalls;
+    s->interrupts = sfrStats.interrupts;
+    s->worstInterruptCycles = sfrStats.worstInterruptCycles;
+    s->missedInterrupts = sfrStats.missedInterrupts;
+    s->spiBytes = sfrStats.spiBytes;
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        s->spiTransactions += maxChips[chip].transactions;
+        s->digitWrites += maxChips[chip].digitWrites;
+        s->redundantWrites += maxChips[chip].redundantWrites;
+        s->framingErrors += maxChips[chip].framingErrors;
+        s->staleLatches += maxChips[chip].staleLatches;
+    }
+    s->isrWithChipSelected = pinConflicts.isrWithChipSelected;
+    s->spiInIsr = pinConflicts.spiInIsr;
+    s->getNvCalls = libStats.getNvCalls;
+    s->getEvsCalls = libStats.getEvsCalls;
+    s->findEventCalls = libStats.findEventCalls;
+    s->eepromWrites = libStats.eepromWrites;
+    s->flashErases = libStats.flashErases;
+    s->flashWrites = libStats.flashWrites;
+    s->messagesSent = libStats.messagesSent;
+    s->messagesReceived = libStats.messagesReceived;
+    s->sendFailures = libStats.sendFailures;
+    s->rxOverruns = libStats.rxOverruns;
+    s->coeOverruns = libStats.coeOverruns;
+}
+
+__attribute__((visibility("default"))) const HostNodeApi hostNodeApi = {
+    hostReset,
+    hostConfigure,
+    hostSetNv,
+    hostTeach,
+    hostPowerUp,
+    hostRunUntil,
+    hostNow,
+    hostReceive,
+    hostSetButton,
+    hostLedState,
+    hostGetStats,
+    canTxHead,
+    canTxRemove,
+    canTxLostArbitration
+};
@@ -0,0 +1,139 @@
+#ifndef _HOSTNODE_H_
+#define _HOSTNODE_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * A CANPANEL node in the host build: the firmware, the library stand in and
+ * the hardware models, run against the virtual clock.
+ *
+ * A node starts blank, as a newly programmed PIC. It may be configured and
+ * taught before hostPowerUp() as though that had been done on an earlier
+ * run. The firmware's own variables are only initialised once per process,
+ * by the C start up, so each process runs a single power up of a node.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+#include "canBus.h"
+
+#define HOST_MAX_TEACHING   1024    // EVs which may be taught before power up
+
+/**
+ * The set up of a node.
+ */
+typedef struct {
+    uint16_t nodeNumber;
+    uint8_t canId;
+    uint32_t bitRate;       // of the node's own bus, 0 if the caller carries the frames
+} HostConfig;
+
+/**
+ * Everything counted since the node was reset.
+ */
+typedef struct {
+    uint64_t cycles;
+    uint64_t idleCycles;
+    uint32_t loops;
+    uint32_t worstLoopCycles;
+    uint32_t functionCalls;
+    uint32_t interrupts;
+    uint32_t worstInterruptCycles;
+    uint32_t missedInterrupts;
+    uint32_t spiBytes;
+    uint32_t spiTransactions;       // 16 bit MAX6951 writes, all chips
+    uint32_t digitWrites;
+    uint32_t redundantWrites;
+    uint32_t framingErrors;
+    uint32_t staleLatches;
+    uint32_t isrWithChipSelected;
+    uint32_t spiInIsr;
+    uint32_t getNvCalls;
+    uint32_t getEvsCalls;
+    uint32_t findEventCalls;
+    uint32_t eepromWrites;
+    uint32_t flashErases;
+    uint32_t flashWrites;
+    uint32_t messagesSent;
+    uint32_t messagesReceived;
+    uint32_t sendFailures;
+    uint32_t rxOverruns;
+    uint32_t coeOverruns;
+} HostStats;
+
+/**
+ * The node's functions, for a simulation of many nodes which loads a copy of
+ * the node as a shared library for each. The library exports only this.
+ */
+typedef struct {
+    void (* reset)(void);
+    void (* configure)(const HostConfig * config);
+    void (* setNv)(uint8_t index, uint8_t value);
+    uint8_t (* teach)(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal);
+    void (* powerUp)(void);
+    void (* runUntil)(uint64_t cycle);
+    uint64_t (* now)(void);
+    uint8_t (* receive)(const HostFrame * frame);
+    void (* setButton)(uint8_t pb, uint8_t down);
+    uint8_t (* ledState)(uint8_t led);
+    void (* getStats)(HostStats * stats);
+    const HostFrame * (* txHead)(void);
+    void (* txRemove)(void);
+    void (* txLostArbitration)(void);
+} HostNodeApi;
+
+#define HOST_NODE_API   "hostNodeApi"
+
+extern const HostNodeApi hostNodeApi;
+
+/*
+ * Called for each frame the node puts on its own bus.
+ */
+extern void (* txObserver)(const HostFrame * frame);
+
+void hostReset(void);
+void hostConfigure(const HostConfig * config);
+void hostSetNv(uint8_t index, uint8_t value);
+uint8_t hostTeach(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal);
+void hostPowerUp(void);
+void hostRunUntil(uint64_t cycle);
+void hostRunFor(uint64_t cycles);
+void hostClearWorst(void);
+uint64_t hostNow(void);
+uint8_t hostReceive(const HostFrame * frame);
+uint8_t hostReceiveMessage(uint8_t len, uint8_t opc, const uint8_t * bytes);
+void hostSetButton(uint8_t pb, uint8_t down);
+uint8_t hostLedState(uint8_t led);
+void hostGetStats(HostStats * stats);
+
+#endif
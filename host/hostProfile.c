@@ -0,0 +1,72 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Reports the profile table kept by profile.c. The numbers are the ones the
+ * firmware measures with Timer 1, which the host build runs from the virtual
+ * clock, so they are the same as would be read from a panel over VLCB.
+ *
+ * @date October 2026
+ */
+
+#include "vlcb.h"
+#include "profile.h"
+#include "hostProfile.h"
+
+#ifdef PROFILE
+
+static const char * const regionNames[NUM_PROFILE_REGIONS] = {
+    "loop", "keyScan", "consumedEvent", "mxCmd", "flashWrite", "keyScanIsr"
+};
+
+/**
+ * Write the table as a JSON object of regions, each with its count and the
+ * total and max Timer 1 counts.
+ */
+void hostProfileJson(FILE * out) {
+    uint8_t r;
+
+    fprintf(out, "{");
+    for (r = 0; r < NUM_PROFILE_REGIONS; r++) {
+        fprintf(out, "%s\"%s\": {\"count\": %u, \"total\": %lu, \"max\": %u}",
+                r ? ", " : "", regionNames[r], profileTable[r].count,
+                (unsigned long)profileTable[r].total, profileTable[r].max);
+    }
+    fprintf(out, "}");
+}
+
+#else
+
+void hostProfileJson(FILE * out) {
+    fprintf(out, "null");
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Replays a CAN log to the node, each frame arriving at the time it was
+ * logged. A log line is a frame in GridConnect form, e.g. :SB020N9001020007;
+ * which may be preceded by a time stamp in seconds or as HH:MM:SS.sss. A
+ * frame without one arrives with the one before, and any other line is
+ * ignored.
+ *
+ * The node's clock is the virtual one, so it sees the log's timing whatever
+ * the speed of the replay. The speed only sets how the replay is paced
+ * against the wall clock: 1 for real time, 10 for ten times as fast, or 0
+ * for as fast as it will go.
+ *
+ * The timeline has a line for each frame received, each frame the node sent,
+ * with its events and responses marked, and each change of an LED, in ms
+ * from the first frame of the log:
+ *
+ *        0.000 rx :SB020N9001020007;
+ *        0.312 led 5 on
+ *
+ * @date October 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "vlcb.h"
+#include "module.h"
+#include "hostCosts.h"
+#include "hostNode.h"
+#include "panelModel.h"
+#include "hostReplay.h"
+
+// time after the last frame for the node to finish what it started
+#define REPLAY_TAIL_MS  1000
+
+static FILE * timeline;
+static uint64_t startCycle;
+
+static void stamp(void) {
+    fprintf(timeline, "%12.3f ", (double)(hostNow() - startCycle) / MS_CYCLES(1));
+}
+
+/**
+ * @return what a sent frame is in the timeline
+ */
+static const char * txKind(uint8_t opc) {
+    switch (opc) {
+        case OPC_ACON:
+        case OPC_ACOF:
+        case OPC_ASON:
+        case OPC_ASOF:
+        case OPC_ACON1:
+        case OPC_ACOF1:
+        case OPC_ASON1:
+        case OPC_ASOF1:
+        case OPC_ACON2:
+        case OPC_ACOF2:
+        case OPC_ASON2:
+        case OPC_ASOF2:
+        case OPC_ACON3:
+        case OPC_ACOF3:
+        case OPC_ASON3:
+        case OPC_ASOF3:
+            return " event";
+        case OPC_ARON:
+        case OPC_AROF:
+        case OPC_ARSON:
+        case OPC_ARSOF:
+        case OPC_ARON1:
+        case OPC_AROF1:
+        case OPC_ARSON1:
+        case OPC_ARSOF1:
+        case OPC_ARON2:
+        case OPC_AROF2:
+        case OPC_ARSON2:
+        case OPC_ARSOF2:
+        case OPC_ARON3:
+        case OPC_AROF3:
+        case OPC_ARSON3:
+        case OPC_ARSOF3:
+            return " response";
+    }
+    return "";
+}
+
+static void frameSent(const HostFrame * frame) {
+    char text[CAN_TEXT_SIZE];
+
+    canFrameText(frame, text);
+    stamp();
+    fprintf(timeline, "tx %s%s\n", text, (frame->len > 0) ? txKind(frame->data[0]) : "");
+}
+
+static void ledChanged(uint8_t led, uint8_t from, uint8_t to) {
+    static const char * const states[4] = {"off", "plane0", "plane1", "on"};
+
+    if (from != to) {
+        stamp();
+        fprintf(timeline, "led %u %s\n", led, states[to]);
+    }
+}
+
+/**
+ * Called before a MAX chip's register is changed, so the LEDs it changes are
+ * found from the planes as they were.
+ */
+static void maxWritten(uint8_t chip, uint8_t reg, uint8_t value) {
+    uint8_t digit;
+    uint8_t bit;
+    uint16_t led;
+    uint8_t planes;
+    uint8_t to;
+
+    if ((reg & 0x60) != 0) {
+        digit = reg & 0x07;
+        for (bit = 0; bit < 8; bit++) {
+            led = chip*64 + digit*8 + bit + 1;
+            planes = modelLedPlanes(led);
+            to = planes;
+            if (reg & 0x20) {
+                to = (uint8_t)((to & ~1) | ((value >> bit) & 1));
+            }
+            if (reg & 0x40) {
+                to = (uint8_t)((to & ~2) | (((value >> bit) & 1) << 1));
+            }
+            ledChanged(led, planes, to);
+        }
+    } else if ((reg == 4) && (value & 0x20)) {
+        // clearing the planes
+        for (bit = 0; bit < 64; bit++) {
+            led = chip*64 + bit + 1;
+            ledChanged(led, modelLedPlanes(led), 0);
+        }
+    }
+}
+
+/**
+ * Read a time stamp, in seconds or as HH:MM:SS.sss.
+ * @return the text after it
+ */
+static const char * parseTime(const char * text, double * seconds) {
+    char * end;
+    double part;
+    double total;
+
+    total = strtod(text, &end);
+    if (end == text) {
+        return text;
+    }
+    while ((*end == ':') && (end[1] != 'S')) {
+        text = end + 1;
+        part = strtod(text, &end);
+        if (end == text) {
+            break;
+        }
+        total = total * 60 + part;
+    }
+    *seconds = total;
+    return end;
+}
+
+/**
+ * Read a line of a log.
+ * @param seconds set to the line's time stamp, if it has one
+ * @return 1 if the line has a frame
+ */
+uint8_t replayParseLine(const char * line, double * seconds, HostFrame * frame) {
+    const char * p;
+
+    while ((*line == ' ') || (*line == '\t')) {
+        line++;
+    }
+    if ((*line >= '0') && (*line <= '9')) {
+        line = parseTime(line, seconds);
+    }
+    p = strstr(line, ":S");
+    if (p == NULL) {
+        return 0;
+    }
+    return canFrameParse(p, frame) != NULL;
+}
+
+static double wallSeconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void sleepUntil(double wall) {
+    struct timespec ts;
+    double wait;
+
+    wait = wall - wallSeconds();
+    if (wait > 0) {
+        ts.tv_sec = (time_t)wait;
+        ts.tv_nsec = (long)((wait - ts.tv_sec) * 1e9);
+        nanosleep(&ts, NULL);
+    }
+}
+
+/**
+ * Replay a log to the node, which must have been powered up.
+ * @param speed the replay's pace against the wall clock, 0 for no pacing
+ * @return the number of frames replayed
+ */
+uint32_t hostReplay(FILE * log, FILE * out, double speed) {
+    char line[256];
+    HostFrame frame;
+    char text[CAN_TEXT_SIZE];
+    double seconds;
+    double first;
+    double last;
+    double wallStart;
+    uint32_t frames;
+
+    timeline = out;
+    txObserver = frameSent;
+    maxWriteObserver = maxWritten;
+    startCycle = hostNow();
+    wallStart = wallSeconds();
+    seconds = 0;
+    first = -1;
+    last = 0;
+    frames = 0;
+    while (fgets(line, sizeof(line), log) != NULL) {
+        if (! replayParseLine(line, &seconds, &frame)) {
+            continue;
+        }
+        if (first < 0) {
+            first = seconds;
+        }
+        // a log going back in time, e.g. past midnight, carries on from where it was
+        if (seconds - first > last) {
+            last = seconds - first;
+        }
+        hostRunUntil(startCycle + (uint64_t)(last * MS_CYCLES(1000)));
+        if (speed > 0) {
+            sleepUntil(wallStart + last / speed);
+        }
+        stamp();
+        canFrameText(&frame, text);
+        if (hostReceive(&frame)) {
+            fprintf(timeline, "rx %s\n", text);
+        } else {
+            fprintf(timeline, "rx %s lost\n", text);
+        }
+        frames++;
+    }
+    hostRunFor(MS_CYCLES(REPLAY_TAIL_MS));
+    txObserver = NULL;
+    maxWriteObserver = NULL;
+    return frames;
+}
@@ -0,0 +1,19 @@
+#ifndef _HOSTREPLAY_H_
+#define _HOSTREPLAY_H_
+
+//LIC
+/**
+ * Replays a log of CAN traffic in GridConnect form to a host build node and
+ * writes a timeline of what the node did.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "canBus.h"
+
+uint8_t replayParseLine(const char * line, double * seconds, HostFrame * frame);
+uint32_t hostReplay(FILE * log, FILE * timeline, double speed);
+
+#endif
@@ -0,0 +1,346 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The simulation's CAN bus. Each frame goes when the bus is free, the lowest
+ * identifier of those waiting winning the arbitration, and occupies the bus
+ * for its stuffed length at the bit rate. It is then put in the RX FIFO of
+ * every other node, or lost if that is full.
+ *
+ * The nodes are run in step, never further ahead than the shortest frame
+ * takes. So a frame queued whilst the bus is idle starts when it was queued,
+ * and it has not finished before every node has caught up, so each node has
+ * it at the time it finishes, as on a real bus.
+ *
+ * Every node's firmware and host build variables are static, so each node
+ * is a copy of the library under a name of its own, as a library loaded
+ * twice from the same file would be shared.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include "hostSim.h"
+
+void (* simFrameObserver)(uint16_t node, const HostFrame * frame, uint64_t start, uint64_t end);
+
+static void * handles[SIM_MAX_NODES];
+static const HostNodeApi * apis[SIM_MAX_NODES];
+static uint16_t numNodes;
+static uint64_t bitCycles;
+static uint64_t stepCycles;         // the shortest frame
+static uint64_t now;
+static uint64_t busFree;            // end of the last frame
+static SimStats stats;
+static SimLoadCurve curve;
+
+static int copyFile(const char * from, const char * to) {
+    char buffer[65536];
+    FILE * in;
+    FILE * out;
+    size_t n;
+    int result;
+
+    in = fopen(from, "rb");
+    if (in == NULL) {
+        return -1;
+    }
+    out = fopen(to, "wb");
+    if (out == NULL) {
+        fclose(in);
+        return -1;
+    }
+    result = 0;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (fwrite(buffer, 1, n, out) != n) {
+            result = -1;
+            break;
+        }
+    }
+    fclose(in);
+    if (fclose(out) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+/**
+ * Load a copy of the node library for each node, and reset them.
+ * @return 0, or -1 with the reason on stderr
+ */
+int simOpen(const char * library, uint16_t nodes, uint32_t bitRate) {
+    char dir[] = "/tmp/panelsimXXXXXX";
+    char path[sizeof(dir) + 16];
+    HostFrame shortest;
+    uint16_t i;
+
+    if (nodes > SIM_MAX_NODES) {
+        fprintf(stderr, "at most %u nodes\n", SIM_MAX_NODES);
+        return -1;
+    }
+    if (mkdtemp(dir) == NULL) {
+        perror(dir);
+        return -1;
+    }
+    numNodes = 0;
+    for (i = 0; i < nodes; i++) {
+        snprintf(path, sizeof(path), "%s/node%u.so", dir, i);
+        if (copyFile(library, path) != 0) {
+            perror(library);
+            break;
+        }
+        handles[i] = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        // the copy is mapped now, so the file isn't needed
+        unlink(path);
+        if (handles[i] == NULL) {
+            fprintf(stderr, "%s\n", dlerror());
+            break;
+        }
+        apis[i] = dlsym(handles[i], HOST_NODE_API);
+        if (apis[i] == NULL) {
+            fprintf(stderr, "%s\n", dlerror());
+            dlclose(handles[i]);
+            break;
+        }
+        apis[i]->reset();
+        numNodes++;
+    }
+    rmdir(dir);
+    if (numNodes < nodes) {
+        simClose();
+        return -1;
+    }
+
+    memset(&shortest, 0, sizeof(shortest));
+    bitCycles = canBitCycles(bitRate);
+    stepCycles = canFrameBits(&shortest) * bitCycles;
+    now = 0;
+    busFree = 0;
+    memset(&stats, 0, sizeof(stats));
+    return 0;
+}
+
+/**
+ * Bring the bus up to the time of the node furthest ahead, once the nodes are
+ * set up. A newly programmed node's first power up formats its flash, and
+ * teaching it writes the flash, which take a node's clock on without the bus.
+ * @return the time
+ */
+uint64_t simSync(void) {
+    uint16_t i;
+
+    for (i = 0; i < numNodes; i++) {
+        if (apis[i]->now() > now) {
+            now = apis[i]->now();
+        }
+    }
+    if (busFree < now) {
+        busFree = now;
+    }
+    return now;
+}
+
+/**
+ * Keep the bus's load over time, from now on, in intervals of bucketCycles.
+ * Frames after the last interval aren't counted.
+ * @return 0, or -1 if there is no memory for it
+ */
+int simLoadCurve(uint64_t bucketCycles, uint32_t buckets) {
+    free(curve.busy);
+    curve.busy = calloc(buckets, sizeof(curve.busy[0]));
+    if (curve.busy == NULL) {
+        curve.buckets = 0;
+        return -1;
+    }
+    curve.start = now;
+    curve.bucketCycles = bucketCycles;
+    curve.buckets = buckets;
+    return 0;
+}
+
+const SimLoadCurve * simGetLoadCurve(void) {
+    return &curve;
+}
+
+/**
+ * Add a frame's time to the intervals it falls in.
+ */
+static void loadCurveFrame(uint64_t start, uint64_t end) {
+    uint64_t bucket;
+    uint64_t bucketEnd;
+
+    if ((curve.buckets == 0) || (start < curve.start)) {
+        return;
+    }
+    start -= curve.start;
+    end -= curve.start;
+    while (start < end) {
+        bucket = start / curve.bucketCycles;
+        if (bucket >= curve.buckets) {
+            return;
+        }
+        bucketEnd = (bucket + 1) * curve.bucketCycles;
+        if (bucketEnd > end) {
+            bucketEnd = end;
+        }
+        curve.busy[bucket] += bucketEnd - start;
+        start = bucketEnd;
+    }
+}
+
+const HostNodeApi * simNode(uint16_t node) {
+    return (node < numNodes) ? apis[node] : NULL;
+}
+
+static void runNodes(uint64_t cycle) {
+    uint16_t i;
+
+    for (i = 0; i < numNodes; i++) {
+        apis[i]->runUntil(cycle);
+    }
+    now = cycle;
+}
+
+/**
+ * Send the frame the arbitration gives the bus to, if any is waiting.
+ * @return 0 if none was
+ */
+static uint8_t sendFrame(void) {
+    const HostFrame * f;
+    uint64_t start;
+    uint64_t end;
+    uint16_t winner;
+    uint16_t i;
+    HostFrame frame;
+
+    // the bus is idle from the end of the last frame until the first one
+    // queued since. Only those queued by now are known, as a node may have
+    // run a little past now.
+    start = UINT64_MAX;
+    for (i = 0; i < numNodes; i++) {
+        f = apis[i]->txHead();
+        if ((f != NULL) && (f->time <= now) && (f->time < start)) {
+            start = f->time;
+        }
+    }
+    if (start == UINT64_MAX) {
+        return 0;
+    }
+    if (start < busFree) {
+        start = busFree;
+    }
+    // of those waiting by then the lowest identifier wins
+    winner = numNodes;
+    for (i = 0; i < numNodes; i++) {
+        f = apis[i]->txHead();
+        if ((f != NULL) && (f->time <= start)) {
+            if ((winner == numNodes) || (f->id < apis[winner]->txHead()->id)) {
+                winner = i;
+            }
+        }
+    }
+    for (i = 0; i < numNodes; i++) {
+        f = apis[i]->txHead();
+        if ((i != winner) && (f != NULL) && (f->time <= start)) {
+            apis[i]->txLostArbitration();
+            stats.arbitrationsLost++;
+        }
+    }
+
+    frame = *apis[winner]->txHead();
+    end = start + canFrameBits(&frame) * bitCycles;
+    busFree = end;
+    runNodes(end);
+    apis[winner]->txRemove();
+    for (i = 0; i < numNodes; i++) {
+        if ((i != winner) && ! apis[i]->receive(&frame)) {
+            stats.rxDrops++;
+        }
+    }
+    stats.frames++;
+    stats.busyCycles += end - start;
+    stats.totalDelay += start - frame.time;
+    if (start - frame.time > stats.worstDelay) {
+        stats.worstDelay = start - frame.time;
+    }
+    loadCurveFrame(start, end);
+    if (simFrameObserver != NULL) {
+        simFrameObserver(winner, &frame, start, end);
+    }
+    return 1;
+}
+
+/**
+ * Run the nodes and the bus until the clock reaches a cycle.
+ */
+void simRunUntil(uint64_t cycle) {
+    uint64_t next;
+
+    while (now < cycle) {
+        if (sendFrame()) {
+            continue;
+        }
+        next = now + stepCycles;
+        runNodes((next < cycle) ? next : cycle);
+    }
+}
+
+uint64_t simNow(void) {
+    return now;
+}
+
+void simGetStats(SimStats * s) {
+    HostStats node;
+    uint16_t i;
+
+    *s = stats;
+    s->txDrops = 0;
+    for (i = 0; i < numNodes; i++) {
+        apis[i]->getStats(&node);
+        s->txDrops += node.sendFailures;
+    }
+}
+
+void simClose(void) {
+    uint16_t i;
+
+    for (i = 0; i < numNodes; i++) {
+        dlclose(handles[i]);
+    }
+    numNodes = 0;
+    free(curve.busy);
+    curve.busy = NULL;
+    curve.buckets = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef _HOSTSIM_H_
+#define _HOSTSIM_H_
+
+//LIC
+/**
+ * A simulation of many CANPANEL nodes in one process, sharing a virtual CAN
+ * bus. Each node is a copy of the host build loaded as a shared library, so
+ * each has its own firmware variables, NVs and event table.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+#include "hostNode.h"
+
+#define SIM_MAX_NODES   128
+
+/**
+ * The bus's counts since simOpen().
+ */
+typedef struct {
+    uint32_t frames;
+    uint64_t busyCycles;
+    uint64_t totalDelay;            // cycles from being queued to starting on the bus, all frames
+    uint64_t worstDelay;
+    uint32_t arbitrationsLost;
+    uint32_t rxDrops;               // frames lost as a node's RX FIFO was full
+    uint32_t txDrops;               // messages lost as a node's TX FIFO was full
+} SimStats;
+
+/*
+ * Called for each frame as it finishes on the bus.
+ */
+extern void (* simFrameObserver)(uint16_t node, const HostFrame * frame, uint64_t start, uint64_t end);
+
+/**
+ * The busy cycles of each interval of the bus's time, set by simLoadCurve().
+ */
+typedef struct {
+    uint64_t start;
+    uint64_t bucketCycles;
+    uint32_t buckets;
+    uint64_t * busy;
+} SimLoadCurve;
+
+int simOpen(const char * library, uint16_t nodes, uint32_t bitRate);
+int simLoadCurve(uint64_t bucketCycles, uint32_t buckets);
+const SimLoadCurve * simGetLoadCurve(void);
+const HostNodeApi * simNode(uint16_t node);
+uint64_t simSync(void);
+void simRunUntil(uint64_t cycle);
+uint64_t simNow(void);
+void simGetStats(SimStats * stats);
+void simClose(void);
+
+#endif
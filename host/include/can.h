@@ -0,0 +1,54 @@
+#ifndef _HOST_CAN_H_
+#define _HOST_CAN_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the VLCB library's CAN service.
+ *
+ * @date October 2026
+ */
+
+#include "vlcb.h"
+
+#define CAN_DIAG_TX_BUFFER_USAGE    0x04
+#define CAN_DIAG_TX_BUFFER_OVERRUN  0x05
+#define CAN_DIAG_TX_MESSAGES        0x06
+#define CAN_DIAG_RX_BUFFER_OVERRUN  0x08
+#define CAN_DIAG_RX_MESSAGES        0x09
+#define CAN_DIAG_LOST_ARBITRATION   0x0C
+#define NUM_CAN_DIAGNOSTICS         16
+
+extern const Service canService;
+extern const Transport canTransport;
+
+#endif
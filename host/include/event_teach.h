@@ -0,0 +1,63 @@
+#ifndef _HOST_EVENT_TEACH_H_
+#define _HOST_EVENT_TEACH_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the VLCB library's event teach service. The event
+ * table is kept in the flash image of vlcbMock.c in the same layout as the
+ * library's event_teach_large.
+ *
+ * @date October 2026
+ */
+
+#include "vlcb.h"
+
+extern const Service eventTeachService;
+extern uint8_t evs[EVperEVT];
+
+extern int16_t getEv(uint8_t tableIndex, uint8_t evIndex);
+extern uint8_t getEVs(uint8_t tableIndex);
+extern uint8_t writeEv(uint8_t tableIndex, uint8_t evNum, uint8_t evVal);
+extern uint16_t getNN(uint8_t tableIndex);
+extern uint16_t getEN(uint8_t tableIndex);
+extern uint8_t findEvent(uint16_t nodeNumber, uint16_t eventNumber);
+extern uint8_t addEvent(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal, Boolean forceOwnNN);
+extern uint8_t removeEvent(uint16_t nodeNumber, uint16_t eventNumber);
+extern void rebuildHashtable(void);
+extern void checkRemoveTableEntry(uint8_t tableIndex);
+extern Boolean validStart(uint8_t tableIndex);
+
+// Provided by the application
+extern uint8_t APP_addEvent(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal, Boolean forceOwnNN);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef _HOST_TICKTIME_H_
+#define _HOST_TICKTIME_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the VLCB library's ticktime.h. A tick is 16us, 
+ * 256 instruction cycles.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+
+#define ONE_SECOND          62500
+#define HALF_SECOND         (ONE_SECOND/2)
+#define TWO_SECOND          (ONE_SECOND*2)
+#define HUNDRED_MILI_SECOND (ONE_SECOND/10)
+#define TWENTY_MILI_SECOND  (ONE_SECOND/50)
+#define TEN_MILI_SECOND     (ONE_SECOND/100)
+#define ONE_MILI_SECOND     (ONE_SECOND/1000)
+
+#define tickTimeSince(t)    (tickGet() - (t).val)
+
+typedef union _TickValue {
+    uint32_t val;
+    struct TickBytes {
+        uint8_t b0, b1, b2, b3;
+    } byte;
+    uint8_t v[4];
+    struct TickWords {
+        uint16_t w0, w1;
+    } word;
+} TickValue;
+
+extern uint32_t tickGet(void);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef _HOST_TIMEDRESPONSE_H_
+#define _HOST_TIMEDRESPONSE_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the VLCB library's timed response.
+ *
+ * @date October 2026
+ */
+
+#include "vlcb.h"
+
+typedef enum {
+    TIMED_RESPONSE_RESULT_FINISHED,
+    TIMED_RESPONSE_RESULT_RETRY,
+    TIMED_RESPONSE_RESULT_NEXT
+} TimedResponseResult;
+
+#define TIMED_RESPONSE_NONE     0xFF
+#define TIMED_RESPONSE_NERD     2
+#define TIMED_RESPONSE_RQSD     3
+#define TIMED_RESPONSE_RDGN     4
+#define TIMED_RESPONSE_NVRD     6
+#define TIMED_RESPONSE_SOD      9
+
+extern void startTimedResponse(uint8_t type, uint8_t serviceIndex, TimedResponseResult (*callback)(uint8_t type, uint8_t serviceIndex, uint8_t step));
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef _HOST_VLCB_H_
+#define _HOST_VLCB_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the VLCB library's vlcb.h. Only what the CANPANEL
+ * code uses is declared, with the same names and types as the library. The
+ * behaviour is provided by vlcbMock.c.
+ *
+ * @date October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "module.h"
+#include "vlcbdefs_enums.h"
+#include "nvm.h"
+
+typedef enum Priority { pLOW=0, pNORMAL=1, pABOVE=2, pHIGH=3 } Priority;
+typedef enum Boolean { FALSE, TRUE } Boolean;
+typedef enum Result { RESULT_FAIL, RESULT_SUCCESS } Result;
+
+typedef struct Message {
+    uint8_t len;
+    VlcbOpCodes opc;
+    uint8_t bytes[7];
+} Message;
+
+typedef union Word {
+    struct {
+        uint8_t lo;
+        uint8_t hi;
+    } bytes;
+    uint16_t word;
+} Word;
+
+typedef enum { EVENT_UNKNOWN=255, EVENT_OFF=0, EVENT_ON=1 } EventState;
+
+typedef union DiagnosticVal {
+    uint16_t asUint;
+    int16_t asInt;
+    struct {
+        uint8_t lo;
+        uint8_t hi;
+    } asBytes;
+} DiagnosticVal;
+
+typedef enum Processed { NOT_PROCESSED=0, PROCESSED=1 } Processed;
+
+#define EVENT_ON_MASK   1
+#define NO_INDEX        0xFF
+
+typedef struct Service {
+    uint8_t serviceNo;
+    uint8_t version;
+    void (* factoryReset)(void);
+    void (* powerUp)(void);
+    Processed (* processMessage)(Message * m);
+    void (* poll)(void);
+    uint8_t (* getESDdata)(uint8_t id);
+    DiagnosticVal * (* getDiagnostic)(uint8_t index);
+} Service;
+
+typedef enum ServicePresent { NOT_PRESENT=0, PRESENT=1 } ServicePresent;
+typedef enum MessageReceived { NOT_RECEIVED=0, RECEIVED=1 } MessageReceived;
+typedef enum SendResult { SEND_FAILED=0, SEND_OK } SendResult;
+
+typedef struct Transport {
+    SendResult (* sendMessage)(Message * m);
+    MessageReceived (* receiveMessage)(Message * m);
+} Transport;
+
+extern const Priority priorities[256];
+extern const Service * const services[];
+extern const Transport * transport;
+
+extern Processed checkLen(Message * m, uint8_t needed, uint8_t service);
+extern Boolean isEvent(uint8_t opc);
+extern void setTimedResponseDelay(uint8_t delay);
+extern const Service * findService(uint8_t id);
+extern ServicePresent have(uint8_t id);
+extern uint8_t findServiceIndex(uint8_t id);
+extern void factoryReset(void);
+
+extern void sendMessage0(VlcbOpCodes opc);
+extern void sendMessage1(VlcbOpCodes opc, uint8_t data1);
+extern void sendMessage2(VlcbOpCodes opc, uint8_t data1, uint8_t data2);
+extern void sendMessage3(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3);
+extern void sendMessage4(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4);
+extern void sendMessage5(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5);
+extern void sendMessage6(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6);
+extern void sendMessage7(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6, uint8_t data7);
+
+// Provided by the application
+extern void APP_factoryReset(void);
+extern void setup(void);
+extern void loop(void);
+extern Processed APP_preProcessMessage(Message * m);
+extern Processed APP_postProcessMessage(Message * m);
+
+#endif
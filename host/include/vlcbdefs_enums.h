@@ -0,0 +1,597 @@
+#ifndef _HOST_VLCBDEFS_ENUMS_H_
+#define _HOST_VLCBDEFS_ENUMS_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The VLCB protocol definitions used by the host build, as in the VLCB
+ * library's vlcbdefs_enums.h.
+ *
+ * @date October 2026
+ */
+
+typedef enum VlcbManufacturer
+{
+  MANU_DEV = 13,
+  MANU_MERG = 165,
+  MANU_SPROG = 44,
+  MANU_ROCRAIL = 70,
+  MANU_SPECTRUM = 80,
+  MANU_MERG_VLCB = 250,
+  MANU_VLCB = 250,
+  MANU_SYSPIXIE = 249,
+  MANU_RME = 248,
+} VlcbManufacturer;
+
+typedef enum VlcbMergModuleTypes
+{
+  MTYP_SLIM = 0,
+  MTYP_CANACC4 = 1,
+  MTYP_CANACC5 = 2,
+  MTYP_CANACC8 = 3,
+  MTYP_CANACE3 = 4,
+  MTYP_CANACE8C = 5,
+  MTYP_CANLED = 6,
+  MTYP_CANLED64 = 7,
+  MTYP_CANACC4_2 = 8,
+  MTYP_CANCAB = 9,
+  MTYP_CANCMD = 10,
+  MTYP_CANSERVO = 11,
+  MTYP_CANBC = 12,
+  MTYP_CANRPI = 13,
+  MTYP_CANTTCA = 14,
+  MTYP_CANTTCB = 15,
+  MTYP_CANHS = 16,
+  MTYP_CANTOTI = 17,
+  MTYP_CAN8I8O = 18,
+  MTYP_CANSERVO8C = 19,
+  MTYP_CANRFID = 20,
+  MTYP_CANTC4 = 21,
+  MTYP_CANACE16C = 22,
+  MTYP_CANIO8 = 23,
+  MTYP_CANSNDX = 24,
+  MTYP_CANEther = 25,
+  MTYP_CANSIG64 = 26,
+  MTYP_CANSIG8 = 27,
+  MTYP_CANCOND8C = 28,
+  MTYP_CANPAN = 29,
+  MTYP_CANACE3C = 30,
+  MTYP_CANPanel = 31,
+  MTYP_CANMIO = 32,
+  MTYP_CANACE8MIO = 33,
+  MTYP_CANSOL = 34,
+  MTYP_CANBIP = 35,
+  MTYP_CANCDU = 36,
+  MTYP_CANACC4CDU = 37,
+  MTYP_CANWiBase = 38,
+  MTYP_WiCAB = 39,
+  MTYP_CANWiFi = 40,
+  MTYP_CANFTT = 41,
+  MTYP_CANHNDST = 42,
+  MTYP_CANTCHNDST = 43,
+  MTYP_CANRFID8 = 44,
+  MTYP_CANmchRFID = 45,
+  MTYP_CANPiWi = 46,
+  MTYP_CAN4DC = 47,
+  MTYP_CANELEV = 48,
+  MTYP_CANSCAN = 49,
+  MTYP_CANMIO_SVO = 50,
+  MTYP_CANMIO_INP = 51,
+  MTYP_CANMIO_OUT = 52,
+  MTYP_CANBIP_OUT = 53,
+  MTYP_CANASTOP = 54,
+  MTYP_CANCSB = 55,
+  MTYP_CANMAG = 56,
+  MTYP_CANACE16CMIO = 57,
+  MTYP_CANPiNODE = 58,
+  MTYP_CANDISP = 59,
+  MTYP_CANCOMPUTE = 60,
+  MTYP_CANRC522 = 61,
+  MTYP_CANINP = 62,
+  MTYP_CANOUT = 63,
+  MTYP_CANXIO = 64,
+  MTYP_CANCABDC = 65,
+  MTYP_CANRCOM = 66,
+  MTYP_CANMP3 = 67,
+  MTYP_CANXMAS = 68,
+  MTYP_CANSVOSET = 69,
+  MTYP_CANCMDDC = 70,
+  MTYP_CANTEXT = 71,
+  MTYP_CANASIGNAL = 72,
+  MTYP_CANSLIDER = 73,
+  MTYP_CANDCATC = 74,
+  MTYP_CANGATE = 75,
+  MTYP_CANSINP = 76,
+  MTYP_CANSOUT = 77,
+  MTYP_CANSBIP = 78,
+  MTYP_CANBUFFER = 79,
+  MTYP_CANLEVER = 80,
+  MTYP_CANSHIELD = 81,
+  MTYP_CAN4IN4OUT = 82,
+  MTYP_CANCMDB = 83,
+  MTYP_CANPIXEL = 84,
+  MTYP_CANCABPE = 85,
+  MTYP_CANSMARTTD = 86,
+  MTYP_VLCB = 0xFC,
+
+  MTYP_CAN_SW = 0xFF,
+  MTYP_EMPTY = 0xFE,
+  MTYP_CANUSB = 0xFD,
+  MTYP_CANDEV = 0xFC,
+} VlcbMergModuleTypes;
+
+typedef enum VlcbSprogModuleTypes
+{
+  MTYP_CANPiSPRG3 = 1,
+  MTYP_CANSPROG3P = 2,
+  MTYP_CANSPROG = 3,
+  MTYP_CANSBOOST = 4,
+  MTYP_CANPiSPRGP = 5,
+  MTYP_CANSOLNOID = 8,
+  MTYP_CANSERVOIO = 50,
+  MTYP_CANISB = 100,
+  MTYP_CANSOLIO = 101,
+} VlcbSprogModuleTypes;
+
+typedef enum VlcbRocRailModuleTypes
+{
+  MTYP_CANGC1 = 1,
+  MTYP_CANGC2 = 2,
+  MTYP_CANGC3 = 3,
+  MTYP_CANGC4 = 4,
+  MTYP_CANGC5 = 5,
+  MTYP_CANGC6 = 6,
+  MTYP_CANGC7 = 7,
+  MTYP_CANGC1e = 11,
+} VlcbRocRailModuleTypes;
+
+typedef enum VlcbSpectrumModuleTypes
+{
+  MTYP_AMCTRLR = 1,
+  MTYP_DUALCAB = 2,
+} VlcbSpectrumModuleTypes;
+
+typedef enum VlcbSysPixieModuleTypes
+{
+  MTYP_CANPMSense = 1,
+} VlcbSysPixieModuleTypes;
+
+typedef enum VlcbOpCodes
+{
+  OPC_ACK = 0x00,
+  OPC_NAK = 0x01,
+  OPC_HLT = 0x02,
+  OPC_BON = 0x03,
+  OPC_TOF = 0x04,
+  OPC_TON = 0x05,
+  OPC_ESTOP = 0x06,
+  OPC_ARST = 0x07,
+  OPC_RTOF = 0x08,
+  OPC_RTON = 0x09,
+  OPC_RESTP = 0x0a,
+  OPC_RSTAT = 0x0c,
+  OPC_QNN = 0x0d,
+
+  OPC_RQNP = 0x10,
+  OPC_RQMN = 0x11,
+
+  OPC_KLOC = 0x21,
+  OPC_QLOC = 0x22,
+  OPC_DKEEP = 0x23,
+
+  OPC_DBG1 = 0x30,
+  OPC_EXTC = 0x3F,
+
+  OPC_RLOC = 0x40,
+  OPC_QCON = 0x41,
+  OPC_SNN = 0x42,
+  OPC_ALOC = 0X43,
+
+  OPC_STMOD = 0x44,
+  OPC_PCON = 0x45,
+  OPC_KCON = 0x46,
+  OPC_DSPD = 0x47,
+  OPC_DFLG = 0x48,
+  OPC_DFNON = 0x49,
+  OPC_DFNOF = 0x4A,
+  OPC_SSTAT = 0x4C,
+  OPC_NNRSM = 0x4F,
+
+  OPC_RQNN = 0x50,
+  OPC_NNREL = 0x51,
+  OPC_NNACK = 0x52,
+  OPC_NNLRN = 0x53,
+  OPC_NNULN = 0x54,
+  OPC_NNCLR = 0x55,
+  OPC_NNEVN = 0x56,
+  OPC_NERD = 0x57,
+  OPC_RQEVN = 0x58,
+  OPC_WRACK = 0x59,
+  OPC_RQDAT = 0x5A,
+  OPC_RQDDS = 0x5B,
+  OPC_BOOT = 0x5C,
+  OPC_ENUM = 0x5D,
+  OPC_NNRST = 0x5E,
+  OPC_EXTC1 = 0x5F,
+
+  OPC_DFUN = 0x60,
+  OPC_GLOC = 0x61,
+  OPC_ERR = 0x63,
+  OPC_CMDERR = 0x6F,
+
+  OPC_EVNLF = 0x70,
+  OPC_NVRD = 0x71,
+  OPC_NENRD = 0x72,
+  OPC_RQNPN = 0x73,
+  OPC_NUMEV = 0x74,
+  OPC_CANID = 0x75,
+  OPC_MODE = 0x76,
+  OPC_RQSD = 0x78,
+  OPC_EXTC2 = 0x7F,
+
+  OPC_RDCC3 = 0x80,
+  OPC_WCVO = 0x82,
+  OPC_WCVB = 0x83,
+  OPC_QCVS = 0x84,
+  OPC_PCVS = 0x85,
+  OPC_RDGN = 0x87,
+  OPC_NVSETRD = 0x8E,
+
+  OPC_ACON = 0x90,
+  OPC_ACOF = 0x91,
+  OPC_AREQ = 0x92,
+  OPC_ARON = 0x93,
+  OPC_AROF = 0x94,
+  OPC_EVULN = 0x95,
+  OPC_NVSET = 0x96,
+  OPC_NVANS = 0x97,
+  OPC_ASON = 0x98,
+  OPC_ASOF = 0x99,
+  OPC_ASRQ = 0x9A,
+  OPC_PARAN = 0x9B,
+  OPC_REVAL = 0x9C,
+  OPC_ARSON = 0x9D,
+  OPC_ARSOF = 0x9E,
+  OPC_EXTC3 = 0x9F,
+
+  OPC_RDCC4 = 0xA0,
+  OPC_WCVS = 0xA2,
+  OPC_HEARTB = 0xAB,
+  OPC_SD = 0xAC,
+  OPC_GRSP = 0xAF,
+
+  OPC_ACON1 = 0xB0,
+  OPC_ACOF1 = 0xB1,
+  OPC_REQEV = 0xB2,
+  OPC_ARON1 = 0xB3,
+  OPC_AROF1 = 0xB4,
+  OPC_NEVAL = 0xB5,
+  OPC_PNN = 0xB6,
+  OPC_ASON1 = 0xB8,
+  OPC_ASOF1 = 0xB9,
+  OPC_ARSON1 = 0xBD,
+  OPC_ARSOF1 = 0xBE,
+  OPC_EXTC4 = 0xBF,
+
+  OPC_RDCC5 = 0xC0,
+  OPC_WCVOA = 0xC1,
+  OPC_CABDAT = 0xC2,
+  OPC_DGN = 0xC7,
+  OPC_FCLK = 0xCF,
+
+  OPC_ACON2 = 0xD0,
+  OPC_ACOF2 = 0xD1,
+  OPC_EVLRN = 0xd2,
+  OPC_EVANS = 0xd3,
+  OPC_ARON2 = 0xD4,
+  OPC_AROF2 = 0xD5,
+  OPC_ASON2 = 0xD8,
+  OPC_ASOF2 = 0xD9,
+  OPC_ARSON2 = 0xDD,
+  OPC_ARSOF2 = 0xDE,
+  OPC_EXTC5 = 0xDF,
+
+  OPC_RDCC6 = 0xE0,
+  OPC_PLOC = 0xE1,
+  OPC_NAME = 0xE2,
+  OPC_STAT = 0xE3,
+  OPC_ENACK = 0xE6,
+  OPC_ESD = 0xE7,
+  OPC_DTXC = 0xE9,
+  OPC_PARAMS = 0xEF,
+
+  OPC_ACON3 = 0xF0,
+  OPC_ACOF3 = 0xF1,
+  OPC_ENRSP = 0xF2,
+  OPC_ARON3 = 0xF3,
+  OPC_AROF3 = 0xF4,
+  OPC_EVLRNI = 0xF5,
+  OPC_ACDAT = 0xF6,
+  OPC_ARDAT = 0xF7,
+  OPC_ASON3 = 0xF8,
+  OPC_ASOF3 = 0xF9,
+  OPC_DDES = 0xFA,
+  OPC_DDRS = 0xFB,
+  OPC_DDWS = 0xFC,
+  OPC_ARSON3 = 0xFD,
+  OPC_ARSOF3 = 0xFE,
+  OPC_EXTC6 = 0xFF,
+
+  OPC_VCVS = 0xA4,
+} VlcbOpCodes;
+
+typedef enum VlcbStmodModes
+{
+  TMOD_SPD_MASK = 3,
+  TMOD_SPD_128 = 0,
+  TMOD_SPD_14 = 1,
+  TMOD_SPD_28I = 2,
+  TMOD_SPD_28 = 3,
+} VlcbStmodModes;
+
+typedef enum VlcbErrs
+{
+  ERR_LOCO_STACK_FULL = 1,
+  ERR_LOCO_ADDR_TAKEN = 2,
+  ERR_SESSION_NOT_PRESENT = 3,
+  ERR_CONSIST_EMPTY = 4,
+  ERR_LOCO_NOT_FOUND = 5,
+  ERR_CMD_RX_BUF_OFLOW = 6,
+  ERR_INVALID_REQUEST = 7,
+  ERR_SESSION_CANCELLED = 8,
+} VlcbErrs;
+
+typedef enum VlcbSStats
+{
+  SSTAT_NO_ACK = 1,
+  SSTAT_OVLD = 2,
+  SSTAT_WR_ACK = 3,
+  SSTAT_BUSY = 4,
+  SSTAT_CV_ERROR = 5,
+} VlcbSStats;
+
+typedef enum VlcbCmdErrs
+{
+  CMDERR_INV_CMD = 1,
+  CMDERR_NOT_LRN = 2,
+  CMDERR_NOT_SETUP = 3,
+  CMDERR_TOO_MANY_EVENTS = 4,
+  CMDERR_NO_EV = 5,
+  CMDERR_INV_EV_IDX = 6,
+  CMDERR_INVALID_EVENT = 7,
+  CMDERR_INV_EN_IDX = 8,
+  CMDERR_INV_PARAM_IDX = 9,
+  CMDERR_INV_NV_IDX = 10,
+  CMDERR_INV_EV_VALUE = 11,
+  CMDERR_INV_NV_VALUE = 12,
+
+  CMDERR_LRN_OTHER = 13,
+
+} VlcbCmdErrs;
+
+typedef enum VlcbGrspCodes
+{
+  GRSP_OK = 0,
+  GRSP_UNKNOWN_NVM_TYPE = 254,
+  GRSP_INVALID_DIAGNOSTIC = 253,
+  GRSP_INVALID_SERVICE = 252,
+  GRSP_INVALID_COMMAND_PARAMETER = 251,
+  GRSP_INVALID_MODE = 250,
+} VlcbGrspCodes;
+
+typedef enum VlcbCabSigAspect0
+{
+  CDAT_CABSIG = 1,
+} VlcbCabSigAspect0;
+
+typedef enum VlcbCabSigAspect1
+{
+  SASP_DANGER = 0,
+  SASP_CAUTION = 1,
+  SASP_PRELIM_CAUTION = 2,
+  SASP_PROCEED = 3,
+  SASP_CALLON = 4,
+  SASP_THEATRE = 8,
+} VlcbCabSigAspect1;
+
+typedef enum VlcbCabSigAspect2
+{
+  SASP_LIT = 0,
+  SASP_LUNAR = 1,
+
+} VlcbCabSigAspect2;
+
+typedef enum VlcbServiceTypes
+{
+  SERVICE_ID_NONE = 0,
+  SERVICE_ID_MNS = 1,
+  SERVICE_ID_NV = 2,
+  SERVICE_ID_CAN = 3,
+  SERVICE_ID_OLD_TEACH = 4,
+  SERVICE_ID_PRODUCER = 5,
+  SERVICE_ID_CONSUMER = 6,
+  SERVICE_ID_TEACH = 7,
+  SERVICE_ID_CONSUME_OWN_EVENTS = 8,
+  SERVICE_ID_EVENTACK = 9,
+  SERVICE_ID_BOOT = 10,
+  SERVICE_ID_STREAMING = 17,
+
+} VlcbServiceTypes;
+
+typedef enum VlcbParams
+{
+  PAR_NUM = 0,
+  PAR_MANU = 1,
+  PAR_MINVER = 2,
+  PAR_MTYP = 3,
+  PAR_EVTNUM = 4,
+  PAR_EVNUM = 5,
+  PAR_NVNUM = 6,
+  PAR_MAJVER = 7,
+  PAR_FLAGS = 8,
+  PAR_CPUID = 9,
+  PAR_BUSTYPE = 10,
+  PAR_LOAD = 11,
+  PAR_CPUMID = 15,
+  PAR_CPUMAN = 19,
+  PAR_BETA = 20,
+} VlcbParams;
+
+typedef enum VlcbParamOffsetsPic
+{
+  PAR_COUNT = 0x18,
+  PAR_NAME = 0x1A,
+  PAR_CKSUM = 0x1E,
+} VlcbParamOffsetsPic;
+
+typedef enum VlcbParamFlags
+{
+  PF_NOEVENTS = 0,
+  PF_CONSUMER = 1,
+  PF_PRODUCER = 2,
+  PF_COMBI = 3,
+  PF_FLiM = 4,
+  PF_NORMAL = 4,
+  PF_BOOT = 8,
+  PF_COE = 16,
+  PF_LRN = 32,
+  PF_VLCB = 64,
+  PF_SD = 64,
+} VlcbParamFlags;
+
+typedef enum VlcbModeParams
+{
+  MODE_UNINITIALISED = 0xFF,
+  MODE_SETUP = 0,
+  MODE_NORMAL = 1,
+
+  MODE_LEARN_ON = 0x08,
+  MODE_LEARN_OFF = 0x09,
+
+  MODE_EVENT_ACK_ON = 0x0A,
+  MODE_EVENT_ACK_OFF = 0x0B,
+
+  MODE_HEARTBEAT_ON = 0x0C,
+  MODE_HEARTBEAT_OFF = 0x0D,
+
+  MODE_BOOT = 0x0E,
+} VlcbModeParams;
+
+typedef enum VlcbBusTypes
+{
+  PB_CAN = 1,
+  PB_ETH = 2,
+  PB_MIWI = 3,
+  PB_USB = 4,
+} VlcbBusTypes;
+
+typedef enum VlcbProcessorManufacturers
+{
+  CPUM_MICROCHIP = 1,
+  CPUM_ATMEL = 2,
+  CPUM_ARM = 3,
+} VlcbProcessorManufacturers;
+
+typedef enum VlcbMicrochipProcessors
+{
+  P18F2480 = 1,
+  P18F4480 = 2,
+  P18F2580 = 3,
+  P18F4580 = 4,
+  P18F2585 = 5,
+  P18F4585 = 6,
+  P18F2680 = 7,
+  P18F4680 = 8,
+  P18F2682 = 9,
+  P18F4682 = 10,
+  P18F2685 = 11,
+  P18F4685 = 12,
+
+  P18F25K80 = 13,
+  P18F45K80 = 14,
+  P18F26K80 = 15,
+  P18F46K80 = 16,
+  P18F65K80 = 17,
+  P18F66K80 = 18,
+  P18F25K83 = 19,
+  P18F26K83 = 20,
+  P18F27Q84 = 21,
+  P18F47Q84 = 22,
+  P18F27Q83 = 23,
+  P18F14K22 = 25,
+
+  P32MX534F064 = 30,
+  P32MX564F064 = 31,
+  P32MX564F128 = 32,
+  P32MX575F256 = 33,
+  P32MX575F512 = 34,
+  P32MX764F128 = 35,
+  P32MX775F256 = 36,
+  P32MX775F512 = 37,
+  P32MX795F512 = 38,
+} VlcbMicrochipProcessors;
+
+typedef enum VlcbArmProcessors
+{
+  ARM1176JZF_S = 1,
+  ARMCortex_A7 = 2,
+  ARMCortex_A53 = 3,
+} VlcbArmProcessors;
+
+typedef enum VlcbCanHardware
+{
+  CAN_HW_NOT_SPECIFIED = 0x00,
+  CAN_HW_PIC_ECAN = 0x01,
+  CAN_HW_PIC_CAN_2_0 = 0x02,
+  CAN_HW_PIC_CAN_FD = 0x03,
+  CAN_HW_MCP2515 = 0x04,
+  CAN_HW_MCP2518 = 0x05,
+  CAN_HW_ESP32_TWAI = 0x06,
+  CAN_HW_SAM3X8E = 0x07,
+  CAN_HW_PICO_PIO = 0x08,
+} VlcbCanHardware;
+
+typedef enum VlcbProducerEvUsage
+{
+  PRODUCER_EV_NOT_SPECIFIED = 0x00,
+  PRODUCER_EV_HAPPENING = 0x01,
+  PRODUCER_EV_SLOTS = 0x02,
+} VlcbProducerEvUsage;
+
+typedef enum VlcbConsumerEvUsage
+{
+  CONSUMER_EV_NOT_SPECIFIED = 0x00,
+  CONSUMER_EV_ACTIONS = 0x01,
+  CONSUMER_EV_SLOTS = 0x02,
+} VlcbConsumerEvUsage;
+
+#endif
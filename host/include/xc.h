@@ -0,0 +1,159 @@
+#ifndef _HOST_XC_H_
+#define _HOST_XC_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Host build stand in for the XC8 device header of the PIC18F27Q83.
+ *
+ * Only the registers used by the CANPANEL code are provided. Each access to
+ * one of them goes through hostSfr(), which lets the models in sfrMock.c see
+ * what the previous access wrote, advance the virtual clock and take the
+ * key scan interrupt, then returns where the value is kept. The bits
+ * structures are views of the same byte. The layout of the bits which the
+ * firmware names is as on the PIC, the rest of each register isn't modelled.
+ *
+ * SPI1TXB is kept in 16 bits so a write can be told from the previous one:
+ * the mock sets it to HOST_SPI_IDLE once the byte has been sent.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+
+typedef uint32_t uint24_t;
+typedef int32_t int24_t;
+
+#define _18FXXQ83_FAMILY_
+#define __18F27Q83
+
+// The registers behind hostSfr()
+enum {
+    SFR_LATA, SFR_LATB, SFR_LATC,
+    SFR_PORTA, SFR_PORTB, SFR_PORTC,
+    SFR_TRISA, SFR_TRISB, SFR_TRISC,
+    SFR_ANSELA, SFR_ANSELB, SFR_ANSELC,
+    SFR_WPUA, SFR_WPUB, SFR_WPUC,
+    SFR_RC3PPS, SFR_RC5PPS, SFR_RC6PPS,
+    SFR_SPI1CON0, SFR_SPI1CON1, SFR_SPI1CON2, SFR_SPI1CLK, SFR_SPI1BAUD,
+    SFR_OSCFRQ,
+    SFR_T1CON, SFR_T1CLK,
+    SFR_T2CON, SFR_T2CLKCON, SFR_T2HLT, SFR_T2PR, SFR_T2TMR,
+    SFR_PIR3, SFR_PIE3, SFR_IPR3,
+    SFR_INTCON0,
+    NUM_SFRS
+};
+
+#define HOST_SPI_IDLE   0xFFFF
+
+extern volatile uint8_t * hostSfr(uint8_t sfr);
+extern volatile uint16_t * hostSpiTxb(void);
+extern volatile uint16_t * hostTmr1(void);
+extern void hostNop(void);
+
+typedef struct { uint8_t LATA0:1, LATA1:1, LATA2:1, LATA3:1, LATA4:1, LATA5:1, LATA6:1, LATA7:1; } LATAbits_t;
+typedef struct { uint8_t LATB0:1, LATB1:1, LATB2:1, LATB3:1, LATB4:1, LATB5:1, LATB6:1, LATB7:1; } LATBbits_t;
+typedef struct { uint8_t LATC0:1, LATC1:1, LATC2:1, LATC3:1, LATC4:1, LATC5:1, LATC6:1, LATC7:1; } LATCbits_t;
+typedef struct { uint8_t RA0:1, RA1:1, RA2:1, RA3:1, RA4:1, RA5:1, RA6:1, RA7:1; } PORTAbits_t;
+typedef struct { uint8_t RB0:1, RB1:1, RB2:1, RB3:1, RB4:1, RB5:1, RB6:1, RB7:1; } PORTBbits_t;
+typedef struct { uint8_t RC0:1, RC1:1, RC2:1, RC3:1, RC4:1, RC5:1, RC6:1, RC7:1; } PORTCbits_t;
+typedef struct { uint8_t TRISA0:1, TRISA1:1, TRISA2:1, TRISA3:1, TRISA4:1, TRISA5:1, TRISA6:1, TRISA7:1; } TRISAbits_t;
+typedef struct { uint8_t TRISB0:1, TRISB1:1, TRISB2:1, TRISB3:1, TRISB4:1, TRISB5:1, TRISB6:1, TRISB7:1; } TRISBbits_t;
+typedef struct { uint8_t TRISC0:1, TRISC1:1, TRISC2:1, TRISC3:1, TRISC4:1, TRISC5:1, TRISC6:1, TRISC7:1; } TRISCbits_t;
+typedef struct { uint8_t BMODE:1, MST:1, LSBF:1, :4, EN:1; } SPI1CON0bits_t;
+typedef struct { uint8_t RXR:1, TXR:1, :5, BUSY:1; } SPI1CON2bits_t;
+typedef struct { uint8_t HFFRQ:4, :4; } OSCFRQbits_t;
+typedef struct { uint8_t ON:1, RD16:1, SYNC:1, :1, CKPS:2, :2; } T1CONbits_t;
+typedef struct { uint8_t OUTPS:4, CKPS:3, ON:1; } T2CONbits_t;
+typedef struct { uint8_t :3, TMR2IF:1, TMR1IF:1, :3; } PIR3bits_t;
+typedef struct { uint8_t :3, TMR2IE:1, TMR1IE:1, :3; } PIE3bits_t;
+typedef struct { uint8_t :3, TMR2IP:1, TMR1IP:1, :3; } IPR3bits_t;
+typedef struct { uint8_t :5, IPEN:1, GIEL:1, GIE:1; } INTCON0bits_t;
+
+#define LATA            (*hostSfr(SFR_LATA))
+#define LATB            (*hostSfr(SFR_LATB))
+#define LATC            (*hostSfr(SFR_LATC))
+#define PORTA           (*hostSfr(SFR_PORTA))
+#define PORTB           (*hostSfr(SFR_PORTB))
+#define PORTC           (*hostSfr(SFR_PORTC))
+#define TRISA           (*hostSfr(SFR_TRISA))
+#define TRISB           (*hostSfr(SFR_TRISB))
+#define TRISC           (*hostSfr(SFR_TRISC))
+#define ANSELA          (*hostSfr(SFR_ANSELA))
+#define ANSELB          (*hostSfr(SFR_ANSELB))
+#define ANSELC          (*hostSfr(SFR_ANSELC))
+#define WPUA            (*hostSfr(SFR_WPUA))
+#define WPUB            (*hostSfr(SFR_WPUB))
+#define WPUC            (*hostSfr(SFR_WPUC))
+#define RC3PPS          (*hostSfr(SFR_RC3PPS))
+#define RC5PPS          (*hostSfr(SFR_RC5PPS))
+#define RC6PPS          (*hostSfr(SFR_RC6PPS))
+#define SPI1CON0        (*hostSfr(SFR_SPI1CON0))
+#define SPI1CON1        (*hostSfr(SFR_SPI1CON1))
+#define SPI1CON2        (*hostSfr(SFR_SPI1CON2))
+#define SPI1CLK         (*hostSfr(SFR_SPI1CLK))
+#define SPI1BAUD        (*hostSfr(SFR_SPI1BAUD))
+#define SPI1TXB         (*hostSpiTxb())
+#define T1CON           (*hostSfr(SFR_T1CON))
+#define T1CLK           (*hostSfr(SFR_T1CLK))
+#define TMR1            (*hostTmr1())
+#define T2CON           (*hostSfr(SFR_T2CON))
+#define T2CLKCON        (*hostSfr(SFR_T2CLKCON))
+#define T2HLT           (*hostSfr(SFR_T2HLT))
+#define T2PR            (*hostSfr(SFR_T2PR))
+#define T2TMR           (*hostSfr(SFR_T2TMR))
+
+#define LATAbits        (*(volatile LATAbits_t *)hostSfr(SFR_LATA))
+#define LATBbits        (*(volatile LATBbits_t *)hostSfr(SFR_LATB))
+#define LATCbits        (*(volatile LATCbits_t *)hostSfr(SFR_LATC))
+#define PORTAbits       (*(volatile PORTAbits_t *)hostSfr(SFR_PORTA))
+#define PORTBbits       (*(volatile PORTBbits_t *)hostSfr(SFR_PORTB))
+#define PORTCbits       (*(volatile PORTCbits_t *)hostSfr(SFR_PORTC))
+#define TRISAbits       (*(volatile TRISAbits_t *)hostSfr(SFR_TRISA))
+#define TRISBbits       (*(volatile TRISBbits_t *)hostSfr(SFR_TRISB))
+#define TRISCbits       (*(volatile TRISCbits_t *)hostSfr(SFR_TRISC))
+#define SPI1CON0bits    (*(volatile SPI1CON0bits_t *)hostSfr(SFR_SPI1CON0))
+#define SPI1CON2bits    (*(volatile SPI1CON2bits_t *)hostSfr(SFR_SPI1CON2))
+#define OSCFRQbits      (*(volatile OSCFRQbits_t *)hostSfr(SFR_OSCFRQ))
+#define T1CONbits       (*(volatile T1CONbits_t *)hostSfr(SFR_T1CON))
+#define T2CONbits       (*(volatile T2CONbits_t *)hostSfr(SFR_T2CON))
+#define PIR3bits        (*(volatile PIR3bits_t *)hostSfr(SFR_PIR3))
+#define PIE3bits        (*(volatile PIE3bits_t *)hostSfr(SFR_PIE3))
+#define IPR3bits        (*(volatile IPR3bits_t *)hostSfr(SFR_IPR3))
+#define INTCON0bits     (*(volatile INTCON0bits_t *)hostSfr(SFR_INTCON0))
+
+#define ei()            (INTCON0bits.GIE = 1)
+#define di()            (INTCON0bits.GIE = 0)
+#define NOP()           hostNop()
+#define __interrupt(...)
+
+#endif
@@ -0,0 +1,322 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Behavioural models of the CANPANEL hardware for the host build.
+ *
+ * The MAX6951s decode their SPI traffic into register state. Each chip
+ * shifts in SDO on the rising edge of SCK whilst its CS is low and latches
+ * the last 16 bits when CS goes high, as the real chip does. So a CS pulse
+ * with no clocks latches the previous command again, and a count other than
+ * 16 latches a misaligned one, both of which are counted.
+ *
+ * The 74HC595 chain shifts on every rising edge of SCK, whoever is driving
+ * it, and its outputs follow on the rising edge of RCLK. A low output strobes
+ * its column.
+ *
+ * A row input reads low when a pressed button is in a column being strobed.
+ *
+ * @date October 2026
+ */
+
+#include <string.h>
+#include "panelModel.h"
+#include "sfrMock.h"
+#include "matrix.h"
+
+MaxChip maxChips[NUM_MAX_CHIPS];
+PinConflicts pinConflicts;
+void (* maxWriteObserver)(uint8_t chip, uint8_t reg, uint8_t value);
+
+static uint8_t pinsA;
+static uint8_t pinsC;
+static uint64_t chainShift;         // 74HC595 shift registers, first column in bit 0
+static uint64_t chainOutputs;       // the storage registers
+static uint8_t pressed[COLUMN_OUTPUTS];     // bit per row
+
+#define SCK         0x08            // RC3
+#define SDO         0x20            // RC5
+#define RCLK        0x80            // RA7
+
+#define CHAIN_MASK  ((EXTRA_COLUMNS >= 64) ? ~0ULL : ((1ULL << EXTRA_COLUMNS) - 1))
+
+// port and bit of each row input
+static const uint8_t rowPort[8] = {
+    KBD_PORT_ID(KBD_INP0_PORT), KBD_PORT_ID(KBD_INP1_PORT), KBD_PORT_ID(KBD_INP2_PORT), KBD_PORT_ID(KBD_INP3_PORT),
+    KBD_PORT_ID(KBD_INP4_PORT), KBD_PORT_ID(KBD_INP5_PORT), KBD_PORT_ID(KBD_INP6_PORT), KBD_PORT_ID(KBD_INP7_PORT)
+};
+static const uint8_t rowBit[8] = {
+    KBD_INP0_BIT, KBD_INP1_BIT, KBD_INP2_BIT, KBD_INP3_BIT,
+    KBD_INP4_BIT, KBD_INP5_BIT, KBD_INP6_BIT, KBD_INP7_BIT
+};
+
+/**
+ * The level of a MAX chip's CS pin.
+ */
+static uint8_t chipSelect(uint8_t chip, uint8_t a, uint8_t c) {
+    switch (chip) {
+        case 0:
+            return (c & 0x40) ? 1 : 0;     // RC6
+        case 1:
+            return (a & 0x10) ? 1 : 0;     // RA4
+        default:
+            return (a & 0x40) ? 1 : 0;     // RA6
+    }
+}
+
+void modelReset(void) {
+    uint8_t chip;
+
+    memset(maxChips, 0, sizeof(maxChips));
+    memset(&pinConflicts, 0, sizeof(pinConflicts));
+    memset(pressed, 0, sizeof(pressed));
+    pinsA = 0xFF;           // all inputs, pulled high
+    pinsC = 0xFF;
+    chainShift = 0;
+    chainOutputs = CHAIN_MASK;
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        maxChips[chip].selected = 0;
+    }
+}
+
+/**
+ * A register write latched by a MAX chip.
+ */
+static void maxLatch(uint8_t chip, uint16_t command) {
+    MaxChip * mx;
+    uint8_t reg;
+    uint8_t value;
+    uint8_t digit;
+
+    mx = &maxChips[chip];
+    reg = (uint8_t)(command >> 8) & 0x7F;
+    value = (uint8_t)command;
+    if (maxWriteObserver != NULL) {
+        maxWriteObserver(chip, reg, value);
+    }
+    digit = reg & 0x07;
+    switch (reg & 0x60) {
+        case 0x20:
+        case 0x40:
+        case 0x60:
+            mx->digitWrites++;
+            if (((reg & 0x20) && (mx->plane[0][digit] != value)) ||
+                    ((reg & 0x40) && (mx->plane[1][digit] != value))) {
+                // changed something
+            } else {
+                mx->redundantWrites++;
+            }
+            if (reg & 0x20) {
+                mx->plane[0][digit] = value;
+            }
+            if (reg & 0x40) {
+                mx->plane[1][digit] = value;
+            }
+            return;
+    }
+    switch (reg) {
+        case 1:
+            mx->decode = value;
+            break;
+        case 2:
+            mx->intensity = value;
+            break;
+        case 3:
+            mx->scanLimit = value;
+            break;
+        case 4:
+            if (value & 0x20) {
+                memset(mx->plane, 0, sizeof(mx->plane));
+            }
+            mx->config = value & ~0x20;
+            break;
+        case 7:
+            mx->test = value;
+            break;
+    }
+}
+
+/**
+ * The pins have changed. Data is taken before the clock edge, and the chip
+ * selects and RCLK after it.
+ */
+void modelPins(uint8_t a, uint8_t c) {
+    uint8_t chip;
+    uint8_t sdo;
+    uint8_t cs;
+    MaxChip * mx;
+
+    sdo = (c & SDO) ? 1 : 0;
+    if ((c & SCK) && !(pinsC & SCK)) {
+        for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+            mx = &maxChips[chip];
+            if (mx->selected) {
+                if (inInterrupt()) {
+                    pinConflicts.spiInIsr++;
+                }
+                mx->shift = (uint16_t)((mx->shift << 1) | sdo);
+                if (mx->bits < 0xFF) {
+                    mx->bits++;
+                }
+            }
+        }
+        chainShift = ((chainShift << 1) | sdo) & CHAIN_MASK;
+    }
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        mx = &maxChips[chip];
+        cs = chipSelect(chip, a, c);
+        if (!cs && !mx->selected) {
+            mx->selected = 1;
+            mx->bits = 0;
+        } else if (cs && mx->selected) {
+            mx->selected = 0;
+            if (mx->bits == 16) {
+                mx->transactions++;
+                if (((mx->shift >> 8) & 0x7F) == 0) {
+                    mx->nops++;
+                }
+            } else if (mx->bits == 0) {
+                if ((mx->shift >> 8) & 0x7F) {
+                    mx->staleLatches++;
+                }
+            } else {
+                mx->framingErrors++;
+            }
+            maxLatch(chip, mx->shift);
+        }
+    }
+    if ((a & RCLK) && !(pinsA & RCLK)) {
+        chainOutputs = chainShift;
+    }
+    pinsA = a;
+    pinsC = c;
+}
+
+/**
+ * Is a column being strobed?
+ */
+uint8_t modelActiveColumn(uint8_t column) {
+    if (column < NATIVE_COLUMNS) {
+        return (pinsC & (1 << column)) ? 0 : 1;
+    }
+    column -= NATIVE_COLUMNS;
+    return (chainOutputs & (1ULL << column)) ? 0 : 1;
+}
+
+/**
+ * The value read from port A (0) or B (1). Outputs read back their latch,
+ * the row inputs are pulled up unless pulled down through a button, and the
+ * push button on RA2 isn't pressed.
+ */
+uint8_t modelReadPort(uint8_t port, uint8_t lat) {
+    uint8_t rowsLow;
+    uint8_t column;
+    uint8_t row;
+    uint8_t value;
+
+    rowsLow = 0;
+    for (column = 0; column < COLUMN_OUTPUTS; column++) {
+        if (pressed[column] && modelActiveColumn(column)) {
+            rowsLow |= pressed[column];
+        }
+    }
+    value = lat;
+    if (port == 0) {
+        value |= 0x04;
+    }
+    for (row = 0; row < ROW_INPUTS; row++) {
+        if (rowPort[row] == port) {
+            if (rowsLow & (1 << row)) {
+                value &= (uint8_t)~(1 << rowBit[row]);
+            } else {
+                value |= (uint8_t)(1 << rowBit[row]);
+            }
+        }
+    }
+    return value;
+}
+
+/**
+ * The key scan interrupt is being taken. It strobes columns on pins shared
+ * with the SPI, so must not come whilst a MAX chip is selected.
+ */
+void modelInterruptEntry(void) {
+    uint8_t chip;
+
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        if (maxChips[chip].selected) {
+            pinConflicts.isrWithChipSelected++;
+            return;
+        }
+    }
+}
+
+/**
+ * Press or release a button.
+ * @param pb the button, 0 based, column * ROW_INPUTS + row
+ */
+void modelSetButton(uint8_t pb, uint8_t down) {
+    uint8_t column;
+    uint8_t row;
+
+    column = pb / ROW_INPUTS;
+    row = pb % ROW_INPUTS;
+    if (column >= COLUMN_OUTPUTS) {
+        return;
+    }
+    if (down) {
+        pressed[column] |= (uint8_t)(1 << row);
+    } else {
+        pressed[column] &= (uint8_t)~(1 << row);
+    }
+}
+
+/**
+ * The state of an LED as the MAX chip shows it.
+ * @param led the physical LED, 1 based
+ * @return bit 0 set if lit in plane 0, bit 1 if lit in plane 1. So 3 is on and
+ * 1 or 2 flashing
+ */
+uint8_t modelLedPlanes(uint8_t led) {
+    uint8_t chip;
+    uint8_t digit;
+    uint8_t mask;
+
+    if ((led == 0) || (led > NUM_LED)) {
+        return 0;
+    }
+    led--;
+    chip = led / 64;
+    digit = (led % 64) / 8;
+    mask = (uint8_t)(1 << (led % 8));
+    return (uint8_t)(((maxChips[chip].plane[0][digit] & mask) ? 1 : 0) |
+            ((maxChips[chip].plane[1][digit] & mask) ? 2 : 0));
+}
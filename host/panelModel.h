@@ -0,0 +1,93 @@
+#ifndef _PANELMODEL_H_
+#define _PANELMODEL_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Behavioural models of the CANPANEL hardware for the host build: the
+ * MAX6951 LED drivers, the 74HC595 column shift registers and the button
+ * matrix. They only see the pin levels given by sfrMock.c.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+#include "module.h"
+
+#define MODEL_MAX_DIGITS    8
+
+/**
+ * A MAX6951 as seen through its registers, with counts of what it was sent.
+ */
+typedef struct {
+    uint8_t decode;
+    uint8_t intensity;
+    uint8_t scanLimit;
+    uint8_t config;
+    uint8_t test;
+    uint8_t plane[2][MODEL_MAX_DIGITS];
+    uint16_t shift;             // the 16 bit shift register, kept across CS
+    uint8_t bits;               // clocked in since CS went low
+    uint8_t selected;           // CS is low
+    uint32_t transactions;      // 16 bit writes latched by CS
+    uint32_t nops;              // of which to the NOP register
+    uint32_t digitWrites;
+    uint32_t redundantWrites;   // digit writes which changed nothing
+    uint32_t framingErrors;     // CS went high after other than 0 or 16 bits
+    uint32_t staleLatches;      // CS pulsed with no bits, latching an old non NOP command
+} MaxChip;
+
+/**
+ * Counts of hardware conflicts between the key scan and the SPI.
+ */
+typedef struct {
+    uint32_t isrWithChipSelected;   // key scan interrupt taken with a MAX chip selected
+    uint32_t spiInIsr;              // bits clocked into a MAX chip by the interrupt
+} PinConflicts;
+
+extern MaxChip maxChips[NUM_MAX_CHIPS];
+extern PinConflicts pinConflicts;
+
+/*
+ * Called for each register a MAX chip latches.
+ */
+extern void (* maxWriteObserver)(uint8_t chip, uint8_t reg, uint8_t value);
+
+void modelReset(void);
+void modelPins(uint8_t porta, uint8_t portc);
+uint8_t modelReadPort(uint8_t port, uint8_t lat);
+void modelInterruptEntry(void);
+void modelSetButton(uint8_t pb, uint8_t pressed);
+uint8_t modelLedPlanes(uint8_t led);
+uint8_t modelActiveColumn(uint8_t column);
+
+#endif
@@ -0,0 +1,103 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Replay a CAN log in GridConnect form to a node in the host build, writing
+ * the timeline of what it did, see hostReplay.c.
+ *
+ *   replay [-n nodeNumber] [-i canId] [-v nv=value]... [-s speed] [log]
+ *
+ * The node starts as a newly configured one with the NVs given, so a log
+ * should begin with the teaching of the events it uses, as from the FCU.
+ * The log is read from stdin if not given.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "hostCosts.h"
+#include "hostNode.h"
+#include "hostReplay.h"
+
+// time for the node to be through its power up before the log starts
+#define SETTLE_MS       3000
+
+int main(int argc, char ** argv) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    double speed = 0;
+    unsigned nv;
+    unsigned value;
+    uint32_t frames;
+    FILE * log;
+    int opt;
+
+    hostReset();
+    while ((opt = getopt(argc, argv, "n:i:v:s:")) != -1) {
+        switch (opt) {
+            case 'n':
+                config.nodeNumber = (uint16_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                config.canId = (uint8_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                if (sscanf(optarg, "%u=%u", &nv, &value) != 2) {
+                    fprintf(stderr, "%s: an NV is given as index=value\n", argv[0]);
+                    return 2;
+                }
+                hostSetNv((uint8_t)nv, (uint8_t)value);
+                break;
+            case 's':
+                speed = atof(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n nodeNumber] [-i canId] [-v nv=value]... [-s speed] [log]\n", argv[0]);
+                return 2;
+        }
+    }
+    log = stdin;
+    if (optind < argc) {
+        log = fopen(argv[optind], "r");
+        if (log == NULL) {
+            perror(argv[optind]);
+            return 2;
+        }
+    }
+
+    hostConfigure(&config);
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(SETTLE_MS));
+    frames = hostReplay(log, stdout, speed);
+    fprintf(stderr, "%u frames replayed\n", frames);
+    return 0;
+}
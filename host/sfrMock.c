@@ -0,0 +1,401 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The registers, virtual clock and key scan interrupt of the host build.
+ *
+ * Every register access by the firmware comes through hostSfr(). A write is
+ * only seen at the next access, so each access first compares the registers
+ * which have side effects with their shadows and passes any change on to the
+ * panel model: the pins, the SPI and Timer 2. Then the clock is charged for
+ * the access, the timers are advanced and the key scan interrupt is taken if
+ * it is due. Last the value of the register being accessed is brought up to
+ * date from the models, which is what makes the port reads work.
+ *
+ * Taking the interrupt before the value is returned means that a read modify
+ * write of a register is never split by the interrupt, as on the PIC.
+ *
+ * @date October 2026
+ */
+
+#include <string.h>
+#include <xc.h>
+#include "hostCosts.h"
+#include "sfrMock.h"
+#include "panelModel.h"
+
+// Provided by buttonscan.c when built with KEYSCAN_ISR
+extern void keyScanIsr(void) __attribute__((weak, visibility("hidden")));
+
+SfrStats sfrStats;
+
+static volatile uint8_t sfrs[NUM_SFRS];
+static uint8_t shadows[NUM_SFRS];
+static volatile uint16_t spiTxb;
+static volatile uint16_t tmr1;
+
+static uint8_t spiData;         // level of SDO whilst the SPI has the pins
+static uint8_t isrActive;
+static uint8_t isrMasked;       // no interrupts during a flash write
+static uint16_t t2Prescale;     // cycles counted towards the next Timer 2 count
+static uint8_t t2Postscale;     // period matches counted towards the next TMR2IF
+static uint64_t t1Cycles;       // cycles counted by Timer 1 since it was last written
+
+#define T2_ON()         (sfrs[SFR_T2CON] & 0x80)
+#define T2_PRESCALE()   (1u << ((sfrs[SFR_T2CON] >> 4) & 0x07))
+#define T2_POSTSCALE()  ((sfrs[SFR_T2CON] & 0x0F) + 1u)
+#define T1_ON()         (sfrs[SFR_T1CON] & 0x01)
+#define T1_PRESCALE()   (1u << ((sfrs[SFR_T1CON] >> 4) & 0x03))
+#define SPI_ON()        (sfrs[SFR_SPI1CON0] & 0x80)
+#define TMR2IF          0x08
+#define TMR2IE          0x08
+#define GIE             0x80
+
+/**
+ * Put the registers in their power on state.
+ */
+void sfrReset(void) {
+    memset((void *)sfrs, 0, sizeof(sfrs));
+    sfrs[SFR_TRISA] = sfrs[SFR_TRISB] = sfrs[SFR_TRISC] = 0xFF;
+    sfrs[SFR_ANSELA] = sfrs[SFR_ANSELB] = sfrs[SFR_ANSELC] = 0xFF;
+    sfrs[SFR_T2PR] = 0xFF;
+    memcpy(shadows, (void *)sfrs, sizeof(shadows));
+    spiTxb = HOST_SPI_IDLE;
+    tmr1 = 0;
+    spiData = 0;
+    isrActive = 0;
+    isrMasked = 0;
+    t2Prescale = 0;
+    t2Postscale = 0;
+    t1Cycles = 0;
+    memset(&sfrStats, 0, sizeof(sfrStats));
+}
+
+/**
+ * The levels on the port A and C pins. A pin which isn't an output is pulled
+ * high. SCK and SDO belong to the SPI whilst it is enabled. The chip select of
+ * the first MAX chip is driven from LATC6 throughout, the PPS switching of RC6
+ * isn't modelled.
+ */
+static uint8_t pinsA(void) {
+    return sfrs[SFR_LATA] | sfrs[SFR_TRISA];
+}
+
+static uint8_t pinsC(void) {
+    return sfrs[SFR_LATC] | sfrs[SFR_TRISC];
+}
+
+static void updatePins(void) {
+    uint8_t c;
+
+    c = pinsC();
+    if (SPI_ON()) {
+        c &= ~0x28;         // SCK idles low
+        c |= spiData ? 0x20 : 0;
+    }
+    modelPins(pinsA(), c);
+}
+
+/**
+ * Clock a byte out of the SPI, MSB first. The data is set up before the
+ * rising edge of SCK, which is when the MAX chips and the 595s sample it.
+ */
+static void spiSend(uint8_t b) {
+    uint8_t i;
+    uint8_t c;
+
+    for (i = 0; i < 8; i++) {
+        spiData = (b & 0x80) ? 1 : 0;
+        b <<= 1;
+        c = pinsC() & ~0x28;
+        c |= spiData ? 0x20 : 0;
+        modelPins(pinsA(), c);
+        modelPins(pinsA(), c | 0x08);
+        modelPins(pinsA(), c);
+    }
+    sfrStats.spiBytes++;
+}
+
+/**
+ * Act on what has been written since the last access.
+ */
+void hostSync(void) {
+    uint8_t pins;
+
+    pins = 0;
+    if (sfrs[SFR_SPI1CON0] != shadows[SFR_SPI1CON0]) {
+        shadows[SFR_SPI1CON0] = sfrs[SFR_SPI1CON0];
+        pins = 1;
+    }
+    if ((sfrs[SFR_LATA] != shadows[SFR_LATA]) || (sfrs[SFR_LATC] != shadows[SFR_LATC]) ||
+            (sfrs[SFR_TRISA] != shadows[SFR_TRISA]) || (sfrs[SFR_TRISC] != shadows[SFR_TRISC])) {
+        shadows[SFR_LATA] = sfrs[SFR_LATA];
+        shadows[SFR_LATC] = sfrs[SFR_LATC];
+        shadows[SFR_TRISA] = sfrs[SFR_TRISA];
+        shadows[SFR_TRISC] = sfrs[SFR_TRISC];
+        pins = 1;
+    }
+    if (pins) {
+        updatePins();
+    }
+    if (spiTxb != HOST_SPI_IDLE) {
+        uint8_t b = (uint8_t)spiTxb;
+
+        spiTxb = HOST_SPI_IDLE;
+        if (SPI_ON()) {
+            spiSend(b);
+        } else {
+            sfrStats.spiWritesWhileOff++;
+        }
+    }
+    if (sfrs[SFR_T2TMR] != shadows[SFR_T2TMR]) {
+        shadows[SFR_T2TMR] = sfrs[SFR_T2TMR];
+        t2Prescale = 0;
+    }
+    if (sfrs[SFR_T2CON] != shadows[SFR_T2CON]) {
+        shadows[SFR_T2CON] = sfrs[SFR_T2CON];
+        t2Prescale = 0;
+        t2Postscale = 0;
+    }
+}
+
+/**
+ * Cycles until Timer 2 next sets TMR2IF, 0 if it isn't running.
+ */
+static uint64_t t2CyclesToFlag(void) {
+    uint64_t period;
+    uint64_t counts;
+
+    if (!T2_ON()) {
+        return 0;
+    }
+    period = (uint64_t)sfrs[SFR_T2PR] + 1;
+    counts = period - (sfrs[SFR_T2TMR] % period);
+    counts += (T2_POSTSCALE() - 1 - t2Postscale) * period;
+    return counts * T2_PRESCALE() - t2Prescale;
+}
+
+/**
+ * Run the timers on by a number of cycles. Each time Timer 2 matches T2PR it
+ * goes back to 0, and every OUTPS+1 matches TMR2IF is set.
+ */
+static void advanceTimers(uint64_t cycles) {
+    uint64_t counts;
+    uint64_t period;
+    uint64_t total;
+
+    if (T1_ON()) {
+        t1Cycles += cycles;
+    }
+    if (!T2_ON()) {
+        return;
+    }
+    total = t2Prescale + cycles;
+    counts = total / T2_PRESCALE();
+    t2Prescale = (uint16_t)(total % T2_PRESCALE());
+    period = (uint64_t)sfrs[SFR_T2PR] + 1;
+    total = sfrs[SFR_T2TMR] + counts;
+    sfrs[SFR_T2TMR] = (uint8_t)(total % period);
+    shadows[SFR_T2TMR] = sfrs[SFR_T2TMR];
+    for (counts = total / period; counts > 0; counts--) {
+        if (++t2Postscale >= T2_POSTSCALE()) {
+            t2Postscale = 0;
+            if (sfrs[SFR_PIR3] & TMR2IF) {
+                sfrStats.missedInterrupts++;
+            }
+            sfrs[SFR_PIR3] |= TMR2IF;
+        }
+    }
+}
+
+/**
+ * Take the key scan interrupt if it is enabled and pending.
+ */
+static void checkInterrupt(void) {
+    uint64_t start;
+    uint64_t cycles;
+
+    if (isrActive || isrMasked || (keyScanIsr == NULL)) {
+        return;
+    }
+    if (!(sfrs[SFR_INTCON0] & GIE) || !(sfrs[SFR_PIE3] & TMR2IE) || !(sfrs[SFR_PIR3] & TMR2IF)) {
+        return;
+    }
+    isrActive = 1;
+    start = sfrStats.cycles;
+    if (SPI_ON()) {
+        sfrStats.isrDuringSpi++;
+    }
+    modelInterruptEntry();
+    sfrStats.cycles += COST_INTERRUPT;
+    advanceTimers(COST_INTERRUPT);
+    keyScanIsr();
+    hostSync();
+    isrActive = 0;
+    cycles = sfrStats.cycles - start;
+    if (cycles > sfrStats.worstInterruptCycles) {
+        sfrStats.worstInterruptCycles = (uint32_t)cycles;
+    }
+    sfrStats.interrupts++;
+}
+
+/**
+ * Run the clock on, stopping to take the interrupt when Timer 2 sets its
+ * flag part way through.
+ */
+static void advance(uint64_t cycles, uint8_t idle) {
+    uint64_t step;
+    uint64_t due;
+
+    while (cycles > 0) {
+        step = cycles;
+        due = t2CyclesToFlag();
+        if ((due != 0) && (due < step)) {
+            step = due;
+        }
+        sfrStats.cycles += step;
+        if (idle) {
+            sfrStats.idleCycles += step;
+        }
+        advanceTimers(step);
+        cycles -= step;
+        checkInterrupt();
+    }
+}
+
+/**
+ * Charge the clock for work done by the firmware or the library.
+ */
+void hostCharge(uint32_t cycles) {
+    hostSync();
+    advance(cycles, 0);
+}
+
+/**
+ * Stall the CPU, as for an NVM write. The interrupt may be held off until the
+ * end.
+ */
+void hostStall(uint64_t cycles, uint8_t interrupts) {
+    hostSync();
+    isrMasked = !interrupts;
+    advance(cycles, 0);
+    isrMasked = 0;
+    checkInterrupt();
+}
+
+/**
+ * Let the clock run on to a time with nothing for the main loop to do.
+ * Interrupts still happen.
+ */
+void hostIdleUntil(uint64_t cycle) {
+    hostSync();
+    if (cycle > sfrStats.cycles) {
+        advance(cycle - sfrStats.cycles, 1);
+    }
+}
+
+uint64_t hostCycles(void) {
+    return sfrStats.cycles;
+}
+
+/**
+ * Read a register without it counting as an access.
+ */
+uint8_t sfrValue(uint8_t sfr) {
+    return sfrs[sfr];
+}
+
+uint8_t spiEnabled(void) {
+    return SPI_ON() ? 1 : 0;
+}
+
+uint8_t inInterrupt(void) {
+    return isrActive;
+}
+
+/**
+ * Where the firmware accesses a register.
+ */
+volatile uint8_t * hostSfr(uint8_t sfr) {
+    hostCharge(COST_SFR_ACCESS);
+    sfrStats.sfrAccesses++;
+    switch (sfr) {
+        case SFR_PORTA:
+            sfrs[SFR_PORTA] = modelReadPort(0, sfrs[SFR_LATA]);
+            break;
+        case SFR_PORTB:
+            sfrs[SFR_PORTB] = modelReadPort(1, sfrs[SFR_LATB]);
+            break;
+        case SFR_PORTC:
+            sfrs[SFR_PORTC] = sfrs[SFR_LATC];
+            break;
+        case SFR_SPI1CON2:
+            sfrs[SFR_SPI1CON2] &= 0x7F;    // a byte is sent at once, never busy
+            break;
+    }
+    return &sfrs[sfr];
+}
+
+volatile uint16_t * hostSpiTxb(void) {
+    hostCharge(COST_SFR_ACCESS + COST_SPI_BYTE);
+    sfrStats.sfrAccesses++;
+    return &spiTxb;
+}
+
+/**
+ * Timer 1 counts at Fosc/4 with the prescale, 0.5us a count for the profile.
+ * The firmware only reads it.
+ */
+volatile uint16_t * hostTmr1(void) {
+    hostCharge(COST_SFR_ACCESS);
+    sfrStats.sfrAccesses++;
+    tmr1 = (uint16_t)(t1Cycles / T1_PRESCALE());
+    return &tmr1;
+}
+
+void hostNop(void) {
+    hostCharge(1);
+}
+
+/*
+ * The firmware is built with -finstrument-functions so each function call
+ * is charged.
+ */
+void __cyg_profile_func_enter(void * fn, void * site) __attribute__((no_instrument_function));
+void __cyg_profile_func_exit(void * fn, void * site) __attribute__((no_instrument_function));
+
+void __cyg_profile_func_enter(void * fn, void * site) {
+    sfrStats.functionCalls++;
+    hostCharge(COST_FUNCTION_CALL);
+}
+
+void __cyg_profile_func_exit(void * fn, void * site) {
+}
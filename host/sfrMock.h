@@ -0,0 +1,71 @@
+#ifndef _SFRMOCK_H_
+#define _SFRMOCK_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The registers, virtual clock and interrupt of the host build.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+
+/**
+ * Counts kept by the register mock.
+ */
+typedef struct {
+    uint64_t cycles;                // the virtual clock, instruction cycles since reset
+    uint64_t idleCycles;            // of which skipped whilst the main loop had nothing to do
+    uint32_t sfrAccesses;
+    uint32_t functionCalls;         // firmware function calls
+    uint32_t interrupts;            // key scan interrupts taken
+    uint32_t worstInterruptCycles;
+    uint32_t missedInterrupts;      // Timer 2 came round again before the flag was cleared
+    uint32_t spiBytes;              // bytes clocked out of the SPI
+    uint32_t spiWritesWhileOff;     // SPI1TXB written with the SPI disabled
+    uint32_t isrDuringSpi;          // interrupts taken with the SPI enabled
+} SfrStats;
+
+extern SfrStats sfrStats;
+
+void sfrReset(void);
+void hostSync(void);
+void hostCharge(uint32_t cycles);
+void hostStall(uint64_t cycles, uint8_t interrupts);
+void hostIdleUntil(uint64_t cycle);
+uint64_t hostCycles(void);
+uint8_t sfrValue(uint8_t sfr);
+uint8_t spiEnabled(void);
+uint8_t inInterrupt(void);
+
+#endif
@@ -0,0 +1,174 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * A layout of panels powered up together on one CAN bus, see hostSim.c.
+ *
+ *   sim [-n nodes] [-b buttons] [-r bitRate] [-t seconds] [-c ms] [-l library]
+ *
+ * Panel i has node number 256+i and CANID i+1. Each has the given number of
+ * buttons, sent at start of day, and shows the buttons of the next panel on
+ * its LEDs, asking for their state at start up. Its SOD event asks the panel
+ * before it for its buttons. Once the time is up the bus's load, queueing
+ * delay and lost frames are written.
+ *
+ * With -c the load is also written for each interval of that many ms, as
+ * the time and percentage bus use, showing the curve of the start of day as
+ * the panels' staggered SODs and the responses to them go out. Time 0 is
+ * when the panels have powered up.
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "hostCosts.h"
+#include "hostSim.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+
+#define PANEL_NN(i)     (256 + (i))
+#define SOD_EN          1
+#define BUTTON_EN(pb)   (100 + (pb))
+
+/**
+ * Set up panel i of n and power it up. It is taught first, as though that
+ * had been done on an earlier run, so all the panels power up together.
+ */
+static void configurePanel(uint16_t i, uint16_t n, uint8_t buttons) {
+    const HostNodeApi * node;
+    HostConfig config;
+    uint16_t next;
+    uint8_t pb;
+
+    node = simNode(i);
+    next = (uint16_t)((i + 1) % n);
+    config.nodeNumber = PANEL_NN(i);
+    config.canId = (uint8_t)(i + 1);
+    config.bitRate = 0;
+    node->configure(&config);
+    node->setNv(NV_PANEL_FLAGS, NV_PANEL_FLAGS_STATE_REQUEST);
+    for (pb = 0; pb < buttons; pb++) {
+        node->setNv(NV_PB_FLAGS + pb, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF | NV_PB_FLAGS_ENABLE_SOD);
+    }
+    node->teach(PANEL_NN(i), SOD_EN, 0, HAPPENING_SOD);
+    node->teach(PANEL_NN(next), SOD_EN, 1, ACTION_SPECIALS);
+    node->teach(PANEL_NN(next), SOD_EN, 2, ACTION_SPECIAL_SOD);
+    for (pb = 0; pb < buttons; pb++) {
+        node->teach(PANEL_NN(i), BUTTON_EN(pb), 0, PB_2_HAPPENING(pb));
+        node->teach(PANEL_NN(next), BUTTON_EN(pb), 1, pb + 1);
+        node->teach(PANEL_NN(next), BUTTON_EN(pb), 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+    }
+    node->powerUp();
+}
+
+static double wallSeconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char ** argv) {
+    const char * library = NODE_LIBRARY;
+    uint16_t nodes = 64;
+    uint8_t buttons = 8;
+    uint32_t bitRate = CAN_DEFAULT_BIT_RATE;
+    double seconds = 5;
+    double wall;
+    uint32_t curveMs = 0;
+    uint64_t start;
+    const SimLoadCurve * curve;
+    SimStats s;
+    uint16_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:b:r:t:c:l:")) != -1) {
+        switch (opt) {
+            case 'n':
+                nodes = (uint16_t)atoi(optarg);
+                break;
+            case 'b':
+                buttons = (uint8_t)atoi(optarg);
+                break;
+            case 'r':
+                bitRate = (uint32_t)atol(optarg);
+                break;
+            case 't':
+                seconds = atof(optarg);
+                break;
+            case 'c':
+                curveMs = (uint32_t)atoi(optarg);
+                break;
+            case 'l':
+                library = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n nodes] [-b buttons] [-r bitRate] [-t seconds] [-c ms] [-l library]\n", argv[0]);
+                return 2;
+        }
+    }
+    if ((nodes == 0) || (buttons > NUM_PB) || (bitRate == 0)) {
+        fprintf(stderr, "%s: 1 or more nodes, no more than %u buttons, and a bit rate\n", argv[0], NUM_PB);
+        return 2;
+    }
+
+    if (simOpen(library, nodes, bitRate) != 0) {
+        return 1;
+    }
+    for (i = 0; i < nodes; i++) {
+        configurePanel(i, nodes, buttons);
+    }
+    start = simSync();
+    if ((curveMs > 0) && (simLoadCurve(MS_CYCLES(curveMs), (uint32_t)(seconds * 1000 / curveMs)) != 0)) {
+        return 1;
+    }
+    wall = wallSeconds();
+    simRunUntil(start + MS_CYCLES(seconds * 1000));
+    wall = wallSeconds() - wall;
+    simGetStats(&s);
+    curve = simGetLoadCurve();
+    for (i = 0; i < curve->buckets; i++) {
+        printf("%8u %6.2f\n", i * curveMs, 100.0 * curve->busy[i] / curve->bucketCycles);
+    }
+    simClose();
+
+    printf("%u nodes at %u bit/s, %.3f s simulated in %.3f s, %.1f times real time\n",
+            nodes, bitRate, seconds, wall, seconds / wall);
+    printf("frames %u, utilisation %.2f%%, lost arbitration %u\n",
+            s.frames, 100.0 * s.busyCycles / MS_CYCLES(seconds * 1000), s.arbitrationsLost);
+    printf("queueing delay mean %.3f ms, worst %.3f ms\n",
+            s.frames ? (double)s.totalDelay / s.frames / MS_CYCLES(1) : 0.0, (double)s.worstDelay / MS_CYCLES(1));
+    printf("dropped %u on receive, %u on send\n", s.rxDrops, s.txDrops);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef _HOSTTEST_H_
+#define _HOSTTEST_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Checks for the host tests. A test carries on after a failed check so all
+ * the failures are reported, and main() returns testResult().
+ *
+ * @date October 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "hostCosts.h"
+#include "hostNode.h"
+
+static int testFailures;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #cond); \
+        testFailures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual); \
+    long long e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        printf("%s:%d: failed: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        testFailures++; \
+    } \
+} while (0)
+
+static inline int testResult(void) {
+    if (testFailures) {
+        printf("%d check(s) failed\n", testFailures);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Three MAX6951s driving 192 LEDs. A route with LEDs on every chip is sent
+ * in batches between the column reads, and an exclusive group which spans
+ * two chips changes in a single flush.
+ *
+ * Built with NUM_MAX_CHIPS 3.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "panelModel.h"
+#include "max6951.h"
+#include "portArbiter.h"
+
+#define EVENT_NN        0x0102
+#define ROUTE_EN        1
+#define GROUP_A_EN      2
+#define GROUP_B_EN      3
+#define GROUP_A_LED     62      // chip 0
+#define GROUP_B_LED     68      // chip 1
+
+// two LEDs on each chip, in different digits and outside the group, those
+// of chip 2 in the second bank
+static const uint8_t routeLeds[] = {1, 57, 73, 121, 137, 185};
+
+// digit writes further apart than this are from different flushes
+#define FLUSH_GAP   (100 * CYCLES_PER_US)
+
+static uint32_t writes;
+static uint32_t flushes;
+static uint32_t firstFlushWrites;
+static uint64_t lastWrite;
+static uint32_t chipWrites[NUM_MAX_CHIPS];
+
+static void watchWrite(uint8_t chip, uint8_t reg, uint8_t value) {
+    if ((reg & 0x60) == 0) {
+        return;     // not a digit
+    }
+    if ((writes == 0) || (hostNow() - lastWrite > FLUSH_GAP)) {
+        flushes++;
+    }
+    if (flushes == 1) {
+        firstFlushWrites++;
+    }
+    lastWrite = hostNow();
+    writes++;
+    chipWrites[chip]++;
+}
+
+static void startWatching(void) {
+    uint8_t chip;
+
+    writes = 0;
+    flushes = 0;
+    firstFlushWrites = 0;
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        chipWrites[chip] = 0;
+    }
+}
+
+static void sendEvent(uint8_t opc, uint16_t en) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, (uint8_t)(en >> 8), (uint8_t)(en & 0xFF)};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint8_t i;
+    uint8_t chip;
+    uint8_t led;
+    uint8_t flags;
+
+    CHECK_EQ(NUM_MAX_CHIPS, 3);
+    CHECK_EQ(NUM_LED, 192);
+
+    hostReset();
+    hostConfigure(&config);
+    hostSetNv(NV_LED_GROUP_FIRST(0), 60);
+    hostSetNv(NV_LED_GROUP_LAST(0), 70);
+    hostPowerUp();
+    for (i = 0; i < sizeof(routeLeds); i++) {
+        flags = ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF;
+        led = routeLeds[i];
+        if (led > LEDS_PER_BANK) {
+            led -= LEDS_PER_BANK;
+            flags |= ACTION_FLAGS_LED_BANK;
+        }
+        CHECK_EQ(hostTeach(EVENT_NN, ROUTE_EN, 1 + 2*i, led), 0);
+        CHECK_EQ(hostTeach(EVENT_NN, ROUTE_EN, 2 + 2*i, flags), 0);
+    }
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_A_EN, 1, GROUP_A_LED), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_A_EN, 2, ACTION_FLAGS_ENABLEON), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_B_EN, 1, GROUP_B_LED), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_B_EN, 2, ACTION_FLAGS_ENABLEON), 0);
+    hostRunFor(MS_CYCLES(3000));
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        CHECK(maxChips[chip].config & MX_CONF_ENABLE);
+    }
+    maxWriteObserver = watchWrite;
+
+    // the route's six digits go LED_BATCH_DIGITS at a time
+    startWatching();
+    sendEvent(OPC_ACON, ROUTE_EN);
+    hostRunFor(MS_CYCLES(20));
+    for (i = 0; i < sizeof(routeLeds); i++) {
+        CHECK_EQ(hostLedState(routeLeds[i]), 3);
+    }
+    CHECK_EQ(writes, sizeof(routeLeds));
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        CHECK_EQ(chipWrites[chip], 2);
+    }
+    CHECK_EQ(firstFlushWrites, LED_BATCH_DIGITS);
+    CHECK_EQ(flushes, 2);
+
+    startWatching();
+    sendEvent(OPC_ACOF, ROUTE_EN);
+    hostRunFor(MS_CYCLES(20));
+    for (i = 0; i < sizeof(routeLeds); i++) {
+        CHECK_EQ(hostLedState(routeLeds[i]), 0);
+    }
+    CHECK_EQ(writes, sizeof(routeLeds));
+
+    // the group moves from chip 0 to chip 1 in one flush
+    sendEvent(OPC_ACON, GROUP_A_EN);
+    hostRunFor(MS_CYCLES(20));
+    CHECK_EQ(hostLedState(GROUP_A_LED), 3);
+    startWatching();
+    sendEvent(OPC_ACON, GROUP_B_EN);
+    hostRunFor(MS_CYCLES(20));
+    CHECK_EQ(hostLedState(GROUP_A_LED), 0);
+    CHECK_EQ(hostLedState(GROUP_B_LED), 3);
+    CHECK_EQ(chipWrites[0], 1);
+    CHECK_EQ(chipWrites[1], 1);
+    CHECK_EQ(chipWrites[2], 0);
+    CHECK_EQ(flushes, 1);
+
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        CHECK_EQ(maxChips[chip].framingErrors, 0);
+        CHECK_EQ(maxChips[chip].staleLatches, 0);
+    }
+    return testResult();
+}
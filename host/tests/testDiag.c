@@ -0,0 +1,141 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The CANPANEL diagnostics service. RQSD of all services is left to the
+ * library, RQSD and RDGN of PANEL_DIAG_SERVICE_INDEX are answered, reading a
+ * counter leaves it as it is and writing NV_DIAG_CLEAR clears it, every time
+ * it is written.
+ *
+ * Built with PROFILE.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "vlcbMock.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "panelDiag.h"
+#include "profile.h"
+
+#define NODE_NN         256
+#define EVENT_NN        0x0102
+#define NUM_EVENTS_SENT 10
+// the count of consumed events
+#define EVENTS_CODE     (PANEL_DIAG_PROFILE + 4*PROFILE_CONSUMED_EVENT)
+
+static uint8_t sdSent;
+static uint8_t esdSent;
+static int32_t dgnValue;
+
+static void watchFrames(const HostFrame * frame) {
+    if ((frame->data[0] == OPC_SD) && (frame->len == 6)) {
+        sdSent++;
+    }
+    if ((frame->data[0] == OPC_ESD) && (frame->len == 8) && (frame->data[3] == PANEL_DIAG_SERVICE_INDEX)) {
+        esdSent++;
+    }
+    if ((frame->data[0] == OPC_DGN) && (frame->len == 7) && (frame->data[3] == PANEL_DIAG_SERVICE_INDEX)) {
+        dgnValue = ((uint16_t)frame->data[5] << 8) | frame->data[6];
+    }
+}
+
+static void sendEvents(void) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, 0, 1};
+    uint8_t i;
+
+    for (i = 0; i < NUM_EVENTS_SENT; i++) {
+        CHECK(hostReceiveMessage(5, (i & 1) ? OPC_ACOF : OPC_ACON, bytes));
+        hostRunFor(MS_CYCLES(5));
+    }
+}
+
+static void requestService(uint8_t index) {
+    uint8_t bytes[3] = {NODE_NN >> 8, NODE_NN & 0xFF, index};
+
+    CHECK(hostReceiveMessage(4, OPC_RQSD, bytes));
+    hostRunFor(MS_CYCLES(200));
+}
+
+/**
+ * @return the value of a diagnostic, -1 if there was no DGN
+ */
+static int32_t readDiagnostic(uint8_t code) {
+    uint8_t bytes[4] = {NODE_NN >> 8, NODE_NN & 0xFF, PANEL_DIAG_SERVICE_INDEX, code};
+
+    dgnValue = -1;
+    CHECK(hostReceiveMessage(5, OPC_RDGN, bytes));
+    hostRunFor(MS_CYCLES(20));
+    return dgnValue;
+}
+
+static void clearDiagnostics(void) {
+    uint8_t bytes[4] = {NODE_NN >> 8, NODE_NN & 0xFF, NV_DIAG_CLEAR, 1};
+
+    CHECK(hostReceiveMessage(5, OPC_NVSET, bytes));
+    hostRunFor(MS_CYCLES(20));
+}
+
+int main(void) {
+    HostConfig config = {NODE_NN, 10, CAN_DEFAULT_BIT_RATE};
+
+    hostReset();
+    hostConfigure(&config);
+    hostPowerUp();
+    CHECK_EQ(hostTeach(EVENT_NN, 1, 1, 1), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, 1, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    hostRunFor(MS_CYCLES(3000));
+    txObserver = watchFrames;
+
+    // the service is described when asked for by its index, not added to the list
+    requestService(0);
+    CHECK_EQ(sdSent, 0);
+    requestService(PANEL_DIAG_SERVICE_INDEX);
+    CHECK_EQ(esdSent, 1);
+
+    clearDiagnostics();
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), 0);
+    sendEvents();
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), NUM_EVENTS_SENT);
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), NUM_EVENTS_SENT);
+    CHECK_EQ(readDiagnostic(0xFF), -1);
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), NUM_EVENTS_SENT);
+
+    clearDiagnostics();
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), 0);
+    sendEvents();
+    clearDiagnostics();
+    CHECK_EQ(readDiagnostic(EVENTS_CODE), 0);
+
+    return testResult();
+}
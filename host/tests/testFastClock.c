@@ -0,0 +1,115 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * A replay of fast clock messages. Only the digits which change are written,
+ * each as its digit write and the NOP after it, so the SPI transactions for
+ * every fast minute are known exactly.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelNv.h"
+#include "panelModel.h"
+#include "fastClock.h"
+
+#define WINDOW      3           // NV_FAST_CLOCK, the clock is on digits 2 to 5
+
+/**
+ * Send an FCLK and count the transactions it causes.
+ */
+static uint32_t fclk(uint8_t hours, uint8_t mins) {
+    uint8_t bytes[6] = {mins, hours, 0, 1, 1, 0};
+    uint32_t before;
+
+    before = maxChips[0].transactions;
+    CHECK(hostReceiveMessage(7, OPC_FCLK, bytes));
+    hostRunFor(MS_CYCLES(5));
+    return maxChips[0].transactions - before;
+}
+
+static void checkShown(uint8_t hours, uint8_t mins) {
+    uint8_t first = WINDOW - 1;
+
+    CHECK_EQ(maxChips[0].plane[0][first], hours / 10);
+    CHECK_EQ(maxChips[0].plane[0][first + 1], (hours % 10) | 0x80);
+    CHECK_EQ(maxChips[0].plane[0][first + 2], mins / 10);
+    CHECK_EQ(maxChips[0].plane[0][first + 3], mins % 10);
+    CHECK_EQ(maxChips[0].plane[1][first + 3], mins % 10);
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint8_t hours;
+    uint8_t mins;
+    uint32_t hour;
+
+    hostReset();
+    hostConfigure(&config);
+    hostSetNv(NV_FAST_CLOCK, WINDOW);
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(3000));
+    CHECK_EQ(maxChips[0].decode, 0x0F << (WINDOW - 1));
+
+    // the first message writes all four digits
+    CHECK_EQ(fclk(9, 58), 8);
+    checkShown(9, 58);
+    // a repeat writes nothing
+    CHECK_EQ(fclk(9, 58), 0);
+    CHECK_EQ(fclk(9, 59), 2);
+    // all four digits change
+    CHECK_EQ(fclk(10, 0), 8);
+    checkShown(10, 0);
+
+    // a whole fast hour, a message each minute
+    hour = 0;
+    hours = 10;
+    for (mins = 1; mins < 60; mins++) {
+        uint32_t n = fclk(hours, mins);
+
+        CHECK_EQ(n, (mins % 10) ? 2 : 4);
+        hour += n;
+    }
+    hour += fclk(11, 0);
+    checkShown(11, 0);
+    // 54 units only, 5 tens and the hour change
+    CHECK_EQ(hour, 54*2 + 5*4 + 6);
+    CHECK_EQ(maxChips[0].framingErrors, 0);
+    CHECK_EQ(maxChips[0].staleLatches, 0);
+
+    // a bad time is ignored
+    CHECK_EQ(fclk(24, 0), 0);
+    CHECK_EQ(fclk(11, 60), 0);
+
+    return testResult();
+}
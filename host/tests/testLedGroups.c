@@ -0,0 +1,148 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * An exclusive LED group moves from one LED to another in a single flush.
+ * The two LEDs are in different digits, so the change is two digit writes,
+ * and in between the panel shows both LEDs lit or neither. That must last
+ * only as long as the writes take, far less than the MAX6951 takes to scan
+ * its digits once, even with other LED changes waiting to be sent.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "panelModel.h"
+
+#define EVENT_NN        0x0102
+#define GROUP_A_EN      1
+#define GROUP_B_EN      2
+#define ROUTE_EN        3
+#define GROUP_A_LED     30      // digit 3
+#define GROUP_B_LED     38      // digit 4
+// digit writes further apart than this are from different flushes
+#define FLUSH_GAP       (100 * CYCLES_PER_US)
+// the longest the panel may show both LEDs or neither
+#define MAX_GLITCH      (20 * CYCLES_PER_US)
+
+// one LED in each of the other digits, outside the group, sent around it
+static const uint8_t routeLeds[] = {4, 12, 20, 44, 52, 60};
+
+static uint32_t writes;
+static uint32_t flushes;
+static uint64_t lastWrite;
+static uint64_t worstGlitch;
+
+/**
+ * Called before each register write is latched, so it sees what the panel
+ * has shown since the previous write.
+ */
+static void watchWrite(uint8_t chip, uint8_t reg, uint8_t value) {
+    uint8_t a;
+    uint8_t b;
+
+    if ((reg & 0x60) == 0) {
+        return;     // not a digit
+    }
+    if ((writes == 0) || (hostNow() - lastWrite > FLUSH_GAP)) {
+        flushes++;
+    }
+    a = hostLedState(GROUP_A_LED) != 0;
+    b = hostLedState(GROUP_B_LED) != 0;
+    if ((writes != 0) && (a == b) && (hostNow() - lastWrite > worstGlitch)) {
+        worstGlitch = hostNow() - lastWrite;
+    }
+    lastWrite = hostNow();
+    writes++;
+}
+
+static void sendEvent(uint8_t opc, uint16_t en) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, (uint8_t)(en >> 8), (uint8_t)(en & 0xFF)};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint8_t i;
+
+    hostReset();
+    hostConfigure(&config);
+    hostSetNv(NV_LED_GROUP_FIRST(0), 25);
+    hostSetNv(NV_LED_GROUP_LAST(0), 40);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_A_EN, 1, GROUP_A_LED), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_A_EN, 2, ACTION_FLAGS_ENABLEON), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_B_EN, 1, GROUP_B_LED), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, GROUP_B_EN, 2, ACTION_FLAGS_ENABLEON), 0);
+    for (i = 0; i < sizeof(routeLeds); i++) {
+        CHECK_EQ(hostTeach(EVENT_NN, ROUTE_EN, 1 + 2*i, routeLeds[i]), 0);
+        CHECK_EQ(hostTeach(EVENT_NN, ROUTE_EN, 2 + 2*i, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    }
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(3000));
+
+    sendEvent(OPC_ACON, GROUP_A_EN);
+    hostRunFor(MS_CYCLES(20));
+    CHECK_EQ(hostLedState(GROUP_A_LED), 3);
+    CHECK_EQ(hostLedState(GROUP_B_LED), 0);
+
+    // A to B on its own
+    maxWriteObserver = watchWrite;
+    sendEvent(OPC_ACON, GROUP_B_EN);
+    hostRunFor(MS_CYCLES(20));
+    CHECK_EQ(hostLedState(GROUP_A_LED), 0);
+    CHECK_EQ(hostLedState(GROUP_B_LED), 3);
+    CHECK_EQ(writes, 2);
+    CHECK_EQ(flushes, 1);
+    CHECK(worstGlitch < MAX_GLITCH);
+
+    // B to A behind a route of more digits than a flush batch
+    writes = 0;
+    flushes = 0;
+    worstGlitch = 0;
+    sendEvent(OPC_ACON, ROUTE_EN);
+    sendEvent(OPC_ACON, GROUP_A_EN);
+    hostRunFor(MS_CYCLES(20));
+    CHECK_EQ(hostLedState(GROUP_A_LED), 3);
+    CHECK_EQ(hostLedState(GROUP_B_LED), 0);
+    for (i = 0; i < sizeof(routeLeds); i++) {
+        CHECK_EQ(hostLedState(routeLeds[i]), 3);
+    }
+    CHECK_EQ(writes, 2 + sizeof(routeLeds));
+    CHECK(worstGlitch < MAX_GLITCH);
+
+    CHECK_EQ(maxChips[0].framingErrors, 0);
+    CHECK_EQ(maxChips[0].staleLatches, 0);
+    return testResult();
+}
@@ -0,0 +1,200 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The LED remap table is read and written through its NV window, with the
+ * value NV read from the table of the selected LED. Remapping a lit LED
+ * moves it, and the table is kept in the EEPROM for the next power up, which
+ * is run in this process with the EEPROM left by the first run in a child.
+ *
+ * @date October 2026
+ */
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include "hostTest.h"
+#include "vlcb.h"
+#include "vlcbMock.h"
+#include "panelNv.h"
+#include "panelEvents.h"
+
+#define NODE_NN     256
+#define EVENT_NN    0x0102
+#define EVENT_EN    7
+#define LED         5
+#define WIRED_AS    12
+
+static int16_t nvAnswer;
+
+static void watchNvans(const HostFrame * frame) {
+    if ((frame->len == 5) && (frame->data[0] == OPC_NVANS) && (frame->data[3] == NV_LED_MAP_VALUE)) {
+        nvAnswer = frame->data[4];
+    }
+}
+
+static void setNv(uint8_t index, uint8_t value) {
+    uint8_t bytes[4] = {NODE_NN >> 8, NODE_NN & 0xFF, index, value};
+
+    CHECK(hostReceiveMessage(5, OPC_NVSET, bytes));
+    hostRunFor(MS_CYCLES(20));
+}
+
+/**
+ * @return the value read by a NVRD of NV_LED_MAP_VALUE, -1 if there was no answer
+ */
+static int16_t readMapValue(void) {
+    uint8_t bytes[3] = {NODE_NN >> 8, NODE_NN & 0xFF, NV_LED_MAP_VALUE};
+
+    nvAnswer = -1;
+    CHECK(hostReceiveMessage(4, OPC_NVRD, bytes));
+    hostRunFor(MS_CYCLES(20));
+    return nvAnswer;
+}
+
+static void sendEvent(uint8_t opc) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, EVENT_EN >> 8, EVENT_EN & 0xFF};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+    hostRunFor(MS_CYCLES(20));
+}
+
+static void startNode(void) {
+    HostConfig config = {NODE_NN, 10, CAN_DEFAULT_BIT_RATE};
+
+    hostConfigure(&config);
+    hostTeach(EVENT_NN, EVENT_EN, 1, LED);
+    hostTeach(EVENT_NN, EVENT_EN, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF);
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(3000));
+    txObserver = watchNvans;
+}
+
+/**
+ * The first power up of a blank node, which sets up the table.
+ */
+static void firstRun(void) {
+    HostStats before;
+    HostStats after;
+
+    hostReset();
+    startNode();
+
+    setNv(NV_LED_MAP_SELECT, LED);
+    CHECK_EQ(readMapValue(), 0);
+    setNv(NV_LED_MAP_VALUE, WIRED_AS);
+    CHECK_EQ(readMapValue(), WIRED_AS);
+
+    // selecting another LED shows its entry and writes only the selection
+    hostGetStats(&before);
+    setNv(NV_LED_MAP_SELECT, LED + 1);
+    hostGetStats(&after);
+    CHECK_EQ(after.eepromWrites - before.eepromWrites, 1);
+    CHECK_EQ(readMapValue(), 0);
+
+    // the value last written is still in the NV, it must be set for this LED too
+    setNv(NV_LED_MAP_VALUE, WIRED_AS);
+    CHECK_EQ(readMapValue(), WIRED_AS);
+
+    setNv(NV_LED_MAP_SELECT, LED);
+    CHECK_EQ(readMapValue(), WIRED_AS);
+    setNv(NV_LED_MAP_VALUE, 0);
+    CHECK_EQ(readMapValue(), 0);
+    setNv(NV_LED_MAP_SELECT, LED + 1);
+    CHECK_EQ(readMapValue(), WIRED_AS);
+    setNv(NV_LED_MAP_VALUE, 0);
+
+    // a lit LED moves with its entry
+    sendEvent(OPC_ACON);
+    CHECK_EQ(hostLedState(LED), 3);
+    setNv(NV_LED_MAP_SELECT, LED);
+    setNv(NV_LED_MAP_VALUE, WIRED_AS);
+    CHECK_EQ(hostLedState(LED), 0);
+    CHECK_EQ(hostLedState(WIRED_AS), 3);
+    sendEvent(OPC_ACOF);
+    CHECK_EQ(hostLedState(WIRED_AS), 0);
+}
+
+/**
+ * The next power up, with the EEPROM of the first.
+ */
+static void secondRun(const uint8_t * eeprom) {
+    uint16_t a;
+
+    hostReset();
+    for (a = 0; a < HOST_EEPROM_SIZE; a++) {
+        libSetEeprom(a, eeprom[a]);
+    }
+    startNode();
+
+    CHECK_EQ(readMapValue(), WIRED_AS);
+    sendEvent(OPC_ACON);
+    CHECK_EQ(hostLedState(LED), 0);
+    CHECK_EQ(hostLedState(WIRED_AS), 3);
+}
+
+int main(void) {
+    uint8_t eeprom[HOST_EEPROM_SIZE];
+    uint16_t a;
+    size_t len;
+    ssize_t n;
+    int fds[2];
+    int status;
+    pid_t pid;
+
+    if ((pipe(fds) != 0) || ((pid = fork()) < 0)) {
+        CHECK(0);
+        return testResult();
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        firstRun();
+        for (a = 0; a < HOST_EEPROM_SIZE; a++) {
+            eeprom[a] = libGetEeprom(a);
+        }
+        if (write(fds[1], eeprom, sizeof(eeprom)) != sizeof(eeprom)) {
+            CHECK(0);
+        }
+        close(fds[1]);
+        _exit(testResult());
+    }
+    close(fds[1]);
+    len = 0;
+    while ((len < sizeof(eeprom)) && ((n = read(fds[0], eeprom + len, sizeof(eeprom) - len)) > 0)) {
+        len += n;
+    }
+    close(fds[0]);
+    CHECK((waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+    CHECK_EQ(len, sizeof(eeprom));
+    if (len == sizeof(eeprom)) {
+        secondRun(eeprom);
+    }
+    return testResult();
+}
@@ -0,0 +1,257 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Timed LED actions. A timed action turns its LED off after its
+ * NV_LED_DURATION, a later action for the LED cancels the timer, and every
+ * LED can have a timer pending at once.
+ *
+ * Starting, cancelling and expiring a timer are timed with no other timers
+ * pending and with a timer pending for every other LED, in the same slot
+ * for starting and cancelling and in the other slots for expiring. They
+ * must cost the same in the host's cycles and take about the same time on
+ * the host's CPU. The RAM of the wheel, from the symbols of its object
+ * file, must be LED_TIMER_RAM.
+ *
+ * @date October 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "ledTimer.h"
+
+#define EVENT_NN        0x0102
+#define TIMED_EN(led)   (led)           // turns the LED on for NV_LED_DURATION(1)
+#define STEADY_EN       (NUM_LED + 1)   // turns LED 1 on and off
+#define DURATION        10              // NV_LED_DURATION(1), in LED_TIMER_TICKs
+#define REPEATS         20000
+// most the CPU time of an operation may grow with every other timer pending
+#define CPU_TOLERANCE   2.0
+
+static void sendEvent(uint8_t opc, uint16_t en) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, (uint8_t)(en >> 8), (uint8_t)(en & 0xFF)};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+    hostRunFor(MS_CYCLES(5));
+}
+
+static double cpuSeconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Pend a timer for every LED but the first, all in the same slot.
+ */
+static void pendOthers(uint8_t ticks) {
+    uint8_t led;
+
+    for (led = 2; led <= NUM_LED; led++) {
+        ledTimerStart(led, ticks);
+    }
+}
+
+static void cancelAll(void) {
+    uint8_t led;
+
+    for (led = 1; led <= NUM_LED; led++) {
+        ledTimerCancel(led);
+    }
+}
+
+/**
+ * @return the host cycles of starting and then cancelling the timer of LED 1
+ */
+static uint64_t startCancelCycles(void) {
+    uint64_t start;
+
+    start = hostNow();
+    ledTimerStart(1, DURATION);
+    ledTimerCancel(1);
+    return hostNow() - start;
+}
+
+/**
+ * @return the CPU time of REPEATS starts and cancels of the timer of LED 1,
+ * the least of several tries
+ */
+static double startCancelSeconds(void) {
+    double best;
+    double t;
+    uint8_t tries;
+    uint16_t i;
+
+    best = 1e9;
+    for (tries = 0; tries < 5; tries++) {
+        t = cpuSeconds();
+        for (i = 0; i < REPEATS; i++) {
+            ledTimerStart(1, DURATION);
+            ledTimerCancel(1);
+        }
+        t = cpuSeconds() - t;
+        if (t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+/**
+ * @return the host cycles of the tick which expires the timer of LED 1
+ */
+static uint64_t expireCycles(void) {
+    uint64_t start;
+    uint8_t ticks;
+
+    ledTimerStart(1, 1);
+    for (ticks = 0; ledTimerPending(1) && (ticks < 3); ticks++) {
+        hostRunFor(MS_CYCLES(LED_TIMER_TICK));
+        start = hostNow();
+        ledTimerPoll();
+        if ( ! ledTimerPending(1)) {
+            return hostNow() - start;
+        }
+    }
+    CHECK(0);
+    return 0;
+}
+
+/**
+ * @return the RAM of the wheel, the sizes of the data symbols of ledTimer.o
+ * which is in the fw directory beside the test's own
+ */
+static long wheelRam(const char * argv0) {
+    char command[512];
+    char line[256];
+    char type;
+    unsigned long size;
+    long total;
+    FILE * nm;
+    const char * slash;
+
+    slash = strrchr(argv0, '/');
+    snprintf(command, sizeof(command), "nm -S %.*s/../fw/ledTimer.o",
+            slash ? (int)(slash - argv0) : 1, slash ? argv0 : ".");
+    nm = popen(command, "r");
+    if (nm == NULL) {
+        return -1;
+    }
+    total = 0;
+    while (fgets(line, sizeof(line), nm) != NULL) {
+        if ((sscanf(line, "%*x %lx %c", &size, &type) == 2) && strchr("bBdD", type)) {
+            total += (long)size;
+        }
+    }
+    if (pclose(nm) != 0) {
+        return -1;
+    }
+    return total;
+}
+
+int main(int argc, char ** argv) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint64_t alone;
+    double aloneSeconds;
+    double crowdSeconds;
+    uint16_t led;
+    uint8_t pending;
+
+    hostReset();
+    hostConfigure(&config);
+    hostSetNv(NV_LED_DURATION(1), DURATION);
+    for (led = 1; led <= NUM_LED; led++) {
+        CHECK_EQ(hostTeach(EVENT_NN, TIMED_EN(led), 1, led), 0);
+        CHECK_EQ(hostTeach(EVENT_NN, TIMED_EN(led), 2, ACTION_FLAGS_ENABLEON | (1 << ACTION_FLAGS_TIMER_SHIFT)), 0);
+    }
+    CHECK_EQ(hostTeach(EVENT_NN, STEADY_EN, 1, 1), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, STEADY_EN, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(3000));
+
+    // on, then off once the duration is up, give or take a tick
+    sendEvent(OPC_ACON, TIMED_EN(1));
+    CHECK_EQ(hostLedState(1), 3);
+    hostRunFor(MS_CYCLES((DURATION - 1) * LED_TIMER_TICK - 20));
+    CHECK_EQ(hostLedState(1), 3);
+    hostRunFor(MS_CYCLES(LED_TIMER_TICK + 40));
+    CHECK_EQ(hostLedState(1), 0);
+
+    // a later action for the LED cancels the timer
+    sendEvent(OPC_ACON, TIMED_EN(1));
+    sendEvent(OPC_ACON, STEADY_EN);
+    CHECK( ! ledTimerPending(1));
+    hostRunFor(MS_CYCLES(2 * DURATION * LED_TIMER_TICK));
+    CHECK_EQ(hostLedState(1), 3);
+    sendEvent(OPC_ACOF, STEADY_EN);
+    CHECK_EQ(hostLedState(1), 0);
+
+    // every LED at once
+    for (led = 1; led <= NUM_LED; led++) {
+        sendEvent(OPC_ACON, TIMED_EN(led));
+    }
+    pending = 0;
+    for (led = 1; led <= NUM_LED; led++) {
+        CHECK_EQ(hostLedState(led), 3);
+        pending += ledTimerPending(led);
+    }
+    CHECK_EQ(pending, NUM_LED);
+    hostRunFor(MS_CYCLES(DURATION * LED_TIMER_TICK + 50));
+    for (led = 1; led <= NUM_LED; led++) {
+        CHECK_EQ(hostLedState(led), 0);
+        CHECK( ! ledTimerPending(led));
+    }
+
+    // starting and cancelling, alone and with every other LED in the same slot
+    alone = startCancelCycles();
+    aloneSeconds = startCancelSeconds();
+    pendOthers(DURATION);
+    CHECK_EQ(startCancelCycles(), alone);
+    crowdSeconds = startCancelSeconds();
+    CHECK(crowdSeconds < aloneSeconds * CPU_TOLERANCE);
+    cancelAll();
+
+    // expiring, alone and with every other LED pending in the other slots
+    alone = expireCycles();
+    CHECK(alone > 0);
+    pendOthers(LED_TIMER_SLOTS / 2);
+    CHECK_EQ(expireCycles(), alone);
+    cancelAll();
+
+    CHECK_EQ(wheelRam(argc > 0 ? argv[0] : "."), (long)LED_TIMER_RAM);
+    return testResult();
+}
@@ -0,0 +1,89 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * An LED is turned on and off by a consumed event, checked through the
+ * MAX6951 model's registers.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelModel.h"
+#include "max6951.h"
+
+#define EVENT_NN    0x0102
+#define EVENT_EN    7
+#define LED         5
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, EVENT_EN >> 8, EVENT_EN & 0xFF};
+    uint32_t before;
+
+    hostReset();
+    hostConfigure(&config);
+    hostPowerUp();
+    CHECK_EQ(hostTeach(EVENT_NN, EVENT_EN, 1, LED), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, EVENT_EN, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    hostRunFor(MS_CYCLES(3000));
+
+    CHECK(maxChips[0].config & MX_CONF_ENABLE);
+    CHECK_EQ(maxChips[0].framingErrors, 0);
+    CHECK_EQ(maxChips[0].staleLatches, 0);
+    CHECK_EQ(hostLedState(LED), 0);
+
+    before = maxChips[0].transactions;
+    CHECK(hostReceiveMessage(5, OPC_ACON, bytes));
+    hostRunFor(MS_CYCLES(10));
+    CHECK_EQ(hostLedState(LED), 3);
+    CHECK_EQ(hostLedState(LED + 1), 0);
+    // the digit write and the NOP which follows it
+    CHECK_EQ(maxChips[0].transactions - before, 2);
+
+    before = maxChips[0].transactions;
+    CHECK(hostReceiveMessage(5, OPC_ACOF, bytes));
+    hostRunFor(MS_CYCLES(10));
+    CHECK_EQ(hostLedState(LED), 0);
+    CHECK_EQ(maxChips[0].transactions - before, 2);
+
+    // an event which isn't taught changes nothing
+    before = maxChips[0].transactions;
+    bytes[3]++;
+    CHECK(hostReceiveMessage(5, OPC_ACON, bytes));
+    hostRunFor(MS_CYCLES(10));
+    CHECK_EQ(maxChips[0].transactions - before, 0);
+    CHECK_EQ(maxChips[0].staleLatches, 0);
+
+    return testResult();
+}
@@ -0,0 +1,111 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The key scan interrupt and the LED SPI share PORTC. With LED traffic and
+ * button presses going on together the port arbiter must never let the
+ * interrupt strobe a column whilst a MAX chip is selected, nor clock bits into
+ * one.
+ *
+ * Built with KEYSCAN_ISR.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "panelModel.h"
+#include "sfrMock.h"
+
+#define EVENT_NN    0x0102
+#define NUM_TAUGHT  32
+
+static void event(uint8_t opc, uint16_t en) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, en >> 8, en & 0xFF};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    HostStats stats;
+    uint16_t en;
+    uint16_t i;
+    uint32_t before;
+
+    hostReset();
+    hostConfigure(&config);
+    for (i = 0; i < NUM_PB; i++) {
+        hostSetNv(NV_PB_FLAGS + i, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF);
+    }
+    hostPowerUp();
+    for (en = 1; en <= NUM_TAUGHT; en++) {
+        CHECK_EQ(hostTeach(EVENT_NN, en, 1, (uint8_t)(2*en - 1)), 0);
+        CHECK_EQ(hostTeach(EVENT_NN, en, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    }
+    hostRunFor(MS_CYCLES(3000));
+
+    // an event every ms, 63 passes over the events turning them on and off,
+    // with buttons going up and down
+    for (i = 0; i < 63*NUM_TAUGHT; i++) {
+        en = (uint16_t)(i % NUM_TAUGHT + 1);
+        event(((i / NUM_TAUGHT) & 1) ? OPC_ACOF : OPC_ACON, en);
+        if (i % 50 == 0) {
+            hostSetButton((uint8_t)(i / 50 % NUM_PB), (i / 50) & 1);
+        }
+        hostRunFor(MS_CYCLES(1));
+    }
+    hostRunFor(MS_CYCLES(100));
+    hostGetStats(&stats);
+
+    CHECK(stats.interrupts > 1000);
+    CHECK(stats.spiTransactions > 1000);
+    CHECK_EQ(stats.isrWithChipSelected, 0);
+    CHECK_EQ(stats.spiInIsr, 0);
+    CHECK_EQ(stats.framingErrors, 0);
+    CHECK_EQ(stats.staleLatches, 0);
+    CHECK_EQ(stats.missedInterrupts, 0);
+    // the last pass turned them all on
+    for (en = 1; en <= NUM_TAUGHT; en++) {
+        CHECK_EQ(hostLedState((uint8_t)(2*en - 1)), 3);
+    }
+
+    // negative control, select the MAX chip behind the arbiter's back
+    before = pinConflicts.isrWithChipSelected;
+    LATCbits.LATC6 = 0;
+    hostRunFor(MS_CYCLES(20));
+    CHECK(pinConflicts.isrWithChipSelected > before);
+    LATCbits.LATC6 = 1;
+
+    return testResult();
+}
@@ -0,0 +1,92 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The cycle budget profile measured by the firmware, checked against what the
+ * host build saw. The counts must agree exactly and the times must be within
+ * the resolution of Timer 1 and the profiling overhead.
+ *
+ * Built with PROFILE.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelModel.h"
+#include "profile.h"
+#include "hostProfile.h"
+
+#define EVENT_NN        0x0102
+#define NUM_EVENTS_SENT 500
+#define CYCLES_PER_COUNT    8       // Timer 1 runs at Fosc/4 with a 1:8 prescale
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    HostStats stats;
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, 0, 1};
+    uint16_t i;
+    uint32_t commands;
+
+    hostReset();
+    hostConfigure(&config);
+    hostPowerUp();
+    CHECK_EQ(hostTeach(EVENT_NN, 1, 1, 1), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, 1, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    hostRunFor(MS_CYCLES(3000));
+    resetProfile();
+    commands = maxChips[0].transactions - maxChips[0].nops;
+
+    for (i = 0; i < NUM_EVENTS_SENT; i++) {
+        CHECK(hostReceiveMessage(5, (i & 1) ? OPC_ACOF : OPC_ACON, bytes));
+        hostRunFor(MS_CYCLES(2));
+    }
+    hostGetStats(&stats);
+    hostProfileJson(stdout);
+    printf("\n");
+
+    CHECK_EQ(profileTable[PROFILE_CONSUMED_EVENT].count, NUM_EVENTS_SENT);
+    // each write to a MAX chip is followed by a NOP, which isn't profiled
+    CHECK_EQ(profileTable[PROFILE_MX_CMD].count, maxChips[0].transactions - maxChips[0].nops - commands);
+    CHECK(profileTable[PROFILE_MX_CMD].count >= NUM_EVENTS_SENT);
+    CHECK(profileTable[PROFILE_LOOP].count > 0);
+    CHECK(profileTable[PROFILE_KEYSCAN_ISR].count > 0);
+    // the interrupt's entry and exit aren't in its region
+    CHECK((uint32_t)profileTable[PROFILE_KEYSCAN_ISR].max*CYCLES_PER_COUNT <= stats.worstInterruptCycles);
+    CHECK((uint32_t)profileTable[PROFILE_KEYSCAN_ISR].max*CYCLES_PER_COUNT + COST_INTERRUPT + 2*CYCLES_PER_COUNT >= stats.worstInterruptCycles);
+    // consumed events are handled by poll(), outside loop(), and the host
+    // times the two together
+    CHECK((uint32_t)profileTable[PROFILE_LOOP].max*CYCLES_PER_COUNT <= stats.worstLoopCycles);
+    CHECK((uint32_t)profileTable[PROFILE_CONSUMED_EVENT].max*CYCLES_PER_COUNT <= stats.worstLoopCycles);
+
+    return testResult();
+}
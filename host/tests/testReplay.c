@@ -0,0 +1,123 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * GridConnect frames are read and written, and a log teaching an LED then
+ * turning it on and off is replayed, checking the timeline it gives.
+ *
+ * @date October 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "hostTest.h"
+#include "hostReplay.h"
+
+static const char log[] =
+    "# teach 0102:0007 to LED 5 then turn it on and off\n"
+    "12:30:00.000 :SBFA0N530100;\n"
+    "12:30:00.050 :SBFA0ND2010200070205;\n"
+    "12:30:00.100 :SBFA0ND2010200070303;\n"
+    "12:30:00.150 :SBFA0N540100;\n"
+    "12:30:01.150 :SB400N9001020007;\n"
+    "not a frame\n"
+    "12:30:01.650 :SB400N9101020007;\n";
+
+/**
+ * @return the time of the timeline line which has the text, or -1
+ */
+static double findLine(const char * timeline, const char * text) {
+    const char * p;
+    const char * line;
+
+    p = strstr(timeline, text);
+    if (p == NULL) {
+        return -1;
+    }
+    for (line = p; (line > timeline) && (line[-1] != '\n'); line--) {
+    }
+    return atof(line);
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    HostFrame frame;
+    char text[CAN_TEXT_SIZE];
+    double seconds;
+    char * timeline;
+    size_t size;
+    FILE * in;
+    FILE * out;
+
+    // the SID is the identifier in the top eleven bits
+    CHECK(canFrameParse(":SB020N9001020007;", &frame) != NULL);
+    CHECK_EQ(frame.id, 0xB020 >> 5);
+    CHECK_EQ(frame.len, 5);
+    CHECK_EQ(frame.data[0], 0x90);
+    CHECK_EQ(frame.data[4], 0x07);
+    canFrameText(&frame, text);
+    CHECK(strcmp(text, ":SB020N9001020007;") == 0);
+    CHECK(canFrameParse(":X0000N00;", &frame) == NULL);
+    CHECK(canFrameParse(":SB020N900;", &frame) == NULL);
+
+    seconds = 0;
+    CHECK(replayParseLine("01:02:03.500 :SB020N90;", &seconds, &frame));
+    CHECK_EQ(seconds * 1000, 3723500);
+    CHECK(replayParseLine("4.25 :SB020N90;", &seconds, &frame));
+    CHECK_EQ(seconds * 1000, 4250);
+    CHECK(replayParseLine(":SB020N90;", &seconds, &frame));
+    CHECK_EQ(seconds * 1000, 4250);
+    CHECK(! replayParseLine("# :SB020", &seconds, &frame));
+
+    hostReset();
+    hostConfigure(&config);
+    hostPowerUp();
+    hostRunFor(MS_CYCLES(3000));
+    in = fmemopen((void *)log, sizeof(log) - 1, "r");
+    out = open_memstream(&timeline, &size);
+    CHECK_EQ(hostReplay(in, out, 0), 6);
+    fclose(in);
+    fclose(out);
+
+    // each EVLRN is acknowledged, then the event turns the LED on and off
+    CHECK(findLine(timeline, "rx :SBFA0ND2010200070205;") == 50);
+    CHECK(strstr(timeline, "N590100;") != NULL);
+    CHECK(findLine(timeline, "led 5 on") >= 1150);
+    CHECK(findLine(timeline, "led 5 on") < 1160);
+    CHECK(findLine(timeline, "led 5 off") >= 1650);
+    CHECK(findLine(timeline, "led 5 off") < 1660);
+    CHECK(strstr(timeline, "led 6") == NULL);
+    if (testFailures) {
+        fputs(timeline, stdout);
+    }
+    free(timeline);
+    return testResult();
+}
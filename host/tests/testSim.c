@@ -0,0 +1,127 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * 64 panels on one simulated bus. Each sends its start of day, which must
+ * reach every other panel, the frames must follow one another on the bus,
+ * and the simulation must run faster than real time.
+ *
+ * @date October 2026
+ */
+
+#include <time.h>
+#include "hostTest.h"
+#include "hostSim.h"
+#include "panelEvents.h"
+#include "startup.h"
+
+#define NODES       64
+// from the end of the power ups, the latest a SOD is due and time to send them
+#define WINDOW_MS   (STARTUP_MIN_DELAY + STARTUP_STAGGER_WINDOW + 500)
+#define PANEL_NN(i) (256 + (i))
+
+static uint64_t lastEnd;
+static uint32_t overlaps;
+static uint32_t early;
+static uint16_t sods[NODES];
+
+static void frameDone(uint16_t node, const HostFrame * frame, uint64_t start, uint64_t end) {
+    if (start < lastEnd) {
+        overlaps++;
+    }
+    if (start < frame->time) {
+        early++;
+    }
+    lastEnd = end;
+    // the SOD event, an ACON of event 1
+    if ((frame->data[0] == OPC_ACON) && (frame->data[3] == 0) && (frame->data[4] == 1)) {
+        sods[node]++;
+    }
+}
+
+static double wallSeconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    HostConfig config = {0, 0, 0};
+    const HostNodeApi * node;
+    HostStats nodeStats;
+    SimStats s;
+    double wall;
+    uint64_t powerUpTime;
+    uint16_t i;
+    uint32_t received;
+
+    if (simOpen(NODE_LIBRARY, NODES, CAN_DEFAULT_BIT_RATE) != 0) {
+        CHECK(0);
+        return testResult();
+    }
+    for (i = 0; i < NODES; i++) {
+        node = simNode(i);
+        config.nodeNumber = PANEL_NN(i);
+        config.canId = (uint8_t)(i + 1);
+        node->configure(&config);
+        node->powerUp();
+        node->teach(PANEL_NN(i), 1, 0, HAPPENING_SOD);
+    }
+    simFrameObserver = frameDone;
+    // the power up of a blank node takes longer with more LEDs to set up
+    powerUpTime = simSync();
+
+    wall = wallSeconds();
+    simRunUntil(powerUpTime + MS_CYCLES(WINDOW_MS));
+    wall = wallSeconds() - wall;
+    CHECK(wall < WINDOW_MS / 1000.0);
+
+    simGetStats(&s);
+    CHECK_EQ(overlaps, 0);
+    CHECK_EQ(early, 0);
+    for (i = 0; i < NODES; i++) {
+        CHECK_EQ(sods[i], 1);
+    }
+    CHECK(s.frames >= NODES);
+    CHECK(s.busyCycles < MS_CYCLES(WINDOW_MS));
+    CHECK_EQ(s.rxDrops, 0);
+    CHECK_EQ(s.txDrops, 0);
+    // every panel has every other panel's SOD
+    received = 0;
+    for (i = 0; i < NODES; i++) {
+        simNode(i)->getStats(&nodeStats);
+        received += nodeStats.messagesReceived;
+    }
+    CHECK(received >= NODES * (NODES - 1));
+    simClose();
+    return testResult();
+}
@@ -0,0 +1,139 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The EEPROM snapshot of the LED and toggle states. A change to an LED, to
+ * an LED's timer or to a toggle button is written once it has been quiet for
+ * SNAPSHOT_QUIET_TIME, and nothing is written while nothing changes. With
+ * nothing changed a poll does not look at the LEDs again, so it costs far
+ * less than a call for each LED, however many LEDs are lit or timed.
+ *
+ * Built with LED_SNAPSHOT.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "hostCosts.h"
+#include "vlcb.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "ledSnapshot.h"
+#include "ledTimer.h"
+
+#define EVENT_NN        0x0102
+#define STEADY_EN       1       // turns LED 1 on and off
+#define TIMED_EN        2       // turns LED 2 on for NV_LED_DURATION(1)
+#define ALL_EN          3       // turns every LED on for NV_LED_DURATION(1)
+#define TOGGLE_PB       0
+#define QUIET_MS        (3000)  // more than SNAPSHOT_QUIET_TIME
+
+static void sendEvent(uint8_t opc, uint16_t en) {
+    uint8_t bytes[4] = {EVENT_NN >> 8, EVENT_NN & 0xFF, (uint8_t)(en >> 8), (uint8_t)(en & 0xFF)};
+
+    CHECK(hostReceiveMessage(5, opc, bytes));
+    hostRunFor(MS_CYCLES(20));
+}
+
+/**
+ * @return the EEPROM writes while things are left quiet
+ */
+static uint32_t quietWrites(void) {
+    HostStats before;
+    HostStats after;
+
+    hostGetStats(&before);
+    hostRunFor(MS_CYCLES(QUIET_MS));
+    hostGetStats(&after);
+    return after.eepromWrites - before.eepromWrites;
+}
+
+/**
+ * @return the host cycles of a poll
+ */
+static uint64_t pollCycles(void) {
+    uint64_t start;
+
+    start = hostNow();
+    snapshotPoll();
+    return hostNow() - start;
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint64_t idle;
+    uint16_t led;
+
+    hostReset();
+    hostConfigure(&config);
+    hostSetNv(NV_PANEL_FLAGS, NV_PANEL_FLAGS_SNAPSHOT);
+    hostSetNv(NV_LED_DURATION(1), 100);
+    hostSetNv(NV_PB_FLAGS + TOGGLE_PB, NV_PB_FLAGS_TOGGLE);
+    CHECK_EQ(hostTeach(EVENT_NN, STEADY_EN, 1, 1), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, STEADY_EN, 2, ACTION_FLAGS_ENABLEON | ACTION_FLAGS_ENABLEOFF), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, TIMED_EN, 1, 2), 0);
+    CHECK_EQ(hostTeach(EVENT_NN, TIMED_EN, 2, ACTION_FLAGS_ENABLEON | (1 << ACTION_FLAGS_TIMER_SHIFT)), 0);
+    hostPowerUp();
+    // the first snapshot of a blank EEPROM
+    CHECK(quietWrites() > 0);
+    CHECK_EQ(quietWrites(), 0);
+
+    // an LED
+    sendEvent(OPC_ACON, STEADY_EN);
+    CHECK(quietWrites() > 0);
+    CHECK_EQ(quietWrites(), 0);
+
+    // a timed LED is saved as off, until its timer is cancelled
+    sendEvent(OPC_ACON, TIMED_EN);
+    CHECK_EQ(hostLedState(2), 3);
+    CHECK_EQ(quietWrites(), 0);
+    ledTimerCancel(2);
+    CHECK(quietWrites() > 0);
+
+    // a toggle button
+    hostSetButton(TOGGLE_PB, 1);
+    hostRunFor(MS_CYCLES(200));
+    hostSetButton(TOGGLE_PB, 0);
+    CHECK(quietWrites() > 0);
+    CHECK_EQ(quietWrites(), 0);
+
+    // an idle poll, then with every LED lit and timed
+    idle = pollCycles();
+    CHECK(idle < NUM_LED * COST_FUNCTION_CALL);
+    for (led = 1; led <= NUM_LED; led++) {
+        setOn((uint8_t)led);
+        ledTimerStart((uint8_t)led, 255);
+    }
+    quietWrites();
+    CHECK_EQ(pollCycles(), idle);
+
+    return testResult();
+}
@@ -0,0 +1,136 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The start of day of 64 panels powered up together. Each panel's SOD asks
+ * the panel before it for its buttons. The SODs must be spread over the
+ * power up wait, none later than it, and the bus must never be saturated
+ * for a whole interval of the load curve.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "hostSim.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "startup.h"
+
+#define NODES       64
+#define BUTTONS     8
+#define SECONDS     3
+#define BUCKET_MS   100
+#define PANEL_NN(i) (256 + (i))
+#define SOD_EN      1
+#define BUTTON_EN(pb)   (100 + (pb))
+
+static uint64_t powerUpTime;
+static uint64_t firstSod;
+static uint64_t lastSod;
+static uint16_t sods;
+
+static void frameDone(uint16_t node, const HostFrame * frame, uint64_t start, uint64_t end) {
+    uint64_t t;
+
+    if ((frame->data[0] == OPC_ACON) && (frame->data[3] == 0) && (frame->data[4] == SOD_EN)) {
+        t = frame->time - powerUpTime;
+        if (sods == 0 || t < firstSod) {
+            firstSod = t;
+        }
+        if (t > lastSod) {
+            lastSod = t;
+        }
+        sods++;
+    }
+}
+
+int main(void) {
+    HostConfig config = {0, 0, 0};
+    const HostNodeApi * node;
+    const SimLoadCurve * curve;
+    SimStats s;
+    uint16_t i;
+    uint16_t next;
+    uint8_t pb;
+    uint64_t peak;
+
+    if (simOpen(NODE_LIBRARY, NODES, CAN_DEFAULT_BIT_RATE) != 0) {
+        CHECK(0);
+        return testResult();
+    }
+    for (i = 0; i < NODES; i++) {
+        node = simNode(i);
+        next = (i + 1) % NODES;
+        config.nodeNumber = PANEL_NN(i);
+        config.canId = (uint8_t)(i + 1);
+        node->configure(&config);
+        for (pb = 0; pb < BUTTONS; pb++) {
+            node->setNv(NV_PB_FLAGS + pb, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF | NV_PB_FLAGS_ENABLE_SOD);
+            node->teach(PANEL_NN(i), BUTTON_EN(pb), 0, PB_2_HAPPENING(pb));
+        }
+        node->teach(PANEL_NN(i), SOD_EN, 0, HAPPENING_SOD);
+        node->teach(PANEL_NN(next), SOD_EN, 1, ACTION_SPECIALS);
+        node->teach(PANEL_NN(next), SOD_EN, 2, ACTION_SPECIAL_SOD);
+        node->powerUp();
+    }
+    powerUpTime = simSync();
+    CHECK_EQ(simLoadCurve(MS_CYCLES(BUCKET_MS), SECONDS * 1000 / BUCKET_MS), 0);
+    simFrameObserver = frameDone;
+    simRunUntil(powerUpTime + MS_CYCLES(SECONDS * 1000));
+
+    CHECK_EQ(sods, NODES);
+    // the time is from the end of the power up, a little after the wait started
+    CHECK(firstSod + MS_CYCLES(STARTUP_STAGGER_SLOT) >= MS_CYCLES(STARTUP_MIN_DELAY));
+    CHECK(lastSod <= MS_CYCLES(2000));
+    CHECK(lastSod - firstSod >= MS_CYCLES(STARTUP_STAGGER_WINDOW) * 3 / 4);
+
+    // the SODs and the buttons sent for them
+    simGetStats(&s);
+    CHECK(s.frames >= NODES * (1 + BUTTONS));
+    CHECK_EQ(s.rxDrops, 0);
+    CHECK_EQ(s.txDrops, 0);
+
+    curve = simGetLoadCurve();
+    peak = 0;
+    for (i = 0; i < curve->buckets; i++) {
+        if (curve->busy[i] > peak) {
+            peak = curve->busy[i];
+        }
+    }
+    CHECK(peak < curve->bucketCycles);
+    if (testFailures) {
+        for (i = 0; i < curve->buckets; i++) {
+            printf("%8u %6.2f\n", i * BUCKET_MS, 100.0 * curve->busy[i] / curve->bucketCycles);
+        }
+    }
+    simClose();
+    return testResult();
+}
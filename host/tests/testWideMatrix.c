@@ -0,0 +1,112 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * A 16 column key matrix, 8 of the columns from the 74HC595 chain, giving 128
+ * buttons. Buttons either side of the native and extra columns send their
+ * own happenings, and a full scan stays within the key scan interval.
+ *
+ * Built with EXTRA_COLUMNS 8.
+ *
+ * @date October 2026
+ */
+
+#include "hostTest.h"
+#include "vlcb.h"
+#include "matrix.h"
+#include "panelEvents.h"
+#include "panelNv.h"
+#include "scheduler.h"
+#include "buttonscan.h"
+
+#define EVENT_NN    0x0200
+
+static const uint8_t testPbs[] = {0, 7, 63, 64, 71, 120, 127};
+
+static uint8_t lastOpc;
+static uint16_t lastEn;
+static uint16_t sent;
+
+static void sentFrame(const HostFrame * frame) {
+    lastOpc = frame->data[0];
+    lastEn = (uint16_t)((frame->data[3] << 8) | frame->data[4]);
+    sent++;
+}
+
+int main(void) {
+    HostConfig config = {256, 10, CAN_DEFAULT_BIT_RATE};
+    uint8_t i;
+    uint8_t pb;
+    uint16_t pbs;
+    uint16_t misses;
+
+    CHECK_EQ(COLUMN_OUTPUTS, 16);
+    CHECK_EQ(NUM_PB, 128);
+
+    hostReset();
+    hostConfigure(&config);
+    for (pbs = 0; pbs < NUM_PB; pbs++) {
+        hostSetNv(NV_PB_FLAGS + pbs, NV_PB_FLAGS_SEND_ON | NV_PB_FLAGS_SEND_OFF);
+    }
+    hostPowerUp();
+    for (i = 0; i < sizeof(testPbs); i++) {
+        pb = testPbs[i];
+        CHECK_EQ(hostTeach(EVENT_NN, 1000 + pb, 0, PB_2_HAPPENING(pb)), 0);
+    }
+    txObserver = sentFrame;
+    hostRunFor(MS_CYCLES(3000));
+    // teaching held up the tasks with flash writes
+    misses = taskStats[0].misses;
+
+    for (i = 0; i < sizeof(testPbs); i++) {
+        pb = testPbs[i];
+        sent = 0;
+        hostSetButton(pb, 1);
+        hostRunFor(MS_CYCLES(100));
+        CHECK_EQ(sent, 1);
+        CHECK_EQ(lastOpc, OPC_ACON);
+        CHECK_EQ(lastEn, 1000 + pb);
+
+        sent = 0;
+        hostSetButton(pb, 0);
+        hostRunFor(MS_CYCLES(100));
+        CHECK_EQ(sent, 1);
+        CHECK_EQ(lastOpc, OPC_ACOF);
+        CHECK_EQ(lastEn, 1000 + pb);
+    }
+
+    // the key scan task is tasks[0], a scan of all 16 columns fits its interval
+    CHECK(taskStats[0].runs > 0);
+    CHECK(taskStats[0].worstRuntime < KEY_SCAN_INTERVAL);
+    CHECK_EQ(taskStats[0].misses, misses);
+
+    return testResult();
+}
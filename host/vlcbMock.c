@@ -0,0 +1,1510 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The host build's stand in for the VLCB library.
+ *
+ * The services the CANPANEL has are mirrored closely enough that the
+ * firmware sees the same calls and data as on the PIC: the NVM with its
+ * flash block buffer, the NV cache, the large event teach table with its
+ * hash chains, the producer, consumer, own event loopback, event
+ * acknowledge, timed response and poll(). The module management service
+ * only keeps the node number and mode, and CAN self enumeration isn't
+ * modelled so a CANID of 0 is sent as 1.
+ *
+ * Beneath it the CAN controller is a TX FIFO and an RX FIFO of frames,
+ * filled and emptied by the harness in hostNode.c.
+ *
+ * Each call charges the virtual clock with its cost from hostCosts.h and
+ * the calls which matter to the panel's performance are counted in libStats.
+ *
+ * @date October 2026
+ */
+
+#include <string.h>
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "nvm.h"
+#include "nv.h"
+#include "mns.h"
+#include "can.h"
+#include "boot.h"
+#include "timedResponse.h"
+#include "event_teach.h"
+#include "event_producer.h"
+#include "event_consumer_simple.h"
+#include "event_coe.h"
+#include "event_acknowledge.h"
+#include "hostCosts.h"
+#include "sfrMock.h"
+#include "vlcbMock.h"
+
+LibStats libStats;
+void (* rxObserver)(const HostFrame * frame);
+
+/*
+ * Non volatile memory images.
+ */
+static uint8_t eeprom[HOST_EEPROM_SIZE];
+static uint8_t flash[HOST_FLASH_SIZE];
+
+#define FLASH_BLOCK_SIZE    256
+
+static uint8_t flashBuffer[FLASH_BLOCK_SIZE];
+static uint32_t flashBlock;
+static uint8_t writeNeeded;
+static uint8_t eraseNeeded;
+
+/*
+ * vlcb.c
+ */
+const Transport * transport;
+static Message tmpMessage;
+static TickValue timedResponseTime;
+static uint8_t timedResponseDelay;
+static TickValue flashFlushTime;
+
+/*
+ * timedResponse.c
+ */
+static uint8_t timedResponseServiceIndex;
+static uint8_t timedResponseAllServicesFlag;
+static uint8_t timedResponseType;
+static uint8_t timedResponseStep;
+static TimedResponseResult (* timedResponseCallback)(uint8_t type, uint8_t serviceIndex, uint8_t step);
+
+/*
+ * mns.c
+ */
+Word nn;
+uint8_t mode_state;
+uint8_t mode_flags;
+
+/*
+ * nv.c
+ */
+static uint8_t nvCache[NV_NUM + 1];
+
+/*
+ * event_teach_large.c
+ */
+#define EVT_FLAGS           0
+#define EVT_NEXT            1
+#define EVT_NN              2
+#define EVT_EN              4
+#define EVT_EVS             6
+#define EVT_ROW             (EVT_EVS + EVENT_TABLE_WIDTH)
+#define EVT_ADDRESS(i, f)   (EVENT_TABLE_ADDRESS + (uint24_t)EVT_ROW*(i) + (f))
+
+#define FLAGS_EVS_USED      0x0F
+#define FLAGS_CONTINUED     0x10
+#define FLAGS_CONTINUATION  0x20
+#define FLAGS_FORCE_OWN_NN  0x40
+#define FLAGS_FREE_ENTRY    0x80
+
+uint8_t evs[EVperEVT];
+uint8_t happening2Event[MAX_HAPPENING + 1];
+static uint8_t eventChains[EVENT_HASH_LENGTH][EVENT_CHAIN_LENGTH];
+
+/*
+ * can18_can_2.c
+ */
+#define RX_QUEUE_SIZE       8
+
+static uint8_t canId;
+static DiagnosticVal canDiagnostics[NUM_CAN_DIAGNOSTICS];
+static Message rxQueue[RX_QUEUE_SIZE];
+static uint8_t rxQueueRead;
+static uint8_t rxQueueWrite;
+static HostFrame txFifo[HOST_TX_FIFO_DEPTH];
+static uint8_t txHead;
+static uint8_t txCount;
+static uint8_t txLostArbitration;
+static HostFrame rxFifo[HOST_RX_FIFO_DEPTH];
+static uint8_t rxHead;
+static uint8_t rxCount;
+
+static const uint8_t canPri[] = {7, 6, 5, 2};
+
+/*
+ * The library's priority of each opcode.
+ */
+const Priority priorities[256] = {
+    pNORMAL, pNORMAL, pHIGH, pABOVE, pABOVE, pABOVE, pABOVE, pHIGH,
+    pABOVE, pABOVE, pHIGH, pNORMAL, pLOW, pLOW, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pLOW,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pLOW, pNORMAL, pNORMAL, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pLOW, pLOW, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pHIGH, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pNORMAL, pLOW, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pLOW, pNORMAL, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pLOW,
+    pLOW, pNORMAL, pNORMAL, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pNORMAL, pLOW, pLOW, pNORMAL, pNORMAL,
+    pNORMAL, pLOW, pLOW, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pNORMAL, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pNORMAL, pNORMAL, pLOW, pLOW, pNORMAL, pNORMAL,
+    pNORMAL, pLOW, pLOW, pLOW, pNORMAL, pNORMAL, pLOW, pNORMAL,
+    pNORMAL, pNORMAL, pLOW, pLOW, pNORMAL, pLOW, pNORMAL, pNORMAL,
+    pNORMAL, pNORMAL, pNORMAL, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW, pLOW,
+    pLOW, pLOW, pLOW, pNORMAL, pNORMAL, pNORMAL, pNORMAL, pNORMAL
+};
+
+static void sendMessage(VlcbOpCodes opc, uint8_t len, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6, uint8_t data7);
+static void initTimedResponse(void);
+static void pollTimedResponse(void);
+static uint8_t getHash(uint16_t nodeNumber, uint16_t eventNumber);
+static uint8_t removeTableEntry(uint8_t tableIndex);
+static void clearAllEvents(void);
+
+/**
+ * Erase the memories and forget everything, as a newly programmed PIC.
+ */
+void libReset(void) {
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    memset(flash, 0xFF, sizeof(flash));
+    memset(&libStats, 0, sizeof(libStats));
+    transport = NULL;
+    txHead = 0;
+    txCount = 0;
+    txLostArbitration = 0;
+    rxHead = 0;
+    rxCount = 0;
+    rxObserver = NULL;
+    memset(eventChains, NO_INDEX, sizeof(eventChains));
+}
+
+void libSetEeprom(uint16_t address, uint8_t value) {
+    eeprom[address % HOST_EEPROM_SIZE] = value;
+}
+
+uint8_t libGetEeprom(uint16_t address) {
+    return eeprom[address % HOST_EEPROM_SIZE];
+}
+
+/*
+ * ticktime.c, a tick is 16us.
+ */
+uint32_t tickGet(void) {
+    hostCharge(COST_TICK_GET);
+    return (uint32_t)(hostCycles() / CYCLES_PER_TICK);
+}
+
+/*
+ * nvm.c
+ */
+static void initRomOps(void) {
+    writeNeeded = 0;
+    eraseNeeded = 0;
+    flashBlock = 0;
+}
+
+static uint8_t eepromRead(uint16_t index) {
+    hostCharge(COST_EEPROM_READ);
+    libStats.eepromReads++;
+    return eeprom[index % HOST_EEPROM_SIZE];
+}
+
+/**
+ * The CPU waits for the write but the interrupts carry on.
+ */
+static uint8_t eepromWrite(uint16_t index, uint8_t value) {
+    libStats.eepromWrites++;
+    hostStall(COST_EEPROM_WRITE, 1);
+    eeprom[index % HOST_EEPROM_SIZE] = value;
+    eepromRead(index);
+    return GRSP_OK;
+}
+
+static uint8_t flashRead(uint32_t address) {
+    hostCharge(COST_FLASH_READ);
+    libStats.flashReads++;
+    if ((address & ~(uint32_t)(FLASH_BLOCK_SIZE - 1)) == flashBlock) {
+        return flashBuffer[address & (FLASH_BLOCK_SIZE - 1)];
+    }
+    return flash[address % HOST_FLASH_SIZE];
+}
+
+static void eraseFlashBlock(void) {
+    while (! APP_isSuitableTimeToWriteFlash())
+        ;
+    libStats.flashErases++;
+    hostStall(COST_FLASH_ERASE, 0);
+    memset(&flash[flashBlock % HOST_FLASH_SIZE], 0xFF, FLASH_BLOCK_SIZE);
+}
+
+void flushFlashBlock(void) {
+    uint16_t i;
+
+    if (! writeNeeded) return;
+    while (APP_isSuitableTimeToWriteFlash() == BAD_TIME)
+        ;
+    if (eraseNeeded) {
+        eraseFlashBlock();
+    }
+    libStats.flashWrites++;
+    hostStall(COST_FLASH_WRITE, 0);
+    for (i = 0; i < FLASH_BLOCK_SIZE; i++) {
+        // programming can only clear bits
+        flash[(flashBlock + i) % HOST_FLASH_SIZE] &= flashBuffer[i];
+    }
+    writeNeeded = 0;
+    eraseNeeded = 0;
+}
+
+static void loadFlashBlock(void) {
+    hostCharge(COST_FLASH_LOAD);
+    memcpy(flashBuffer, &flash[flashBlock % HOST_FLASH_SIZE], FLASH_BLOCK_SIZE);
+    writeNeeded = 0;
+    eraseNeeded = 0;
+}
+
+static uint8_t flashWrite(uint32_t index, uint8_t value) {
+    uint8_t * b;
+
+    hostCharge(COST_FLASH_BUFFER_WRITE);
+    if ((index & ~(uint32_t)(FLASH_BLOCK_SIZE - 1)) != flashBlock) {
+        if (flashBlock != 0) {
+            if (eraseNeeded) {
+                eraseFlashBlock();
+                eraseNeeded = 0;
+            }
+            flushFlashBlock();
+        }
+        flashBlock = index & ~(uint32_t)(FLASH_BLOCK_SIZE - 1);
+        loadFlashBlock();
+    }
+    b = &flashBuffer[index & (FLASH_BLOCK_SIZE - 1)];
+    eraseNeeded |= (value & ~*b) ? 1 : 0;
+    if (*b != value) {
+        writeNeeded = 1;
+        *b = value;
+    }
+    return GRSP_OK;
+}
+
+uint8_t writeNVM(NVMtype type, uint24_t index, uint8_t value) {
+    switch (type) {
+        case EEPROM_NVM_TYPE:
+            return eepromWrite((uint16_t)index, value);
+        case FLASH_NVM_TYPE:
+            return flashWrite(index, value);
+        default:
+            return GRSP_UNKNOWN_NVM_TYPE;
+    }
+}
+
+int16_t readNVM(NVMtype type, uint24_t index) {
+    switch (type) {
+        case EEPROM_NVM_TYPE:
+            return eepromRead((uint16_t)index);
+        case FLASH_NVM_TYPE:
+            return flashRead(index);
+        default:
+            return -GRSP_UNKNOWN_NVM_TYPE;
+    }
+}
+
+/*
+ * vlcb.c
+ */
+const Service * findService(uint8_t id) {
+    uint8_t i;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if ((services[i] != NULL) && (services[i]->serviceNo == id)) {
+            return services[i];
+        }
+    }
+    return NULL;
+}
+
+uint8_t findServiceIndex(uint8_t id) {
+    uint8_t i;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if ((services[i] != NULL) && (services[i]->serviceNo == id)) {
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+ServicePresent have(uint8_t id) {
+    return (findService(id) != NULL) ? PRESENT : NOT_PRESENT;
+}
+
+void factoryReset(void) {
+    uint8_t i;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if ((services[i] != NULL) && (services[i]->factoryReset != NULL)) {
+            services[i]->factoryReset();
+        }
+    }
+    writeNVM(VERSION_NVM_TYPE, VERSION_ADDRESS, 1);
+    APP_factoryReset();
+}
+
+static void powerUp(void) {
+    uint8_t i;
+
+    initTimedResponse();
+    timedResponseDelay = 5;
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if ((services[i] != NULL) && (services[i]->powerUp != NULL)) {
+            services[i]->powerUp();
+        }
+    }
+}
+
+void setTimedResponseDelay(uint8_t delay) {
+    timedResponseDelay = delay;
+}
+
+/**
+ * main() up to its loop. The configure function, if given, is called after
+ * any factory reset, as though the module had been set up on an earlier run.
+ */
+void libMain(void (* configure)(void)) {
+    initRomOps();
+    if (readNVM(VERSION_NVM_TYPE, VERSION_ADDRESS) != 1) {
+        factoryReset();
+    }
+    if (configure != NULL) {
+        configure();
+    }
+    powerUp();
+    INTCON0bits.GIE = 1;
+    (void)PORTAbits.RA2;        // checkPowerOnPb(), the PB isn't pressed
+    INTCON0bits.GIE = 0;
+    setup();
+    INTCON0bits.GIE = 1;
+    timedResponseTime.val = tickGet();
+    flashFlushTime.val = tickGet();
+}
+
+/**
+ * The library's poll(), called before each loop().
+ */
+void libPoll(void) {
+    uint8_t i;
+    Message m;
+    Processed handled;
+
+    hostCharge(COST_POLL);
+    if ((tickGet() - timedResponseTime.val) > (uint32_t)timedResponseDelay*(ONE_SECOND/1000)) {
+        pollTimedResponse();
+        timedResponseTime.val = tickGet();
+    }
+    if ((tickGet() - flashFlushTime.val) > ONE_SECOND) {
+        flushFlashBlock();
+        flashFlushTime.val = tickGet();
+    }
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if ((services[i] != NULL) && (services[i]->poll != NULL)) {
+            services[i]->poll();
+        }
+    }
+    if ((transport == NULL) || (transport->receiveMessage == NULL)) {
+        return;
+    }
+    if (transport->receiveMessage(&m) && (m.len > 0)) {
+        handled = APP_preProcessMessage(&m);
+        if (handled == NOT_PROCESSED) {
+            for (i = 0; i < NUM_SERVICES; i++) {
+                if ((services[i] != NULL) && (services[i]->processMessage != NULL)) {
+                    hostCharge(COST_SERVICE_DISPATCH);
+                    if (services[i]->processMessage(&m) == PROCESSED) {
+                        handled = PROCESSED;
+                        break;
+                    }
+                }
+            }
+            if (handled == NOT_PROCESSED) {
+                APP_postProcessMessage(&m);
+            }
+        }
+    }
+}
+
+/**
+ * The earliest cycle at which poll() has something timed to do.
+ */
+uint64_t libNextDue(void) {
+    uint64_t due;
+    uint64_t t;
+
+    due = UINT64_MAX;
+    if (timedResponseType != TIMED_RESPONSE_NONE) {
+        due = ((uint64_t)timedResponseTime.val + (uint32_t)timedResponseDelay*(ONE_SECOND/1000) + 1) * CYCLES_PER_TICK;
+    }
+    if (writeNeeded) {
+        t = ((uint64_t)flashFlushTime.val + ONE_SECOND + 1) * CYCLES_PER_TICK;
+        if (t < due) {
+            due = t;
+        }
+    }
+    return due;
+}
+
+Processed checkLen(Message * m, uint8_t needed, uint8_t service) {
+    if (m->len < needed) {
+        if (m->len > 2) {
+            if ((m->bytes[0] == nn.bytes.hi) && (m->bytes[1] == nn.bytes.lo)) {
+                sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, m->opc, service, CMDERR_INV_CMD);
+            }
+        }
+        return PROCESSED;
+    }
+    return NOT_PROCESSED;
+}
+
+Boolean isEvent(uint8_t opc) {
+    return (((opc & 0b10010000) == 0b10010000) && ((~opc & 0b00000110) == 0b00000110)) ? TRUE : FALSE;
+}
+
+void sendMessage0(VlcbOpCodes opc) {
+    sendMessage(opc, 1, 0, 0, 0, 0, 0, 0, 0);
+}
+
+void sendMessage1(VlcbOpCodes opc, uint8_t data1) {
+    sendMessage(opc, 2, data1, 0, 0, 0, 0, 0, 0);
+}
+
+void sendMessage2(VlcbOpCodes opc, uint8_t data1, uint8_t data2) {
+    sendMessage(opc, 3, data1, data2, 0, 0, 0, 0, 0);
+}
+
+void sendMessage3(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3) {
+    sendMessage(opc, 4, data1, data2, data3, 0, 0, 0, 0);
+}
+
+void sendMessage4(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4) {
+    sendMessage(opc, 5, data1, data2, data3, data4, 0, 0, 0);
+}
+
+void sendMessage5(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5) {
+    sendMessage(opc, 6, data1, data2, data3, data4, data5, 0, 0);
+}
+
+void sendMessage6(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6) {
+    sendMessage(opc, 7, data1, data2, data3, data4, data5, data6, 0);
+}
+
+void sendMessage7(VlcbOpCodes opc, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6, uint8_t data7) {
+    sendMessage(opc, 8, data1, data2, data3, data4, data5, data6, data7);
+}
+
+static void sendMessage(VlcbOpCodes opc, uint8_t len, uint8_t data1, uint8_t data2, uint8_t data3, uint8_t data4, uint8_t data5, uint8_t data6, uint8_t data7) {
+    tmpMessage.opc = opc;
+    tmpMessage.len = len;
+    tmpMessage.bytes[0] = data1;
+    tmpMessage.bytes[1] = data2;
+    tmpMessage.bytes[2] = data3;
+    tmpMessage.bytes[3] = data4;
+    tmpMessage.bytes[4] = data5;
+    tmpMessage.bytes[5] = data6;
+    tmpMessage.bytes[6] = data7;
+    if ((transport != NULL) && (transport->sendMessage != NULL)) {
+        transport->sendMessage(&tmpMessage);
+    }
+}
+
+/*
+ * timedResponse.c
+ */
+static void initTimedResponse(void) {
+    timedResponseType = TIMED_RESPONSE_NONE;
+}
+
+void startTimedResponse(uint8_t type, uint8_t serviceIndex, TimedResponseResult (*callback)(uint8_t type, uint8_t serviceIndex, uint8_t step)) {
+    timedResponseType = type;
+    if (serviceIndex == 0) {
+        timedResponseAllServicesFlag = 1;
+        timedResponseServiceIndex = 0;
+    } else {
+        timedResponseAllServicesFlag = 0;
+        if (serviceIndex > NUM_SERVICES) {
+            timedResponseType = TIMED_RESPONSE_NONE;
+            return;
+        }
+        timedResponseServiceIndex = serviceIndex - 1;
+    }
+    timedResponseStep = 0;
+    timedResponseCallback = callback;
+}
+
+static void pollTimedResponse(void) {
+    TimedResponseResult result;
+
+    if (timedResponseType == TIMED_RESPONSE_NONE) {
+        return;
+    }
+    if (timedResponseCallback == NULL) {
+        timedResponseType = TIMED_RESPONSE_NONE;
+        return;
+    }
+    result = timedResponseCallback(timedResponseType, timedResponseServiceIndex, timedResponseStep);
+    switch (result) {
+        case TIMED_RESPONSE_RESULT_FINISHED:
+            if (timedResponseAllServicesFlag) {
+                timedResponseServiceIndex++;
+                if (timedResponseServiceIndex >= NUM_SERVICES) {
+                    timedResponseType = TIMED_RESPONSE_NONE;
+                } else {
+                    timedResponseStep = 0;
+                }
+            } else {
+                timedResponseType = TIMED_RESPONSE_NONE;
+            }
+            break;
+        case TIMED_RESPONSE_RESULT_RETRY:
+            break;
+        case TIMED_RESPONSE_RESULT_NEXT:
+            timedResponseStep++;
+            break;
+    }
+}
+
+/*
+ * mns.c, the node number and mode only.
+ */
+static void mnsFactoryReset(void) {
+    nn.word = 0;
+    writeNVM(NN_NVM_TYPE, NN_ADDRESS, nn.bytes.hi);
+    writeNVM(NN_NVM_TYPE, NN_ADDRESS + 1, nn.bytes.lo);
+    mode_state = MODE_UNINITIALISED;
+    writeNVM(MODE_NVM_TYPE, MODE_ADDRESS, mode_state);
+    mode_flags = 0;
+    writeNVM(MODE_FLAGS_NVM_TYPE, MODE_FLAGS_ADDRESS, mode_flags);
+}
+
+static void mnsPowerUp(void) {
+    nn.bytes.hi = (uint8_t)readNVM(NN_NVM_TYPE, NN_ADDRESS);
+    nn.bytes.lo = (uint8_t)readNVM(NN_NVM_TYPE, NN_ADDRESS + 1);
+    mode_state = (uint8_t)readNVM(MODE_NVM_TYPE, MODE_ADDRESS);
+    mode_flags = (uint8_t)readNVM(MODE_FLAGS_NVM_TYPE, MODE_FLAGS_ADDRESS);
+}
+
+void updateModuleErrorStatus(void) {
+}
+
+const Service mnsService = {
+    SERVICE_ID_MNS, 1, mnsFactoryReset, mnsPowerUp, NULL, NULL, NULL, NULL
+};
+
+/*
+ * boot.c, the bootloader isn't modelled.
+ */
+const Service bootService = {
+    SERVICE_ID_BOOT, 1, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+/*
+ * nv.c
+ */
+static void nvFactoryReset(void) {
+    uint8_t i;
+
+    for (i = 1; i <= NV_NUM; i++) {
+        writeNVM(NV_NVM_TYPE, NV_ADDRESS + i, APP_nvDefault(i));
+    }
+}
+
+void loadNvCache(void) {
+    uint8_t i;
+
+    for (i = 1; i <= NV_NUM; i++) {
+        nvCache[i] = (uint8_t)readNVM(NV_NVM_TYPE, NV_ADDRESS + i);
+    }
+}
+
+static void nvPowerUp(void) {
+    loadNvCache();
+}
+
+int16_t getNV(uint8_t index) {
+    hostCharge(COST_GET_NV);
+    libStats.getNvCalls++;
+    if (index == 0) return NV_NUM;
+    if (index > NV_NUM) return -CMDERR_INV_NV_IDX;
+    return nvCache[index];
+}
+
+void saveNV(uint8_t index, uint8_t value) {
+    nvCache[index] = value;
+    writeNVM(NV_NVM_TYPE, NV_ADDRESS + index, value);
+}
+
+uint8_t setNV(uint8_t index, uint8_t value) {
+    uint8_t oldValue;
+
+    if (index > NV_NUM) return CMDERR_INV_NV_IDX;
+    if (APP_nvValidate(index, value) == INVALID) return CMDERR_INV_NV_VALUE;
+    oldValue = nvCache[index];
+    nvCache[index] = value;
+    writeNVM(NV_NVM_TYPE, NV_ADDRESS + index, value);
+    APP_nvValueChanged(index, value, oldValue);
+    return 0;
+}
+
+static TimedResponseResult nvTRnvrdCallback(uint8_t type, uint8_t serviceIndex, uint8_t step) {
+    int16_t valueOrError;
+
+    if (step > NV_NUM) {
+        return TIMED_RESPONSE_RESULT_FINISHED;
+    }
+    valueOrError = getNV(step + 1);
+    if (valueOrError < 0) {
+        return TIMED_RESPONSE_RESULT_FINISHED;
+    }
+    sendMessage4(OPC_NVANS, nn.bytes.hi, nn.bytes.lo, step + 1, (uint8_t)valueOrError);
+    return TIMED_RESPONSE_RESULT_NEXT;
+}
+
+static Processed nvProcessMessage(Message * m) {
+    int16_t valueOrError;
+
+    if (m->len < 3) return NOT_PROCESSED;
+    if (m->bytes[0] != nn.bytes.hi) return NOT_PROCESSED;
+    if (m->bytes[1] != nn.bytes.lo) return NOT_PROCESSED;
+    switch (m->opc) {
+        case OPC_NVRD:
+            if (m->len < 4) {
+                sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_NVRD, SERVICE_ID_MNS, CMDERR_INV_CMD);
+                return PROCESSED;
+            }
+            valueOrError = getNV(m->bytes[2]);
+            if (valueOrError < 0) {
+                sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, (uint8_t)(-valueOrError));
+                return PROCESSED;
+            }
+            sendMessage4(OPC_NVANS, nn.bytes.hi, nn.bytes.lo, m->bytes[2], (uint8_t)valueOrError);
+            if (m->bytes[2] == 0) {
+                startTimedResponse(TIMED_RESPONSE_NVRD, findServiceIndex(SERVICE_ID_NV), nvTRnvrdCallback);
+            }
+            return PROCESSED;
+        case OPC_NVSET:
+        case OPC_NVSETRD:
+            if (m->len < 5) {
+                sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, m->opc, SERVICE_ID_MNS, CMDERR_INV_CMD);
+                return PROCESSED;
+            }
+            valueOrError = setNV(m->bytes[2], m->bytes[3]);
+            if (valueOrError > 0) {
+                sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, (uint8_t)valueOrError);
+                return PROCESSED;
+            }
+            if (m->opc == OPC_NVSETRD) {
+                sendMessage4(OPC_NVANS, nn.bytes.hi, nn.bytes.lo, m->bytes[2], (uint8_t)getNV(m->bytes[2]));
+                return PROCESSED;
+            }
+            sendMessage2(OPC_WRACK, nn.bytes.hi, nn.bytes.lo);
+            sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_NVSET, SERVICE_ID_MNS, GRSP_OK);
+            return PROCESSED;
+        default:
+            return NOT_PROCESSED;
+    }
+}
+
+const Service nvService = {
+    SERVICE_ID_NV, 1, nvFactoryReset, nvPowerUp, nvProcessMessage, NULL, NULL, NULL
+};
+
+/*
+ * event_teach_large.c
+ */
+static uint8_t readFlags(uint8_t tableIndex) {
+    return (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_FLAGS));
+}
+
+static void writeFlags(uint8_t tableIndex, uint8_t flags) {
+    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_FLAGS), flags);
+}
+
+Boolean validStart(uint8_t tableIndex) {
+    uint8_t f;
+
+    f = readFlags(tableIndex);
+    return (!(f & FLAGS_FREE_ENTRY) && !(f & FLAGS_CONTINUATION)) ? TRUE : FALSE;
+}
+
+uint16_t getNN(uint8_t tableIndex) {
+    uint16_t hi;
+    uint16_t lo;
+
+    if (readFlags(tableIndex) & FLAGS_FORCE_OWN_NN) {
+        return nn.word;
+    }
+    lo = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NN));
+    hi = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NN + 1));
+    return lo | (hi << 8);
+}
+
+uint16_t getEN(uint8_t tableIndex) {
+    uint16_t hi;
+    uint16_t lo;
+
+    lo = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EN));
+    hi = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EN + 1));
+    return lo | (hi << 8);
+}
+
+static uint8_t getHash(uint16_t nodeNumber, uint16_t eventNumber) {
+    uint8_t hash;
+
+    hash = (uint8_t)(nodeNumber ^ (nodeNumber >> 8U));
+    hash = (uint8_t)(7U*hash + (eventNumber ^ (eventNumber >> 8U)));
+    hash %= EVENT_HASH_LENGTH;
+    return hash;
+}
+
+uint8_t findEvent(uint16_t nodeNumber, uint16_t eventNumber) {
+    uint8_t hash;
+    uint8_t chainIdx;
+    uint8_t tableIndex;
+
+    hostCharge(COST_HASH_LOOKUP);
+    libStats.findEventCalls++;
+    hash = getHash(nodeNumber, eventNumber);
+    for (chainIdx = 0; chainIdx < EVENT_CHAIN_LENGTH; chainIdx++) {
+        tableIndex = eventChains[hash][chainIdx];
+        if (tableIndex == NO_INDEX) return NO_INDEX;
+        if ((getNN(tableIndex) == nodeNumber) && (getEN(tableIndex) == eventNumber)) {
+            return tableIndex;
+        }
+    }
+    return NO_INDEX;
+}
+
+int16_t getEv(uint8_t tableIndex, uint8_t evNum) {
+    uint8_t f;
+
+    if (! validStart(tableIndex)) {
+        return -CMDERR_INVALID_EVENT;
+    }
+    if (evNum >= EVperEVT) {
+        return -CMDERR_INV_EV_IDX;
+    }
+    f = readFlags(tableIndex);
+    while (evNum >= EVENT_TABLE_WIDTH) {
+        if (!(f & FLAGS_CONTINUED)) {
+            return -CMDERR_NO_EV;
+        }
+        tableIndex = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NEXT));
+        if (tableIndex == NO_INDEX) {
+            return -CMDERR_INVALID_EVENT;
+        }
+        f = readFlags(tableIndex);
+        evNum -= EVENT_TABLE_WIDTH;
+    }
+    if (evNum + 1 > (f & FLAGS_EVS_USED)) {
+        return -CMDERR_NO_EV;
+    }
+    return (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EVS + evNum));
+}
+
+uint8_t getEVs(uint8_t tableIndex) {
+    uint8_t evNum;
+    uint8_t evIdx;
+
+    libStats.getEvsCalls++;
+    if (! validStart(tableIndex)) {
+        return CMDERR_INVALID_EVENT;
+    }
+    for (evNum = 0; evNum < EVperEVT; ) {
+        for (evIdx = 0; evIdx < EVENT_TABLE_WIDTH; evIdx++) {
+            evs[evNum++] = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EVS + evIdx));
+        }
+        if (!(readFlags(tableIndex) & FLAGS_CONTINUED)) {
+            for (; evNum < EVperEVT; evNum++) {
+                evs[evNum] = 0;
+            }
+            return 0;
+        }
+        tableIndex = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NEXT));
+        if (tableIndex == NO_INDEX) {
+            return CMDERR_INVALID_EVENT;
+        }
+    }
+    return 0;
+}
+
+void rebuildHashtable(void) {
+    uint8_t hash;
+    uint8_t chainIdx;
+    uint8_t tableIndex;
+    uint16_t happening;
+    int16_t ev;
+
+    for (happening = 0; happening <= MAX_HAPPENING; happening++) {
+        happening2Event[happening] = NO_INDEX;
+    }
+    memset(eventChains, NO_INDEX, sizeof(eventChains));
+    for (tableIndex = 0; tableIndex < NUM_EVENTS; tableIndex++) {
+        if (validStart(tableIndex)) {
+            ev = getEv(tableIndex, 0);
+            if (ev < 0) continue;
+            if (ev <= MAX_HAPPENING) {
+                happening2Event[ev] = tableIndex;
+            }
+            hash = getHash(getNN(tableIndex), getEN(tableIndex));
+            for (chainIdx = 0; chainIdx < EVENT_CHAIN_LENGTH; chainIdx++) {
+                if (eventChains[hash][chainIdx] == NO_INDEX) {
+                    eventChains[hash][chainIdx] = tableIndex;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+uint8_t writeEv(uint8_t tableIndex, uint8_t evNum, uint8_t evVal) {
+    uint8_t f;
+    uint8_t startIndex;
+    uint8_t nextIdx;
+    uint8_t e;
+
+    startIndex = tableIndex;
+    if (evNum >= EVperEVT) {
+        return CMDERR_INV_EV_IDX;
+    }
+    while (evNum >= EVENT_TABLE_WIDTH) {
+        evNum -= EVENT_TABLE_WIDTH;
+        f = readFlags(tableIndex);
+        if (f & FLAGS_CONTINUED) {
+            tableIndex = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NEXT));
+            if (tableIndex == NO_INDEX) {
+                return CMDERR_INVALID_EVENT;
+            }
+        } else {
+            if (evVal == 0) {
+                return 0;
+            }
+            for (nextIdx = tableIndex + 1; nextIdx < NUM_EVENTS; nextIdx++) {
+                if (readFlags(nextIdx) & FLAGS_FREE_ENTRY) {
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(nextIdx, EVT_NN), 0xFF);
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(nextIdx, EVT_NN + 1), 0xFF);
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(nextIdx, EVT_EN), 0xFF);
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(nextIdx, EVT_EN + 1), 0xFF);
+                    writeFlags(nextIdx, FLAGS_CONTINUATION);
+                    for (e = 0; e < EVENT_TABLE_WIDTH; e++) {
+                        writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(nextIdx, EVT_EVS + e), 0);
+                    }
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NEXT), nextIdx);
+                    writeFlags(tableIndex, f | FLAGS_CONTINUED);
+                    tableIndex = nextIdx;
+                    break;
+                }
+            }
+            if (nextIdx >= NUM_EVENTS) {
+                return CMDERR_TOO_MANY_EVENTS;
+            }
+        }
+    }
+    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EVS + evNum), evVal);
+    f = readFlags(tableIndex);
+    if ((f & FLAGS_EVS_USED) <= evNum) {
+        writeFlags(tableIndex, (uint8_t)((f & ~FLAGS_EVS_USED) | (evNum + 1U)));
+    }
+    if (evVal == 0) {
+        checkRemoveTableEntry(startIndex);
+    }
+    return 0;
+}
+
+uint8_t addEvent(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal, Boolean forceOwnNN) {
+    uint8_t tableIndex;
+    uint8_t e;
+
+    tableIndex = findEvent(nodeNumber, eventNumber);
+    if (tableIndex == NO_INDEX) {
+        if (evVal == 0) {
+            return 0;
+        }
+        for (tableIndex = 0; tableIndex < NUM_EVENTS; tableIndex++) {
+            if (readFlags(tableIndex) & FLAGS_FREE_ENTRY) {
+                writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NN), nodeNumber & 0xFF);
+                writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NN + 1), nodeNumber >> 8);
+                writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EN), eventNumber & 0xFF);
+                writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EN + 1), eventNumber >> 8);
+                writeFlags(tableIndex, forceOwnNN ? FLAGS_FORCE_OWN_NN : 0);
+                for (e = 0; e < EVENT_TABLE_WIDTH; e++) {
+                    writeNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_EVS + e), 0);
+                }
+                break;
+            }
+        }
+        if (tableIndex >= NUM_EVENTS) {
+            return CMDERR_TOO_MANY_EVENTS;
+        }
+    }
+    if (writeEv(tableIndex, evNum, evVal)) {
+        return CMDERR_INV_EV_IDX;
+    }
+    flushFlashBlock();
+    rebuildHashtable();
+    return 0;
+}
+
+static uint8_t removeTableEntry(uint8_t tableIndex) {
+    uint8_t f;
+
+    if (validStart(tableIndex)) {
+        f = readFlags(tableIndex);
+        writeFlags(tableIndex, 0xFF);
+        while (f & FLAGS_CONTINUED) {
+            tableIndex = (uint8_t)readNVM(EVENT_TABLE_NVM_TYPE, EVT_ADDRESS(tableIndex, EVT_NEXT));
+            if (tableIndex >= NUM_EVENTS) return CMDERR_INV_EV_IDX;
+            f = readFlags(tableIndex);
+            writeFlags(tableIndex, 0xFF);
+        }
+        flushFlashBlock();
+        rebuildHashtable();
+    }
+    return 0;
+}
+
+uint8_t removeEvent(uint16_t nodeNumber, uint16_t eventNumber) {
+    uint8_t tableIndex;
+
+    tableIndex = findEvent(nodeNumber, eventNumber);
+    if (tableIndex == NO_INDEX) return CMDERR_INVALID_EVENT;
+    return removeTableEntry(tableIndex);
+}
+
+void checkRemoveTableEntry(uint8_t tableIndex) {
+    uint8_t e;
+
+    if (validStart(tableIndex)) {
+        if (getEVs(tableIndex)) {
+            return;
+        }
+        for (e = 0; e < EVperEVT; e++) {
+            if (evs[e] != 0) {
+                return;
+            }
+        }
+        removeTableEntry(tableIndex);
+    }
+}
+
+static void clearAllEvents(void) {
+    uint8_t tableIndex;
+
+    for (tableIndex = 0; tableIndex < NUM_EVENTS; tableIndex++) {
+        writeFlags(tableIndex, 0xFF);
+    }
+    flushFlashBlock();
+    rebuildHashtable();
+}
+
+static void teachFactoryReset(void) {
+    clearAllEvents();
+}
+
+static void teachPowerUp(void) {
+    rebuildHashtable();
+    mode_flags &= ~1;
+}
+
+static Processed teachCheckLen(Message * m, uint8_t needed, uint8_t learn) {
+    if (learn) {
+        if (m->len < needed) {
+            if (mode_flags & 1) {
+                sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, m->opc, SERVICE_ID_OLD_TEACH, CMDERR_INV_CMD);
+            }
+            return PROCESSED;
+        }
+        return NOT_PROCESSED;
+    }
+    return checkLen(m, needed, SERVICE_ID_OLD_TEACH);
+}
+
+static TimedResponseResult nerdCallback(uint8_t type, uint8_t serviceIndex, uint8_t step) {
+    Word nodeNumber;
+    Word eventNumber;
+
+    if (step >= NUM_EVENTS) {
+        return TIMED_RESPONSE_RESULT_FINISHED;
+    }
+    if (validStart(step)) {
+        nodeNumber.word = getNN(step);
+        eventNumber.word = getEN(step);
+        sendMessage7(OPC_ENRSP, nn.bytes.hi, nn.bytes.lo, nodeNumber.bytes.hi, nodeNumber.bytes.lo, eventNumber.bytes.hi, eventNumber.bytes.lo, step + 1);
+    }
+    return TIMED_RESPONSE_RESULT_NEXT;
+}
+
+static void doEvlrn(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, uint8_t evVal) {
+    uint8_t error;
+
+    evNum--;
+    if (evNum >= EVperEVT) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_INV_EV_IDX);
+        sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_EVLRN, SERVICE_ID_OLD_TEACH, CMDERR_INV_EV_IDX);
+        return;
+    }
+    error = APP_addEvent(nodeNumber, eventNumber, evNum, evVal, FALSE);
+    if (error) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, error);
+        sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_EVLRN, SERVICE_ID_OLD_TEACH, error);
+        return;
+    }
+    sendMessage2(OPC_WRACK, nn.bytes.hi, nn.bytes.lo);
+    sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_REQEV, SERVICE_ID_OLD_TEACH, GRSP_OK);
+}
+
+static void doEvuln(uint16_t nodeNumber, uint16_t eventNumber) {
+    uint8_t result;
+
+    result = removeEvent(nodeNumber, eventNumber);
+    if (result) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, result);
+        sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_EVULN, SERVICE_ID_OLD_TEACH, result);
+        return;
+    }
+    sendMessage2(OPC_WRACK, nn.bytes.hi, nn.bytes.lo);
+    sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_REQEV, SERVICE_ID_OLD_TEACH, GRSP_OK);
+}
+
+static void doReqev(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum) {
+    int16_t evVal;
+    uint8_t tableIndex;
+
+    tableIndex = findEvent(nodeNumber, eventNumber);
+    if (tableIndex == NO_INDEX) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_INVALID_EVENT);
+        return;
+    }
+    if ((evNum == 0) || (evNum > EVperEVT)) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_INV_EV_IDX);
+        return;
+    }
+    evVal = getEv(tableIndex, evNum - 1);
+    if (evVal < 0) {
+        sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, (uint8_t)(-evVal));
+        return;
+    }
+    sendMessage6(OPC_EVANS, nodeNumber >> 8, nodeNumber & 0xFF, eventNumber >> 8, eventNumber & 0xFF, evNum, (uint8_t)evVal);
+}
+
+static void doRqevn(void) {
+    uint8_t count;
+    uint8_t i;
+
+    count = 0;
+    for (i = 0; i < NUM_EVENTS; i++) {
+        if (validStart(i)) {
+            count++;
+        }
+    }
+    sendMessage3(OPC_NUMEV, nn.bytes.hi, nn.bytes.lo, count);
+}
+
+static void doNnevn(void) {
+    uint8_t count;
+    uint8_t i;
+
+    count = 0;
+    for (i = 0; i < NUM_EVENTS; i++) {
+        if (readFlags(i) & FLAGS_FREE_ENTRY) {
+            count++;
+        }
+    }
+    sendMessage3(OPC_EVNLF, nn.bytes.hi, nn.bytes.lo, count);
+}
+
+/**
+ * The teaching messages. REVAL and NENRD aren't modelled.
+ */
+static Processed teachProcessMessage(Message * m) {
+    switch (m->opc) {
+        case OPC_NNLRN:
+            if (teachCheckLen(m, 3, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] == nn.bytes.hi) && (m->bytes[1] == nn.bytes.lo)) {
+                mode_flags |= 1;
+            } else {
+                mode_flags &= ~1;
+            }
+            return PROCESSED;
+        case OPC_MODE:
+            if (teachCheckLen(m, 4, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] == nn.bytes.hi) && (m->bytes[1] == nn.bytes.lo)) {
+                if (m->bytes[2] == MODE_LEARN_ON) {
+                    mode_flags |= 1;
+                    return PROCESSED;
+                } else if (m->bytes[2] == MODE_LEARN_OFF) {
+                    mode_flags &= ~1;
+                    return PROCESSED;
+                }
+            } else {
+                mode_flags &= ~1;
+            }
+            return NOT_PROCESSED;
+        case OPC_EVLRN:
+            if (teachCheckLen(m, 7, 1) == PROCESSED) {
+                sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_INV_CMD);
+                return PROCESSED;
+            }
+            if (!(mode_flags & 1)) return PROCESSED;
+            doEvlrn((uint16_t)(m->bytes[0] << 8) | m->bytes[1], (uint16_t)(m->bytes[2] << 8) | m->bytes[3], m->bytes[4], m->bytes[5]);
+            return PROCESSED;
+        case OPC_EVULN:
+            if (teachCheckLen(m, 5, 1) == PROCESSED) return PROCESSED;
+            if (!(mode_flags & 1)) return PROCESSED;
+            doEvuln((uint16_t)(m->bytes[0] << 8) | m->bytes[1], (uint16_t)(m->bytes[2] << 8) | m->bytes[3]);
+            return PROCESSED;
+        case OPC_REQEV:
+            if (teachCheckLen(m, 6, 1) == PROCESSED) return PROCESSED;
+            if (!(mode_flags & 1)) return PROCESSED;
+            doReqev((uint16_t)(m->bytes[0] << 8) | m->bytes[1], (uint16_t)(m->bytes[2] << 8) | m->bytes[3], m->bytes[4]);
+            return PROCESSED;
+        case OPC_NNULN:
+            if (teachCheckLen(m, 3, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            mode_flags &= ~1;
+            return PROCESSED;
+        case OPC_NNCLR:
+            if (teachCheckLen(m, 3, 1) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            if (!(mode_flags & 1)) {
+                sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_NOT_LRN);
+                return PROCESSED;
+            }
+            clearAllEvents();
+            sendMessage2(OPC_WRACK, nn.bytes.hi, nn.bytes.lo);
+            return PROCESSED;
+        case OPC_NERD:
+            if (teachCheckLen(m, 3, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            startTimedResponse(TIMED_RESPONSE_NERD, findServiceIndex(SERVICE_ID_OLD_TEACH), nerdCallback);
+            return PROCESSED;
+        case OPC_NNEVN:
+            if (teachCheckLen(m, 3, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            doNnevn();
+            return PROCESSED;
+        case OPC_RQEVN:
+            if (teachCheckLen(m, 3, 0) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            doRqevn();
+            return PROCESSED;
+        case OPC_EVLRNI:
+            if (teachCheckLen(m, 8, 1) == PROCESSED) return PROCESSED;
+            if ((m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) return PROCESSED;
+            doEvlrn((uint16_t)(m->bytes[0] << 8) | m->bytes[1], (uint16_t)(m->bytes[2] << 8) | m->bytes[3], m->bytes[5], m->bytes[6]);
+            return PROCESSED;
+        default:
+            break;
+    }
+    return NOT_PROCESSED;
+}
+
+const Service eventTeachService = {
+    SERVICE_ID_OLD_TEACH, 1, teachFactoryReset, teachPowerUp, teachProcessMessage, NULL, NULL, NULL
+};
+
+/*
+ * event_producer_happening.c
+ */
+static Processed producerProcessMessage(Message * m) {
+    uint8_t index;
+    int16_t ev;
+
+    switch (m->opc) {
+        case OPC_AREQ:
+        case OPC_ASRQ:
+            if (m->len < 5) {
+                sendMessage3(OPC_CMDERR, nn.bytes.hi, nn.bytes.lo, CMDERR_INV_CMD);
+                return PROCESSED;
+            }
+            if (m->opc == OPC_AREQ) {
+                index = findEvent((uint16_t)((m->bytes[0] << 8) | m->bytes[1]), (uint16_t)((m->bytes[2] << 8) | m->bytes[3]));
+            } else {
+                index = findEvent(0, (uint16_t)((m->bytes[2] << 8) | m->bytes[3]));
+            }
+            if (index == NO_INDEX) return PROCESSED;
+            ev = getEv(index, 0);
+            if (ev <= 0) return PROCESSED;
+            if (m->opc == OPC_AREQ) {
+                sendMessage4((APP_GetEventState((Happening)ev) == EVENT_ON) ? OPC_ARON : OPC_AROF, m->bytes[0], m->bytes[1], m->bytes[2], m->bytes[3]);
+            } else {
+                sendMessage4((APP_GetEventState((Happening)ev) == EVENT_ON) ? OPC_ARSON : OPC_ARSOF, nn.bytes.hi, nn.bytes.lo, m->bytes[2], m->bytes[3]);
+            }
+            return PROCESSED;
+        default:
+            break;
+    }
+    return NOT_PROCESSED;
+}
+
+Boolean sendProducedEvent(Happening happening, EventState onOff) {
+    Word producedEventNN;
+    Word producedEventEN;
+    uint8_t opc;
+
+    if (happening2Event[happening] == NO_INDEX) return FALSE;
+    producedEventNN.word = getNN(happening2Event[happening]);
+    producedEventEN.word = getEN(happening2Event[happening]);
+    if (producedEventNN.word == 0) {
+        opc = (onOff == EVENT_ON) ? OPC_ASON : OPC_ASOF;
+        producedEventNN.word = nn.word;
+    } else {
+        opc = (onOff == EVENT_ON) ? OPC_ACON : OPC_ACOF;
+    }
+    sendMessage4(opc, producedEventNN.bytes.hi, producedEventNN.bytes.lo, producedEventEN.bytes.hi, producedEventEN.bytes.lo);
+    return TRUE;
+}
+
+const Service eventProducerService = {
+    SERVICE_ID_PRODUCER, 1, NULL, NULL, producerProcessMessage, NULL, NULL, NULL
+};
+
+/*
+ * event_consumer_simple.c
+ */
+static Processed consumerProcessMessage(Message * m) {
+    uint8_t tableIndex;
+
+    if (m->len < 5) return NOT_PROCESSED;
+    tableIndex = findEvent(((uint16_t)m->bytes[0])*256 + m->bytes[1], ((uint16_t)m->bytes[2])*256 + m->bytes[3]);
+    if (tableIndex == NO_INDEX) return NOT_PROCESSED;
+    switch (m->opc) {
+        case OPC_ACON:
+        case OPC_ACON1:
+        case OPC_ACON2:
+        case OPC_ACON3:
+        case OPC_ASON:
+        case OPC_ASON1:
+        case OPC_ASON2:
+        case OPC_ASON3:
+        case OPC_ACOF:
+        case OPC_ACOF1:
+        case OPC_ACOF2:
+        case OPC_ACOF3:
+        case OPC_ASOF:
+        case OPC_ASOF1:
+        case OPC_ASOF2:
+        case OPC_ASOF3:
+            break;
+        default:
+            return NOT_PROCESSED;
+    }
+    return APP_processConsumedEvent(tableIndex, m);
+}
+
+const Service eventConsumerService = {
+    SERVICE_ID_CONSUMER, 1, NULL, NULL, consumerProcessMessage, NULL, NULL, NULL
+};
+
+/*
+ * event_coe.c, the loopback is done by canSendMessage().
+ */
+const Service eventCoeService = {
+    SERVICE_ID_CONSUME_OWN_EVENTS, 1, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+/*
+ * event_acknowledge.c, acknowledgements aren't modelled.
+ */
+const Service eventAckService = {
+    SERVICE_ID_EVENTACK, 1, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+/*
+ * can18_can_2.c
+ */
+static void canFactoryReset(void) {
+    canId = 0;
+    writeNVM(CANID_NVM_TYPE, CANID_ADDRESS, canId);
+}
+
+static void canPowerUp(void) {
+    canId = (uint8_t)readNVM(CANID_NVM_TYPE, CANID_ADDRESS);
+    if (canId == 0) {
+        canId = 1;
+    }
+    memset(canDiagnostics, 0, sizeof(canDiagnostics));
+    rxQueueRead = 0;
+    rxQueueWrite = 0;
+}
+
+static DiagnosticVal * canGetDiagnostic(uint8_t index) {
+    if ((index < 1) || (index > NUM_CAN_DIAGNOSTICS)) {
+        return NULL;
+    }
+    switch (index - 1) {
+        case 0x03:
+            canDiagnostics[0x03].asInt = txCount;
+            break;
+        case 0x06:
+            canDiagnostics[0x06].asInt = rxCount;
+            break;
+    }
+    return &canDiagnostics[index - 1];
+}
+
+static SendResult canSendMessage(Message * mp) {
+    HostFrame * f;
+    Message * m;
+    uint8_t next;
+
+    hostCharge(COST_SEND_MESSAGE);
+    if (isEvent(mp->opc) && have(SERVICE_ID_CONSUME_OWN_EVENTS)) {
+        next = (rxQueueWrite + 1) & (RX_QUEUE_SIZE - 1);
+        if (next == rxQueueRead) {
+            canDiagnostics[0x07].asUint++;
+            libStats.coeOverruns++;
+        } else {
+            m = &rxQueue[rxQueueWrite];
+            rxQueueWrite = next;
+            memcpy(m, mp, sizeof(Message));
+        }
+    }
+    if (txCount >= HOST_TX_FIFO_DEPTH) {
+        canDiagnostics[0x04].asUint++;
+        libStats.sendFailures++;
+        return SEND_FAILED;
+    }
+    if (txLostArbitration) {
+        canDiagnostics[0x0B].asUint++;
+    }
+    f = &txFifo[(txHead + txCount) % HOST_TX_FIFO_DEPTH];
+    f->id = (uint16_t)((canPri[priorities[mp->opc]] << 8) | (canId & 0x7F));
+    f->len = mp->len & 0x0F;
+    f->data[0] = (uint8_t)mp->opc;
+    memcpy(&f->data[1], mp->bytes, 7);
+    f->time = hostCycles();
+    txCount++;
+    canDiagnostics[0x05].asUint++;
+    libStats.messagesSent++;
+    return SEND_OK;
+}
+
+static MessageReceived canReceiveMessage(Message * m) {
+    HostFrame * f;
+
+    if (rxQueueRead != rxQueueWrite) {
+        memcpy(m, &rxQueue[rxQueueRead], sizeof(Message));
+        rxQueueRead = (rxQueueRead + 1) & (RX_QUEUE_SIZE - 1);
+        return RECEIVED;
+    }
+    if (rxCount == 0) {
+        return NOT_RECEIVED;
+    }
+    hostCharge(COST_RECEIVE_MESSAGE);
+    f = &rxFifo[rxHead];
+    rxHead = (rxHead + 1) % HOST_RX_FIFO_DEPTH;
+    rxCount--;
+    canDiagnostics[0x08].asUint++;
+    libStats.messagesReceived++;
+    if (rxObserver != NULL) {
+        rxObserver(f);
+    }
+    m->len = f->len;
+    if (m->len == 0) {
+        return NOT_RECEIVED;
+    }
+    m->opc = f->data[0];
+    memcpy(m->bytes, &f->data[1], 7);
+    return RECEIVED;
+}
+
+const Service canService = {
+    SERVICE_ID_CAN, 1, canFactoryReset, canPowerUp, NULL, NULL, NULL, canGetDiagnostic
+};
+
+const Transport canTransport = {
+    canSendMessage,
+    canReceiveMessage
+};
+
+/*
+ * The CAN controller as the harness sees it.
+ */
+uint8_t canTxCount(void) {
+    return txCount;
+}
+
+const HostFrame * canTxHead(void) {
+    return (txCount == 0) ? NULL : &txFifo[txHead];
+}
+
+/**
+ * The frame at the head of the TX FIFO has been sent.
+ */
+void canTxRemove(void) {
+    if (txCount > 0) {
+        txHead = (txHead + 1) % HOST_TX_FIFO_DEPTH;
+        txCount--;
+        txLostArbitration = 0;
+    }
+}
+
+void canTxLostArbitration(void) {
+    txLostArbitration = 1;
+}
+
+uint8_t canRxPending(void) {
+    return (rxCount != 0) || (rxQueueRead != rxQueueWrite);
+}
+
+/**
+ * A frame has arrived from the bus.
+ * @return 0 if the RX FIFO was full and it was lost
+ */
+uint8_t canRxPush(const HostFrame * frame) {
+    if (rxCount >= HOST_RX_FIFO_DEPTH) {
+        canDiagnostics[0x07].asUint++;
+        libStats.rxOverruns++;
+        return 0;
+    }
+    rxFifo[(rxHead + rxCount) % HOST_RX_FIFO_DEPTH] = *frame;
+    rxCount++;
+    return 1;
+}
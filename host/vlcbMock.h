@@ -0,0 +1,90 @@
+#ifndef _VLCBMOCK_H_
+#define _VLCBMOCK_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * The host build's stand in for the parts of the VLCB library the CANPANEL
+ * uses, and the CAN controller under it.
+ *
+ * @date October 2026
+ */
+
+#include <stdint.h>
+#include "canBus.h"
+
+#define HOST_TX_FIFO_DEPTH  32      // as set up by the library's CAN driver
+#define HOST_RX_FIFO_DEPTH  32
+#define HOST_EEPROM_SIZE    0x400
+#define HOST_FLASH_SIZE     0x20000
+
+/**
+ * Counts of the library calls and NVM operations.
+ */
+typedef struct {
+    uint32_t getNvCalls;
+    uint32_t getEvsCalls;
+    uint32_t findEventCalls;
+    uint32_t eepromReads;
+    uint32_t flashReads;
+    uint32_t eepromWrites;
+    uint32_t flashErases;
+    uint32_t flashWrites;
+    uint32_t messagesSent;
+    uint32_t sendFailures;      // TX FIFO full
+    uint32_t messagesReceived;
+    uint32_t rxOverruns;        // RX FIFO full when a frame arrived
+    uint32_t coeOverruns;       // own event loopback queue full
+} LibStats;
+
+extern LibStats libStats;
+
+void libReset(void);
+void libMain(void (* configure)(void));
+void libPoll(void);
+uint64_t libNextDue(void);
+void libSetEeprom(uint16_t address, uint8_t value);
+uint8_t libGetEeprom(uint16_t address);
+
+uint8_t canTxCount(void);
+const HostFrame * canTxHead(void);
+void canTxRemove(void);
+void canTxLostArbitration(void);
+uint8_t canRxPending(void);
+uint8_t canRxPush(const HostFrame * frame);
+
+/*
+ * Called for each message taken from the RX FIFO, before it is processed.
+ */
+extern void (* rxObserver)(const HostFrame * frame);
+
+#endif
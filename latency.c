@@ -0,0 +1,155 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Latency histograms for the CANPANEL.
+ *
+ * Two latencies are measured using the library's tick timer:
+ * - from APP_processConsumedEvent() being called to the last SPI write of the
+ *   LED changes it caused. The LED changes of overlapping events go out 
+ *   together so only one is timed at a time, from the earliest start.
+ * - from keyScan() first seeing a button edge to the produced event being 
+ *   passed to the CAN driver. Each button has its own start time so a bounce
+ *   on one button doesn't lose the timing of another.
+ * The buckets are log2 so a few bytes of RAM cover 16us to 
+ * 0.5s, counts stick at 0xFFFF. The histograms can be read and reset using
+ * RDGN, see panelDiag.c.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include <string.h>
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "latency.h"
+
+#ifdef LATENCY
+
+uint16_t latencyHistogram[NUM_LATENCY_HISTOGRAMS][NUM_LATENCY_BUCKETS];
+
+static TickValue startTime[NUM_LATENCY_HISTOGRAMS];
+static uint8_t pending;     // one bit per histogram being timed
+static uint16_t pressStart[NUM_PB];             // low word of the tick time, wraps after 1s which is far longer than a press takes to send
+static uint8_t pressPending[(NUM_PB+7)/8];      // one bit per PB being timed
+
+static void latencyAdd(uint8_t hist, uint32_t elapsed);
+
+/**
+ * Clear the histograms.
+ */
+void resetLatency(void) {
+    memset((void *)latencyHistogram, 0, sizeof(latencyHistogram));
+    memset((void *)pressPending, 0, sizeof(pressPending));
+    pending = 0;
+}
+
+/**
+ * Start timing, unless already timing.
+ * @param hist the LATENCY_ histogram
+ */
+void latencyStart(uint8_t hist) {
+    if ( ! (pending & (1 << hist))) {
+        startTime[hist].val = tickGet();
+        pending |= (uint8_t)(1 << hist);
+    }
+}
+
+/**
+ * Add the time since latencyStart() to the histogram.
+ * @param hist the LATENCY_ histogram
+ */
+void latencyEnd(uint8_t hist) {
+    if ( ! (pending & (1 << hist))) {
+        return;
+    }
+    pending &= (uint8_t)~(1 << hist);
+    latencyAdd(hist, tickTimeSince(startTime[hist]));
+}
+
+/**
+ * Stop timing without recording.
+ * @param hist the LATENCY_ histogram
+ */
+void latencyCancel(uint8_t hist) {
+    pending &= (uint8_t)~(1 << hist);
+}
+
+/**
+ * Start timing a button's first edge, unless already timing it.
+ * @param pb the PB
+ */
+void latencyPressStart(uint8_t pb) {
+    if ( ! (pressPending[pb/8] & (1 << (pb%8)))) {
+        pressStart[pb] = (uint16_t)tickGet();
+        pressPending[pb/8] |= (uint8_t)(1 << (pb%8));
+    }
+}
+
+/**
+ * Add the time since latencyPressStart() for the same button to the 
+ * LATENCY_PRESS_TO_TX histogram.
+ * @param pb the PB
+ */
+void latencyPressEnd(uint8_t pb) {
+    if ( ! (pressPending[pb/8] & (1 << (pb%8)))) {
+        return;
+    }
+    pressPending[pb/8] &= (uint8_t)~(1 << (pb%8));
+    latencyAdd(LATENCY_PRESS_TO_TX, (uint16_t)((uint16_t)tickGet() - pressStart[pb]));
+}
+
+/**
+ * Stop timing a button without recording.
+ * @param pb the PB
+ */
+void latencyPressCancel(uint8_t pb) {
+    pressPending[pb/8] &= (uint8_t)~(1 << (pb%8));
+}
+
+/**
+ * Count a latency in its histogram.
+ * @param hist the LATENCY_ histogram
+ * @param elapsed the latency in ticks
+ */
+static void latencyAdd(uint8_t hist, uint32_t elapsed) {
+    uint8_t bucket;
+    
+    for (bucket = 0; (elapsed != 0) && (bucket < NUM_LATENCY_BUCKETS-1); bucket++) {
+        elapsed >>= 1;
+    }
+    if (latencyHistogram[hist][bucket] != 0xFFFF) {
+        latencyHistogram[hist][bucket]++;
+    }
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Optional histograms of the end to end latencies an operator notices.
+ * 
+ * LATENCY_START(hist) notes the time something started, unless one is already
+ * being timed, and LATENCY_END(hist) adds the time since then to the 
+ * histogram. LATENCY_CANCEL(hist) forgets the start without recording it.
+ * The LATENCY_PRESS_ macros do the same for LATENCY_PRESS_TO_TX with a start
+ * time for each button.
+ * When LATENCY is not defined the macros compile to nothing.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+
+#define LATENCY_RX_TO_LED       0   // consumed event to the last LED write
+#define LATENCY_PRESS_TO_TX     1   // first edge of a button to the event being sent
+#define NUM_LATENCY_HISTOGRAMS  2
+
+// Bucket 0 is under one tick (16us), bucket n is 2^(n-1) to 2^n-1 ticks, the
+// last bucket also takes anything longer
+#define NUM_LATENCY_BUCKETS     16
+
+#ifdef LATENCY
+extern uint16_t latencyHistogram[NUM_LATENCY_HISTOGRAMS][NUM_LATENCY_BUCKETS];
+
+void resetLatency(void);
+void latencyStart(uint8_t hist);
+void latencyEnd(uint8_t hist);
+void latencyCancel(uint8_t hist);
+void latencyPressStart(uint8_t pb);
+void latencyPressEnd(uint8_t pb);
+void latencyPressCancel(uint8_t pb);
+#define LATENCY_START(hist)     latencyStart(hist)
+#define LATENCY_END(hist)       latencyEnd(hist)
+#define LATENCY_CANCEL(hist)    latencyCancel(hist)
+#define LATENCY_PRESS_START(pb) latencyPressStart(pb)
+#define LATENCY_PRESS_END(pb)   latencyPressEnd(pb)
+#define LATENCY_PRESS_CANCEL(pb) latencyPressCancel(pb)
+#else
+#define LATENCY_START(hist)
+#define LATENCY_END(hist)
+#define LATENCY_CANCEL(hist)
+#define LATENCY_PRESS_START(pb)
+#define LATENCY_PRESS_END(pb)
+#define LATENCY_PRESS_CANCEL(pb)
+#endif
+
+#endif
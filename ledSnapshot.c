@@ -0,0 +1,223 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * LED and toggle state snapshots for the CANPANEL.
+ *
+ * The LED map and the toggle button output states are saved to EEPROM so that
+ * after a power cycle the panel can show its last state as soon as the LED 
+ * driver is initialised, rather than staying blank until the SOD. LEDs with a
+ * timer pending to turn them off are saved as off, as nothing would turn them
+ * off after a restore.
+ * 
+ * The snapshots are written to a ring of slots so each slot is only written 
+ * once every SNAPSHOT_SLOTS snapshots. Each slot holds the state, a checksum
+ * and a sequence number and the slot with the newest sequence number and a 
+ * good checksum is used at power up. 
+ * 
+ * A snapshot is only taken once the state has been unchanged for 
+ * SNAPSHOT_QUIET_TIME so a burst of changes results in a single snapshot. 
+ * The state is only gathered again when snapshotDirty has been set by a 
+ * change to the LEDs, their timers or the toggle states, as looking at every
+ * LED's timer on each poll would cost more than the rest of the poll.
+ * The snapshot is written one byte per poll, when flashQuietTime() 
+ * allows, with the sequence number last so a partly written slot is never used.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include <string.h>
+#include "vlcb.h"
+#include "module.h"
+#include "nvm.h"
+#include "nv.h"
+#include "ticktime.h"
+#include "ledSnapshot.h"
+#include "buttonscan.h"
+#include "max6951.h"
+#include "flashSchedule.h"
+#include "ledTimer.h"
+
+#ifdef LED_SNAPSHOT
+
+#if (SNAPSHOT_DATA_SIZE + 2) > SNAPSHOT_SLOT_SIZE
+#error "LED snapshot doesn't fit in the slot"
+#endif
+
+#define SLOT_ADDRESS(s)     (SNAPSHOT_ADDRESS + (uint16_t)(s)*SNAPSHOT_SLOT_SIZE)
+#define CHECKSUM_OFFSET     SNAPSHOT_DATA_SIZE
+#define SEQUENCE_OFFSET     (SNAPSHOT_DATA_SIZE + 1)
+#define NOT_WRITING         0xFF
+
+static uint8_t seen[SNAPSHOT_DATA_SIZE];        // the state when last looked at
+static uint8_t saved[SNAPSHOT_DATA_SIZE];       // the state in the newest snapshot
+static uint8_t writeBuffer[SNAPSHOT_DATA_SIZE + 2];
+static uint8_t writeIndex = NOT_WRITING;        // next byte of writeBuffer to be written
+static uint8_t slot;                            // slot of the newest snapshot
+static uint8_t sequence;                        // sequence number of the newest snapshot
+static TickValue lastChangeTime;
+static Boolean unsaved;                         // seen may differ from saved
+volatile uint8_t snapshotDirty;
+
+/**
+ * Gather the current state into a buffer.
+ * @param buffer SNAPSHOT_DATA_SIZE bytes
+ */
+static void getState(uint8_t * buffer) {
+    uint8_t col;
+    uint8_t led;
+    
+    memcpy((void *)buffer, (void *)ledsMap, sizeof(ledsMap));
+    // LEDs which will turn themselves off are saved as off
+    for (led = 1; led <= NUM_LED; led++) {
+        if (ledTimerPending(led)) {
+            clearLedInMap((LedsMap *)buffer, led);
+        }
+    }
+    for (col = 0; col < COLUMN_OUTPUTS; col++) {
+        buffer[sizeof(ledsMap) + col] = getColumnOutputState(col);
+    }
+}
+
+/**
+ * Checksum over the state and sequence number.
+ */
+static uint8_t checksum(uint8_t * buffer, uint8_t seq) {
+    uint8_t i;
+    uint8_t sum;
+    
+    sum = seq;
+    for (i = 0; i < SNAPSHOT_DATA_SIZE; i++) {
+        sum = (uint8_t)((sum << 1) | (sum >> 7)) + buffer[i];
+    }
+    return (uint8_t)~sum;
+}
+
+/**
+ * Find the newest good snapshot and show it. Must be called after the LED
+ * driver and the key scan have been initialised.
+ */
+void snapshotRestore(void) {
+    uint8_t s;
+    uint8_t i;
+    uint8_t seq;
+    Boolean found;
+    
+    found = FALSE;
+    slot = SNAPSHOT_SLOTS - 1;
+    sequence = 0;
+    
+    for (s = 0; s < SNAPSHOT_SLOTS; s++) {
+        for (i = 0; i < SNAPSHOT_DATA_SIZE; i++) {
+            writeBuffer[i] = (uint8_t)readNVM(EEPROM_NVM_TYPE, SLOT_ADDRESS(s) + i);
+        }
+        seq = (uint8_t)readNVM(EEPROM_NVM_TYPE, SLOT_ADDRESS(s) + SEQUENCE_OFFSET);
+        if ((uint8_t)readNVM(EEPROM_NVM_TYPE, SLOT_ADDRESS(s) + CHECKSUM_OFFSET) != checksum(writeBuffer, seq)) {
+            continue;
+        }
+        // sequence numbers wrap so compare the difference
+        if ( ! found || ((int8_t)(seq - sequence) > 0)) {
+            found = TRUE;
+            slot = s;
+            sequence = seq;
+            memcpy((void *)saved, (void *)writeBuffer, SNAPSHOT_DATA_SIZE);
+        }
+    }
+    if (found && (getNV(NV_PANEL_FLAGS) & NV_PANEL_FLAGS_SNAPSHOT)) {
+        restoreLedsMap((LedsMap *)saved);
+        for (i = 0; i < COLUMN_OUTPUTS; i++) {
+            restoreToggleState(i, saved[sizeof(ledsMap) + i]);
+        }
+    }
+    snapshotDirty = FALSE;
+    getState(seen);
+    if ( ! found) {
+        // make sure the first snapshot gets written
+        saved[0] = (uint8_t)~seen[0];
+    }
+    unsaved = (memcmp((void *)seen, (void *)saved, SNAPSHOT_DATA_SIZE) != 0);
+    lastChangeTime.val = tickGet();
+}
+
+/**
+ * Called regularly from the main loop. Looks for changes to the state and 
+ * writes the snapshot a byte at a time once things have gone quiet.
+ */
+void snapshotPoll(void) {
+    uint8_t current[SNAPSHOT_DATA_SIZE];
+    
+    if ( ! (getNV(NV_PANEL_FLAGS) & NV_PANEL_FLAGS_SNAPSHOT)) {
+        return;
+    }
+    if (writeIndex != NOT_WRITING) {
+        if ( ! flashQuietTime()) {
+            return;
+        }
+        writeNVM(EEPROM_NVM_TYPE, SLOT_ADDRESS(slot) + writeIndex, writeBuffer[writeIndex]);
+        writeIndex++;
+        if (writeIndex >= sizeof(writeBuffer)) {
+            writeIndex = NOT_WRITING;
+        }
+        return;
+    }
+    
+    if (snapshotDirty) {
+        // cleared first so a change by the key scan interrupt isn't missed
+        snapshotDirty = FALSE;
+        getState(current);
+        if (memcmp((void *)current, (void *)seen, SNAPSHOT_DATA_SIZE) != 0) {
+            memcpy((void *)seen, (void *)current, SNAPSHOT_DATA_SIZE);
+            lastChangeTime.val = tickGet();
+            unsaved = TRUE;
+            return;
+        }
+    }
+    if ( ! unsaved || (tickTimeSince(lastChangeTime) < SNAPSHOT_QUIET_TIME)) {
+        return;
+    }
+    unsaved = FALSE;
+    if (memcmp((void *)seen, (void *)saved, SNAPSHOT_DATA_SIZE) == 0) {
+        return;
+    }
+    // start a new snapshot in the next slot
+    memcpy((void *)saved, (void *)seen, SNAPSHOT_DATA_SIZE);
+    memcpy((void *)writeBuffer, (void *)seen, SNAPSHOT_DATA_SIZE);
+    if (++slot >= SNAPSHOT_SLOTS) {
+        slot = 0;
+    }
+    sequence++;
+    writeBuffer[CHECKSUM_OFFSET] = checksum(writeBuffer, sequence);
+    writeBuffer[SEQUENCE_OFFSET] = sequence;
+    writeIndex = 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef _LEDSNAPSHOT_H_
+#define _LEDSNAPSHOT_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Keep a copy of the LED and toggle button states in EEPROM so the panel can
+ * show its last state straight away after a power cycle.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+#include "matrix.h"
+#include "max6951.h"
+
+// EEPROM area used for the ring of snapshots
+#define SNAPSHOT_ADDRESS        0x000
+#define SNAPSHOT_SIZE           0x200
+// Bytes of state in each slot, followed by a checksum and a sequence number
+#define SNAPSHOT_DATA_SIZE      (2*8*NUM_MAX_CHIPS + COLUMN_OUTPUTS)  // LedsMaps and the toggle states
+#if SNAPSHOT_DATA_SIZE + 2 <= 32
+#define SNAPSHOT_SLOT_SIZE      32
+#elif SNAPSHOT_DATA_SIZE + 2 <= 64
+#define SNAPSHOT_SLOT_SIZE      64
+#else
+#define SNAPSHOT_SLOT_SIZE      128
+#endif
+#define SNAPSHOT_SLOTS          (SNAPSHOT_SIZE/SNAPSHOT_SLOT_SIZE)
+// How long the state must stay the same before it is written
+#define SNAPSHOT_QUIET_TIME     (2*ONE_SECOND)
+
+#ifdef LED_SNAPSHOT
+// Set when the LEDs, their timers or the toggle states may have changed, so
+// the state is only gathered again after a change
+extern volatile uint8_t snapshotDirty;
+#define SNAPSHOT_CHANGED()  (snapshotDirty = TRUE)
+#else
+#define SNAPSHOT_CHANGED()
+#endif
+
+void snapshotRestore(void);
+void snapshotPoll(void);
+
+#endif
@@ -0,0 +1,181 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Timed LED changes using a hashed timing wheel.
+ *
+ * The wheel has LED_TIMER_SLOTS slots of LED_TIMER_TICK and moves on one slot
+ * each tick. A timer goes into the slot it expires in, with the number of
+ * whole turns of the wheel still to wait. Each slot is a doubly linked list
+ * threaded through per LED arrays, so every LED can have a timer pending in
+ * a fixed amount of RAM, LED_TIMER_RAM, and starting or cancelling a timer
+ * takes the same time however many are pending. Each tick only looks at the
+ * timers in the slot it reaches, so expiring a timer doesn't depend on the
+ * timers in the other slots.
+ *
+ * An expired timer turns its LED off with setOff(), so the change is sent 
+ * with the other LED changes by flushLeds().
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "ledTimer.h"
+#include "max6951.h"
+#include "ledSnapshot.h"
+
+#define NO_LED          0xFF    // end of a slot's list
+#define NOT_PENDING     0xFF    // timerSlot[] of an LED without a timer
+
+static uint8_t wheel[LED_TIMER_SLOTS];      // first LED in each slot, or NO_LED
+static uint8_t timerNext[NUM_LED];          // next LED in the same slot
+static uint8_t timerPrev[NUM_LED];          // previous LED in the same slot, NO_LED for the first
+static uint8_t timerRounds[NUM_LED];        // turns of the wheel before the timer expires
+static uint8_t timerSlot[NUM_LED];          // slot holding the LED, or NOT_PENDING
+static uint8_t wheelPosition;               // the slot of the current tick
+static TickValue lastTick;
+
+// forward declarations
+static void unlinkTimer(uint8_t led);
+
+/**
+ * Initialise the timing wheel with no timers pending.
+ */
+void ledTimerInit(void) {
+    uint8_t i;
+    
+    for (i = 0; i < LED_TIMER_SLOTS; i++) {
+        wheel[i] = NO_LED;
+    }
+    for (i = 0; i < NUM_LED; i++) {
+        timerSlot[i] = NOT_PENDING;
+    }
+    wheelPosition = 0;
+    lastTick.val = tickGet();
+}
+
+/**
+ * Start a timer to turn an LED off, replacing any timer already pending for
+ * the LED.
+ * @param ledNumber the LED, 1 based
+ * @param ticks the time in LED_TIMER_TICKs, 0 for no timer
+ */
+void ledTimerStart(uint8_t ledNumber, uint8_t ticks) {
+    uint8_t led;
+    uint8_t slot;
+    
+    if ((ledNumber == 0) || (ledNumber > NUM_LED)) {
+        return;
+    }
+    led = ledNumber - 1;
+    unlinkTimer(led);
+    if (ticks == 0) {
+        return;
+    }
+    slot = (wheelPosition + ticks) & (LED_TIMER_SLOTS - 1);
+    timerRounds[led] = (uint8_t)((ticks - 1) / LED_TIMER_SLOTS);
+    timerSlot[led] = slot;
+    timerPrev[led] = NO_LED;
+    timerNext[led] = wheel[slot];
+    if (wheel[slot] != NO_LED) {
+        timerPrev[wheel[slot]] = led;
+    }
+    wheel[slot] = led;
+    SNAPSHOT_CHANGED();
+}
+
+/**
+ * Cancel any timer pending for an LED.
+ * @param ledNumber the LED, 1 based
+ */
+void ledTimerCancel(uint8_t ledNumber) {
+    if ((ledNumber == 0) || (ledNumber > NUM_LED)) {
+        return;
+    }
+    unlinkTimer(ledNumber - 1);
+}
+
+/**
+ * @param ledNumber the LED, 1 based
+ * @return TRUE if the LED has a timer pending
+ */
+Boolean ledTimerPending(uint8_t ledNumber) {
+    if ((ledNumber == 0) || (ledNumber > NUM_LED)) {
+        return FALSE;
+    }
+    return timerSlot[ledNumber - 1] != NOT_PENDING;
+}
+
+/**
+ * Remove an LED from its slot's list.
+ * @param led the LED, 0 based
+ */
+static void unlinkTimer(uint8_t led) {
+    if (timerSlot[led] == NOT_PENDING) {
+        return;
+    }
+    if (timerPrev[led] == NO_LED) {
+        wheel[timerSlot[led]] = timerNext[led];
+    } else {
+        timerNext[timerPrev[led]] = timerNext[led];
+    }
+    if (timerNext[led] != NO_LED) {
+        timerPrev[timerNext[led]] = timerPrev[led];
+    }
+    timerSlot[led] = NOT_PENDING;
+    SNAPSHOT_CHANGED();
+}
+
+/**
+ * Move the wheel on for each tick which has passed and expire the timers in 
+ * the slots reached.
+ */
+void ledTimerPoll(void) {
+    uint8_t led;
+    uint8_t next;
+    
+    while (tickTimeSince(lastTick) >= (uint32_t)LED_TIMER_TICK * ONE_MILI_SECOND) {
+        lastTick.val += (uint32_t)LED_TIMER_TICK * ONE_MILI_SECOND;
+        wheelPosition = (wheelPosition + 1) & (LED_TIMER_SLOTS - 1);
+        for (led = wheel[wheelPosition]; led != NO_LED; led = next) {
+            next = timerNext[led];
+            if (timerRounds[led] != 0) {
+                timerRounds[led]--;
+            } else {
+                unlinkTimer(led);
+                setOff(led + 1);
+            }
+        }
+    }
+}
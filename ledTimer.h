@@ -0,0 +1,58 @@
+#ifndef _LEDTIMER_H_
+#define _LEDTIMER_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Timed LED changes, used to turn an LED off again a while after an action 
+ * turned it on.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+#include "ticktime.h"
+
+// Length of each slot of the timing wheel (ms)
+#define LED_TIMER_TICK      100
+// Number of slots in the timing wheel, must be a power of 2
+#define LED_TIMER_SLOTS     32
+// Bytes of RAM used by the wheel, however many timers are pending
+#define LED_TIMER_RAM       (LED_TIMER_SLOTS + 4*NUM_LED + 1 + sizeof(TickValue))
+
+void ledTimerInit(void);
+void ledTimerStart(uint8_t ledNumber, uint8_t ticks);
+void ledTimerCancel(uint8_t ledNumber);
+Boolean ledTimerPending(uint8_t ledNumber);
+void ledTimerPoll(void);
+
+#endif
@@ -93,6 +93,15 @@
 #include "timedResponse.h"
 #include "buttonscan.h"
 #include "max6951.h"
+#include "fastClock.h"
+#include "startup.h"
+#include "ledSnapshot.h"
+#include "flashSchedule.h"
+#include "scheduler.h"
+#include "profile.h"
+#include "panelDiag.h"
+#include "busMonitor.h"
+#include "ledTimer.h"
 #include "event_consumer_simple.h"
 
 
@@ -108,10 +117,7 @@ void factoryResetEE(void);
 void factoryResetFlash(void);
 
 
-static TickValue   startTime;
 static uint8_t        started;
-static TickValue   lastInputScanTime;
-static uint8_t io;
 
 const Service * const services[] = {
     &canService,
@@ -126,15 +132,35 @@ const Service * const services[] = {
 };
 
 
+// forward declarations of the tasks
+static void startupTask(void);
+static void keyScanTask(void);
+static void stateRequestTask(void);
+static void snapshotTask(void);
+
+/*
+ * The activities run from loop(), the most urgent first. 
+ * The SOD responses are paced by the library's timed response.
+ */
+const Task tasks[NUM_TASKS] = {
+    // run                  period                      deadline                    priority
+    {keyScanTask,           KEY_SCAN_INTERVAL,          5*ONE_MILI_SECOND,          0},
+    {flushLeds,             ONE_MILI_SECOND,            5*ONE_MILI_SECOND,          1},
+    {startupTask,           10*ONE_MILI_SECOND,         HUNDRED_MILI_SECOND,        2},
+    {stateRequestTask,      ONE_MILI_SECOND,            HUNDRED_MILI_SECOND,        3},
+    {snapshotTask,          10*ONE_MILI_SECOND,         HUNDRED_MILI_SECOND,        4},
+    {busMonitorPoll,        10*ONE_MILI_SECOND,         50*ONE_MILI_SECOND,         5},
+    {ledTimerPoll,          10*ONE_MILI_SECOND,         50*ONE_MILI_SECOND,         6}
+};
+
 /**
  * Called at first run to initialise all the non volatile memory. 
  * Also called if the PB hold down special sequence at power up is done.
  * Also called as a result of a NNRSM request.
  */
 void APP_factoryReset(void) {
-    uint8_t io;
-    
     factoryResetGlobalEvents();
+    resetLedMap();
     // perform other actions based upon type
 
     flushFlashBlock();
@@ -152,9 +178,7 @@ void APP_testMode(void) {
  * Called upon power up.
  */
 void setup(void) {
-#if defined(_18FXXQ83_FAMILY_)
-    uint8_t pu;
-#endif
+    uint8_t group;
     // use CAN as the module's transport
     transport = &canTransport;
 
@@ -168,15 +192,13 @@ void setup(void) {
     WPUB = (uint8_t)getNV(NV_PULLUPS);
 #endif
 #if defined(_18FXXQ83_FAMILY_)
-    // enable pullups on all channels
-    pu = 0xFF;
-
+    // weak pullups off on all ports
     WPUA = 0;
     WPUB = 0;
     WPUC = 0;
 
 #endif
-    setTimedResponseDelay((uint8_t)getNV(NV_RESPONSE_DELAY));
+    setResponseDelayBounds((uint8_t)getNV(NV_RESPONSE_DELAY_MIN), (uint8_t)getNV(NV_RESPONSE_DELAY));
     panelEventsInit();
 
 #if defined(_18F66K80_FAMILY_)
@@ -188,53 +210,113 @@ void setup(void) {
     ANSELA = 0x00;
     ANSELB = 0x00;
     ANSELC = 0x00;
+#endif
+#ifdef PROFILE
+    initProfile();
 #endif
     initKeyscan();
     initLedDriver((uint8_t)getNV(NV_BRIGHTNESS));
+    for (group = 0; group < NUM_LED_GROUPS; group++) {
+        setLedGroup(group, (uint8_t)getNV(NV_LED_GROUP_FIRST(group)), (uint8_t)getNV(NV_LED_GROUP_LAST(group)));
+    }
+#ifdef LED_SNAPSHOT
+    snapshotRestore();
+#endif
+    fastClockInit();
+    busMonitorInit();
+    ledTimerInit();
+    startupInit();
     // enable interrupts, all init now done
     ei(); 
 
-    startTime.val = tickGet();
-    lastInputScanTime.val = startTime.val;
     started = FALSE;
+    schedulerInit();
 }
 
 void loop(void) {
-    // Startup delay for CBUS about 2 seconds to let other modules get powered up - ISR will be running so incoming packets processed
-    if (!started && (tickTimeSince(startTime) > (getNV(NV_SOD_DELAY) * HUNDRED_MILI_SECOND) + TWO_SECOND)) {
+    PROFILE_START(PROFILE_LOOP);
+    flashScheduleLoop();
+    schedulerRun();
+    PROFILE_END(PROFILE_LOOP);
+}
+
+/**
+ * Startup delay for CBUS about 2 seconds to let other modules get powered up - 
+ * ISR will be running so incoming packets processed plus an offset so that all 
+ * the panels don't do their SOD together.
+ */
+static void startupTask(void) {
+    if (!started && startupDue()) {
         started = TRUE;
         sendProducedEvent(HAPPENING_SOD, EVENT_ON);
+        startStateRequests();
+#ifdef KEYSCAN_ISR
+        startKeyscanTimer();
+#endif
     }
+}
 
+/**
+ * Scan the buttons once the start up delay is over.
+ */
+static void keyScanTask(void) {
     if (started) {
-        if (tickTimeSince(lastInputScanTime) > 10*ONE_MILI_SECOND) {
-            lastInputScanTime.val = tickGet();
-            keyScan();
-        }
+        PROFILE_START(PROFILE_KEYSCAN);
+        keyScan();
+        PROFILE_END(PROFILE_KEYSCAN);
     }
 }
 
+/**
+ * Send the next start up state request.
+ */
+static void stateRequestTask(void) {
+    if (started) {
+        pollStateRequests();
+    }
+}
+
+/**
+ * Look after the EEPROM snapshot of the LED state.
+ */
+static void snapshotTask(void) {
+#ifdef LED_SNAPSHOT
+    snapshotPoll();
+#endif
+}
+
 // Application functions required by MERGLCB library
 
 
 /**
  * Check to see if now is a good time to start a flash write.
- * It is a bad time if we are currently doing a servo pulse.
- * 
- * If a servo pulse timer is currently running then the NVM routine will keep 
- * calling this until the timer expires.
+ * The NVM routine spins until this returns GOOD_TIME so it always does, 
+ * see flashSchedule.c.
  * 
  * @return GOOD_TIME if OK else BAD_TIME
  */
 ValidTime APP_isSuitableTimeToWriteFlash(void){
-    return GOOD_TIME;
+    return flashWriteAllowed();
 }
 
 /**
- * This application doesn't need to process any messages in a special way.
+ * The fast clock broadcasts and the responses to our state requests are 
+ * handled here as no service consumes them, as is the reading of the NV
+ * which shows the LED remap table.
+ * Received traffic is also counted to help schedule the start of day.
  */
 Processed APP_preProcessMessage(Message * m) {
-    return NOT_PROCESSED;
+    busMonitorMessage(m);
+    if (stateResponseMessage(m) == PROCESSED) {
+        return PROCESSED;
+    }
+    if (panelDiagMessage(m) == PROCESSED) {
+        return PROCESSED;
+    }
+    if (ledMapNvMessage(m) == PROCESSED) {
+        return PROCESSED;
+    }
+    return fastClockMessage(m);
 }
 
 /**
@@ -261,6 +343,11 @@ EventState APP_GetEventState(Happening h) {
 #if defined(_18F66K80_FAMILY_)
 // APP Interrupt service routines
 void APP_lowIsr(void) {
+#ifdef KEYSCAN_ISR
+    if (PIE1bits.TMR2IE && PIR1bits.TMR2IF) {
+        keyScanIsr();
+    }
+#endif
 }
 
 // Interrupt service routines
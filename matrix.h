@@ -57,9 +57,17 @@ extern "C" {
 #endif
 
 
-#define COLUMN_OUTPUTS      8
+#define NATIVE_COLUMNS      8                       // Columns strobed directly from COL_LAT
+#ifndef EXTRA_COLUMNS
+#define EXTRA_COLUMNS       0                       // Columns from 74HC595 shift registers, multiple of 8
+#endif
+#define COLUMN_OUTPUTS      (NATIVE_COLUMNS + EXTRA_COLUMNS)
 #define ROW_INPUTS          8
 
+#if (EXTRA_COLUMNS % 8) != 0
+#error "EXTRA_COLUMNS must be a multiple of 8"
+#endif
+
 
 // Column output definitions
 
@@ -83,27 +91,64 @@ extern "C" {
 #define KBD_STROBE7         LATCbits.LATC7
 #define KBD_STROBE7_TRIS    TRISCbits.TRISC7
 
+// Extra column shift registers. The chain is clocked and fed from the SPI SCK
+// and SDO pins, bit banged with the SPI off, so it also sees the MAX traffic.
+// Only the storage register latch needs a pin of its own.
+
+#define EXT_CLOCK           LATCbits.LATC3          // 74HC595 SRCLK, shares with SPI SCK
+#define EXT_DATA            LATCbits.LATC5          // 74HC595 SER, shares with SPI SDO
+#define EXT_LATCH           LATAbits.LATA7          // 74HC595 RCLK, needs OSC1/OSC2 free for I/O
+#define EXT_LATCH_TRIS      TRISAbits.TRISA7
+
 
-// Row input definitions
+// Row input definitions. Each row is given once as a port letter and bit 
+// number. The pin and TRIS names, and the lookup tables which gather the rows
+// from one read of each port, are all derived from these.
 
 #define ROW_MASK            0b11111111
 
-#define KBD_INP0            PORTBbits.RB0
-#define KBD_INP0_TRIS       TRISBbits.TRISB0
-#define KBD_INP1            PORTBbits.RB1
-#define KBD_INP1_TRIS       TRISBbits.TRISB1
-#define KBD_INP2            PORTBbits.RB4
-#define KBD_INP2_TRIS       TRISBbits.TRISB4
-#define KBD_INP3            PORTBbits.RB5
-#define KBD_INP3_TRIS       TRISBbits.TRISB5
-#define KBD_INP4            PORTAbits.RA5
-#define KBD_INP4_TRIS       TRISAbits.TRISA5
-#define KBD_INP5            PORTAbits.RA3
-#define KBD_INP5_TRIS       TRISAbits.TRISA3
-#define KBD_INP6            PORTAbits.RA1
-#define KBD_INP6_TRIS       TRISAbits.TRISA1
-#define KBD_INP7            PORTAbits.RA0
-#define KBD_INP7_TRIS       TRISAbits.TRISA0
+#define KBD_INP0_PORT       B
+#define KBD_INP0_BIT        0
+#define KBD_INP1_PORT       B
+#define KBD_INP1_BIT        1
+#define KBD_INP2_PORT       B
+#define KBD_INP2_BIT        4
+#define KBD_INP3_PORT       B
+#define KBD_INP3_BIT        5
+#define KBD_INP4_PORT       A
+#define KBD_INP4_BIT        5
+#define KBD_INP5_PORT       A
+#define KBD_INP5_BIT        3
+#define KBD_INP6_PORT       A
+#define KBD_INP6_BIT        1
+#define KBD_INP7_PORT       A
+#define KBD_INP7_BIT        0
+
+#define KBD_PORT_A          0
+#define KBD_PORT_B          1
+#define KBD_PORT_ID(port)   KBD_PORT_ID_(port)
+#define KBD_PORT_ID_(port)  KBD_PORT_##port
+#define KBD_PIN(port, bit)  KBD_PIN_(port, bit)
+#define KBD_PIN_(port, bit) PORT##port##bits.R##port##bit
+#define KBD_TRIS(port, bit) KBD_TRIS_(port, bit)
+#define KBD_TRIS_(port, bit) TRIS##port##bits.TRIS##port##bit
+
+#define KBD_INP0            KBD_PIN(KBD_INP0_PORT, KBD_INP0_BIT)
+#define KBD_INP0_TRIS       KBD_TRIS(KBD_INP0_PORT, KBD_INP0_BIT)
+#define KBD_INP1            KBD_PIN(KBD_INP1_PORT, KBD_INP1_BIT)
+#define KBD_INP1_TRIS       KBD_TRIS(KBD_INP1_PORT, KBD_INP1_BIT)
+#define KBD_INP2            KBD_PIN(KBD_INP2_PORT, KBD_INP2_BIT)
+#define KBD_INP2_TRIS       KBD_TRIS(KBD_INP2_PORT, KBD_INP2_BIT)
+#define KBD_INP3            KBD_PIN(KBD_INP3_PORT, KBD_INP3_BIT)
+#define KBD_INP3_TRIS       KBD_TRIS(KBD_INP3_PORT, KBD_INP3_BIT)
+#define KBD_INP4            KBD_PIN(KBD_INP4_PORT, KBD_INP4_BIT)
+#define KBD_INP4_TRIS       KBD_TRIS(KBD_INP4_PORT, KBD_INP4_BIT)
+#define KBD_INP5            KBD_PIN(KBD_INP5_PORT, KBD_INP5_BIT)
+#define KBD_INP5_TRIS       KBD_TRIS(KBD_INP5_PORT, KBD_INP5_BIT)
+#define KBD_INP6            KBD_PIN(KBD_INP6_PORT, KBD_INP6_BIT)
+#define KBD_INP6_TRIS       KBD_TRIS(KBD_INP6_PORT, KBD_INP6_BIT)
+#define KBD_INP7            KBD_PIN(KBD_INP7_PORT, KBD_INP7_BIT)
+#define KBD_INP7_TRIS       KBD_TRIS(KBD_INP7_PORT, KBD_INP7_BIT)
 
 
 #ifdef	__cplusplus
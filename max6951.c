@@ -56,6 +56,15 @@
 #include "max6951.h"
 #include "vlcb.h"
 #include "module.h"
+#include "portArbiter.h"
+#include "profile.h"
+#include "latency.h"
+#include "opCost.h"
+#include "trace.h"
+#include "nvm.h"
+#include "nv.h"
+#include "mns.h"
+#include "ledSnapshot.h"
 
 
 // Character generator for ascii characters onto 7 seg display (quite a few compromises!)
@@ -76,11 +85,34 @@ const char HELLO[] = "HELLO";
 
 // In memory status of LEDs
 // Copy of MAX chip registers, we need to keep copies in RAM because MAX chip is write only
-LedsMap ledsMap;
+LedsMap ledsMap[NUM_MAX_CHIPS];
 uint8_t decodeMode;
+static uint8_t dirtyDigits[NUM_MAX_CHIPS];    // digits changed in ledsMap but not yet sent to the chip
+static uint8_t groupDigits[NUM_MAX_CHIPS];    // dirty digits of an exclusive group change, sent together
+// Where each LED is wired, built from the remap table by loadLedMap()
+static uint8_t ledDigit[NUM_LED];             // chip*8 + digit
+static uint8_t ledSegMask[NUM_LED];           // segment bit within the digit
+// Exclusive LED groups. Each group is a range of LEDs and turning one on
+// turns the rest of its group off using the group's mask of every chip.
+#define NO_LED_GROUP    0xFF
+static uint8_t ledGroup[NUM_LED];             // group of each LED, or NO_LED_GROUP
+static DigitMap groupMask[NUM_LED_GROUPS][NUM_MAX_CHIPS];
+static uint8_t groupFirst[NUM_LED_GROUPS];    // 1 based, 0 for an unused group
+static uint8_t groupLast[NUM_LED_GROUPS];
+MxStats mxStats;
+
+// The SPI session in progress
+static uint8_t mxChip;
 
 // Local function prototypes
 void sendMxCmd( uint8_t mxRegister, uint8_t mxValue );
+static void sendMxCmdAll( uint8_t mxRegister, uint8_t mxValue );
+static void mxBegin( uint8_t chip );
+static void mxWrite( uint8_t mxRegister, uint8_t mxValue );
+static void mxEnd( void );
+static void setLedPosition( uint8_t led, uint8_t physical );
+static void buildLedGroups( void );
+static void clearLedGroup( uint8_t led );
 
 
 /**
@@ -89,8 +121,6 @@ void sendMxCmd( uint8_t mxRegister, uint8_t mxValue );
  * @param brightness
  */
 void initLedDriver(uint8_t brightness) {
-    uint8_t    regadr, regval;
-
     // RC3 is used as SCK output
     // RC5 used for SDO output
     // RC6 used for MAX6951 chip select
@@ -98,6 +128,14 @@ void initLedDriver(uint8_t brightness) {
     SDO_TRIS = 0;       // SPI data output
     MX_CS_TRIS = 0;     // MAX chip select is an output
     MX_CS_IO = 1;       // Deselect to start with
+#if NUM_MAX_CHIPS > 1
+    MX_CS1_TRIS = 0;
+    MX_CS1_IO = 1;
+#endif
+#if NUM_MAX_CHIPS > 2
+    MX_CS2_TRIS = 0;
+    MX_CS2_IO = 1;
+#endif
     // set up PPS
     RC3PPS = 0x31;      //SPI1_SCK
     RC5PPS = 0x32;      //SPI1_SDO
@@ -126,24 +164,232 @@ void initLedDriver(uint8_t brightness) {
     SPI1BAUD = 0;   // BAUD set to HFINTOSC/2 i.e. 16MHz (ok for MAX chip) with idle clock low. 
     // SSP not enabled yet.
     
-    regadr = MX_CONF;
-    regval = MX_CONF_FASTBLINK + MX_CONF_BLINKON;
-
-    sendMxCmd( MX_TEST, 0);                                     // Make sure test mode is off
-    sendMxCmd( MX_CONF, MX_CONF_CLEAR );                        // Initialise with outputs shut down and all outputs off
-    sendMxCmd( MX_SCAN_LIMIT, 0XFF );                           // Show all LEDs/digits
-    sendMxCmd( MX_INTENSITY, brightness &0x0F);                 // Brightness passed in as parameter (0-15))
+    sendMxCmdAll( MX_TEST, 0);                                  // Make sure test mode is off
+    sendMxCmdAll( MX_CONF, MX_CONF_CLEAR );                     // Initialise with outputs shut down and all outputs off
+    sendMxCmdAll( MX_SCAN_LIMIT, 0XFF );                        // Show all LEDs/digits
+    sendMxCmdAll( MX_INTENSITY, brightness &0x0F);              // Brightness passed in as parameter (0-15))
     clearAllLeds();
     decodeMode = 0;
-    sendMxCmd( MX_CONF, MX_CONF_FASTBLINK + MX_CONF_BLINKON + MX_CONF_ENABLE );  // Enable outputs with blink feature enabled
+    sendMxCmdAll( MX_CONF, MX_CONF_FASTBLINK + MX_CONF_BLINKON + MX_CONF_ENABLE );  // Enable outputs with blink feature enabled
+    loadLedMap();
   //sendMxCmd( MX_TEST, 1);     // put into test mode to prove initalisation worked
 }
 
 
+/**
+ * Build the LED translation used by setOn() and friends from the remap table 
+ * in EEPROM, so the translation is a single lookup. An LED without a valid
+ * entry stays where its number puts it.
+ */
+void loadLedMap(void) {
+    uint8_t led;
+    
+    for (led = 0; led < NUM_LED; led++) {
+        setLedPosition(led, (uint8_t)readNVM(LED_MAP_NVM_TYPE, LED_MAP_ADDRESS + led));
+    }
+}
+
+/**
+ * Set the translation for one LED.
+ * @param led the LED, 0 based
+ * @param physical the LED number it is wired as, 1 based. 0 or out of range
+ * for no remapping
+ */
+static void setLedPosition(uint8_t led, uint8_t physical) {
+    if ((physical == 0) || (physical > NUM_LED)) {
+        physical = led;
+    } else {
+        physical--;
+    }
+    ledDigit[led] = physical / 8;
+    ledSegMask[led] = (uint8_t)(1 << (physical % 8));
+}
+
+/**
+ * Put every LED back where its number puts it. Called by APP_factoryReset().
+ */
+void resetLedMap(void) {
+    uint8_t led;
+    
+    for (led = 0; led < NUM_LED; led++) {
+        if (readNVM(LED_MAP_NVM_TYPE, LED_MAP_ADDRESS + led) != 0) {
+            writeNVM(LED_MAP_NVM_TYPE, LED_MAP_ADDRESS + led, 0);
+        }
+    }
+    loadLedMap();
+}
+
+/**
+ * Change where an LED is wired. The change is saved in the remap table. The
+ * LED's current state moves with it, both digits are sent by the next 
+ * flushLeds().
+ * @param ledNumber the LED, 1 based
+ * @param physical the LED number it is wired as, 0 for no remapping
+ */
+void setLedMapEntry(uint8_t ledNumber, uint8_t physical) {
+    uint8_t    chip, digNum, segMask;
+    uint8_t    plane;
+    uint8_t    lit;     // bit per plane
+    
+    if ((ledNumber == 0) || (ledNumber > NUM_LED)) {
+        return;
+    }
+    ledNumber--;
+    if (readNVM(LED_MAP_NVM_TYPE, LED_MAP_ADDRESS + ledNumber) != physical) {
+        writeNVM(LED_MAP_NVM_TYPE, LED_MAP_ADDRESS + ledNumber, physical);
+    }
+    // take the LED out of its old position
+    chip = ledDigit[ledNumber] / 8;
+    digNum = ledDigit[ledNumber] % 8;
+    segMask = ledSegMask[ledNumber];
+    lit = 0;
+    for (plane = 0; plane < 2; plane++) {
+        if (ledsMap[chip][plane][digNum] & segMask) {
+            lit |= (uint8_t)(1 << plane);
+            ledsMap[chip][plane][digNum] &= (uint8_t)~segMask;
+        }
+    }
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    
+    // and put it in the new one
+    setLedPosition(ledNumber, physical);
+    chip = ledDigit[ledNumber] / 8;
+    digNum = ledDigit[ledNumber] % 8;
+    segMask = ledSegMask[ledNumber];
+    for (plane = 0; plane < 2; plane++) {
+        if (lit & (1 << plane)) {
+            ledsMap[chip][plane][digNum] |= segMask;
+        } else {
+            ledsMap[chip][plane][digNum] &= (uint8_t)~segMask;
+        }
+    }
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    SNAPSHOT_CHANGED();
+    buildLedGroups();       // the group masks follow the wiring
+}
+
+/**
+ * @param ledNumber the LED, 1 based
+ * @return the LED number it is wired as, 0 if it isn't remapped or for an 
+ * invalid LED
+ */
+uint8_t getLedMapEntry(uint8_t ledNumber) {
+    uint8_t physical;
+    uint8_t mask;
+    
+    if ((ledNumber == 0) || (ledNumber > NUM_LED)) {
+        return 0;
+    }
+    physical = (uint8_t)(ledDigit[ledNumber - 1] * 8 + 1);
+    for (mask = ledSegMask[ledNumber - 1]; mask != 1; mask >>= 1) {
+        physical++;
+    }
+    return (physical == ledNumber) ? 0 : physical;
+}
+
+/**
+ * Answer a NVRD of NV_LED_MAP_VALUE from the remap table entry of the LED in
+ * NV_LED_MAP_SELECT, so the table is the only copy and changing the selection
+ * needs no write. The library answers every other NVRD from its NV cache, 
+ * which includes the reading of all the NVs where NV_LED_MAP_VALUE is the 
+ * value last written to it.
+ * @param m the received message
+ * @return PROCESSED if the message was a NVRD of NV_LED_MAP_VALUE
+ */
+Processed ledMapNvMessage(Message * m) {
+    if ((m->opc != OPC_NVRD) || (m->len < 4) || (m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) {
+        return NOT_PROCESSED;
+    }
+    if (m->bytes[2] != NV_LED_MAP_VALUE) {
+        return NOT_PROCESSED;
+    }
+    sendMessage4(OPC_NVANS, nn.bytes.hi, nn.bytes.lo, NV_LED_MAP_VALUE, getLedMapEntry((uint8_t)getNV(NV_LED_MAP_SELECT)));
+    return PROCESSED;
+}
+
+/**
+ * Set the range of LEDs in an exclusive group. An LED in more than one range
+ * belongs to the highest numbered group.
+ * @param group the group, 0 to NUM_LED_GROUPS-1
+ * @param first the first LED, 1 based, 0 for an unused group
+ * @param last the last LED
+ */
+void setLedGroup(uint8_t group, uint8_t first, uint8_t last) {
+    if (group >= NUM_LED_GROUPS) {
+        return;
+    }
+    groupFirst[group] = first;
+    groupLast[group] = last;
+    buildLedGroups();
+}
+
+/**
+ * Rebuild the group of each LED and the group masks from the group ranges and
+ * where the LEDs are wired.
+ */
+static void buildLedGroups(void) {
+    uint8_t group;
+    uint8_t led;
+    
+    memset( (void *) ledGroup, NO_LED_GROUP, sizeof(ledGroup) );
+    memset( (void *) groupMask, 0, sizeof(groupMask) );
+    for (group = 0; group < NUM_LED_GROUPS; group++) {
+        if (groupFirst[group] == 0) {
+            continue;
+        }
+        for (led = groupFirst[group] - 1; (led < groupLast[group]) && (led < NUM_LED); led++) {
+            ledGroup[led] = group;
+        }
+    }
+    for (led = 0; led < NUM_LED; led++) {
+        if (ledGroup[led] != NO_LED_GROUP) {
+            groupMask[ledGroup[led]][ledDigit[led] / 8][ledDigit[led] % 8] |= ledSegMask[led];
+        }
+    }
+}
+
+/**
+ * Turn off every LED in the group of an LED which is being turned on, in the
+ * same update of ledsMap so the group changes in one flush. The cost is the 
+ * same whatever the size of the group.
+ * @param led the LED, 0 based
+ */
+static void clearLedGroup(uint8_t led) {
+    uint8_t    chip, digNum;
+    uint8_t    mask;
+    DigitMap * masks;
+    
+    if (ledGroup[led] == NO_LED_GROUP) {
+        return;
+    }
+    masks = groupMask[ledGroup[led]];
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        for (digNum = 0; digNum < 8; digNum++) {
+            mask = masks[chip][digNum];
+            if (mask) {
+                ledsMap[chip][0][digNum] &= (uint8_t)~mask;
+                ledsMap[chip][1][digNum] &= (uint8_t)~mask;
+                dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+                groupDigits[chip] |= (uint8_t)(1 << digNum);
+            }
+        }
+    }
+    // the LED being turned on goes with them
+    groupDigits[ledDigit[led] / 8] |= (uint8_t)(1 << (ledDigit[led] % 8));
+}
+
+/**
+ * Change the brightness of the LEDs.
+ * @param brightness 0-15
+ */
+void setLedIntensity(uint8_t brightness) {
+    sendMxCmdAll( MX_INTENSITY, brightness &0x0F);
+}
+
 // Pass true or false to set test mode on or off
 void setLedTestMode(Boolean testMode) {
     // In the Maxim chip, test mode is all segments on at 50% duty cycle (half brightness)
-    sendMxCmd( MX_TEST, (uint8_t) testMode);
+    sendMxCmdAll( MX_TEST, (uint8_t) testMode);
 }
 
 
@@ -216,31 +462,43 @@ void showTestX(void) {
 void clearAllLeds(void) {
     uint8_t    digCount;
     uint8_t    regadr;
+    uint8_t    chip;
 
-    sendMxCmd( MX_DECODE, 0 );  //. turn off character decoding
+    sendMxCmdAll( MX_DECODE, 0 );  //. turn off character decoding
+    decodeMode = 0;
 
     for (digCount = 0; digCount < 8; digCount++) {
         regadr = MX_DIG_BOTH + digCount;
-        sendMxCmd( regadr, 0);
+        sendMxCmdAll( regadr, 0);
      }
      memset( (void *) ledsMap, 0, sizeof(ledsMap) );                     // Set in memory map to all zeroes
+     for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+         dirtyDigits[chip] = 0;
+         groupDigits[chip] = 0;
+     }
+     SNAPSHOT_CHANGED();
 }
 
 /**
  * Turn an Led ON.
+ * The change is made to ledsMap and sent to the chip by flushLeds().
+ * The rest of the LED's exclusive group, if any, is turned off.
  * @param ledNo
  */
 void setOn(uint8_t ledNumber) {
-    uint8_t    digNum, segNum;
+    uint8_t    digNum, segMask, chip;
 
-    digNum = --ledNumber/8;
-    segNum = ledNumber % 8;
+    digNum = ledDigit[--ledNumber];
+    clearLedGroup(ledNumber);
+    segMask = ledSegMask[ledNumber];
+    chip = digNum / 8;
+    digNum %= 8;
     
-    // update in memory status arrays, then send to chip
-    ledsMap[0][digNum] |= segNum;
-    ledsMap[1][digNum] |= segNum;
-    sendMxCmd( MX_DIG_P0 + digNum, ledsMap[0][digNum]);
-    sendMxCmd( MX_DIG_P1 + digNum, ledsMap[1][digNum]);
+    // update in memory status arrays, the chip is updated by flushLeds()
+    ledsMap[chip][0][digNum] |= segMask;
+    ledsMap[chip][1][digNum] |= segMask;
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    SNAPSHOT_CHANGED();
 }
 
 /**
@@ -248,16 +506,18 @@ void setOn(uint8_t ledNumber) {
  * @param ledNo
  */
 void setOff(uint8_t ledNumber) {
-    uint8_t    digNum, segNum;
+    uint8_t    digNum, segMask, chip;
 
-    digNum = --ledNumber/8;
-    segNum = ledNumber % 8;
+    digNum = ledDigit[--ledNumber];
+    segMask = ledSegMask[ledNumber];
+    chip = digNum / 8;
+    digNum %= 8;
     
-    // update in memory status arrays, then send to chip
-    ledsMap[0][digNum] &= ~segNum;
-    ledsMap[1][digNum] &= ~segNum;
-    sendMxCmd( MX_DIG_P0 + digNum, ledsMap[0][digNum]);
-    sendMxCmd( MX_DIG_P1 + digNum, ledsMap[1][digNum]);
+    // update in memory status arrays, the chip is updated by flushLeds()
+    ledsMap[chip][0][digNum] &= (uint8_t)~segMask;
+    ledsMap[chip][1][digNum] &= (uint8_t)~segMask;
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    SNAPSHOT_CHANGED();
 }
 
 
@@ -266,16 +526,19 @@ void setOff(uint8_t ledNumber) {
  * @param ledNumber
  */
 void flashLed( uint8_t ledNumber ) {
-    uint8_t    digNum, segNum;
+    uint8_t    digNum, segMask, chip;
 
-    digNum = --ledNumber/8;
-    segNum = ledNumber % 8;
+    digNum = ledDigit[--ledNumber];
+    clearLedGroup(ledNumber);
+    segMask = ledSegMask[ledNumber];
+    chip = digNum / 8;
+    digNum %= 8;
     
-    // update in memory status arrays, then send to chip
-    ledsMap[0][digNum] |= segNum;
-    ledsMap[1][digNum] &= ~segNum;
-    sendMxCmd( MX_DIG_P0 + digNum, ledsMap[0][digNum]);
-    sendMxCmd( MX_DIG_P1 + digNum, ledsMap[1][digNum]);
+    // update in memory status arrays, the chip is updated by flushLeds()
+    ledsMap[chip][0][digNum] |= segMask;
+    ledsMap[chip][1][digNum] &= (uint8_t)~segMask;
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    SNAPSHOT_CHANGED();
 }
 
 /**
@@ -283,16 +546,111 @@ void flashLed( uint8_t ledNumber ) {
  * @param ledNumber
  */
 void antiFlashLed( uint8_t ledNumber ) {
-    uint8_t    digNum, segNum;
+    uint8_t    digNum, segMask, chip;
 
-    digNum = --ledNumber/8;
-    segNum = ledNumber % 8;
+    digNum = ledDigit[--ledNumber];
+    clearLedGroup(ledNumber);
+    segMask = ledSegMask[ledNumber];
+    chip = digNum / 8;
+    digNum %= 8;
     
-    // update in memory status arrays, then send to chip
-    ledsMap[0][digNum] &= ~segNum;
-    ledsMap[1][digNum] |= segNum;
-    sendMxCmd( MX_DIG_P0 + digNum, ledsMap[0][digNum]);
-    sendMxCmd( MX_DIG_P1 + digNum, ledsMap[1][digNum]);
+    // update in memory status arrays, the chip is updated by flushLeds()
+    ledsMap[chip][0][digNum] &= (uint8_t)~segMask;
+    ledsMap[chip][1][digNum] |= segMask;
+    dirtyDigits[chip] |= (uint8_t)(1 << digNum);
+    SNAPSHOT_CHANGED();
+}
+
+/**
+ * Write the changed digits of a chip in one SPI session.
+ * @param chip the chip
+ * @param digits the digits which may be written, one bit per digit
+ * @param batch the most digits to write
+ * @return what is left of batch
+ */
+static uint8_t flushChip(uint8_t chip, uint8_t digits, uint8_t batch) {
+    uint8_t    digNum, digMask;
+    
+    digits &= dirtyDigits[chip];
+    if (digits == 0) {
+        return batch;
+    }
+    mxBegin(chip);
+    for (digNum = 0, digMask = 1; (digits != 0) && (batch != 0); digNum++, digMask <<= 1) {
+        if (digits & digMask) {
+            batch--;
+            digits &= (uint8_t)~digMask;
+            dirtyDigits[chip] &= (uint8_t)~digMask;
+            groupDigits[chip] &= (uint8_t)~digMask;
+            TRACE(TRACE_LED, chip*8 + digNum, ledsMap[chip][0][digNum], ledsMap[chip][1][digNum]);
+            if (ledsMap[chip][0][digNum] == ledsMap[chip][1][digNum]) {
+                mxWrite( MX_DIG_BOTH + digNum, ledsMap[chip][0][digNum]);
+            } else {
+                mxWrite( MX_DIG_P0 + digNum, ledsMap[chip][0][digNum]);
+                mxWrite( MX_DIG_P1 + digNum, ledsMap[chip][1][digNum]);
+            }
+        }
+    }
+    mxEnd();
+    return batch;
+}
+
+/**
+ * Send the digits changed by setOn(), setOff(), flashLed() and antiFlashLed()
+ * to the chips. Several changes to the same digit cost a single write and a
+ * digit which is the same on both planes is written to both at once.
+ * The changed digits of a chip are written in one SPI session so the cost 
+ * depends only on the number of changed digits.
+ * The digits are sent in batches between the button column reads so any 
+ * left over are sent next time. The digits of an exclusive group change are
+ * the exception: they are all sent at once, across the chips, with the pins
+ * held throughout so the old LED never goes off apart from the new one 
+ * coming on. That may hold a column read back for longer than a batch.
+ */
+void flushLeds(void) {
+    uint8_t    chip;
+    uint8_t    batch;
+    Boolean    group;
+
+    if ( ! ledFlushPending() || ! spiSlotFree()) {
+        return;
+    }
+    group = FALSE;
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        if (groupDigits[chip] != 0) {
+            group = TRUE;
+        }
+    }
+    if (group) {
+        claimPinsForSpi();
+        for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+            flushChip(chip, groupDigits[chip], 8);
+        }
+        releasePinsFromSpi();
+    } else {
+        batch = LED_BATCH_DIGITS;
+        for (chip = 0; (chip < NUM_MAX_CHIPS) && (batch != 0); chip++) {
+            batch = flushChip(chip, 0xFF, batch);
+        }
+    }
+    if ( ! ledFlushPending()) {
+        LATENCY_END(LATENCY_RX_TO_LED);
+        opEnd(OP_EVENT_TO_LED);
+    }
+}
+
+/**
+ * @return TRUE if there are LED changes waiting for flushLeds()
+ */
+Boolean ledFlushPending(void) {
+    uint8_t chip;
+    
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        if (dirtyDigits[chip] != 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
 }
 
 
@@ -310,11 +668,79 @@ void displayNumber( uint16_t toDisplay, uint8_t offset, uint8_t digits, uint8_t
 // Display LS nibble of toDisplay as a hex digit on the 7 segment display digit given by offset
 void displayDigit( uint8_t toDisplay, uint8_t offset ) {
     toDisplay &= 0x0F;
-    decodeMode |= (1<<offset);
 
     // ?? Put in validation check for offset value
-    sendMxCmd( MX_DECODE, decodeMode);
-    sendMxCmd( MX_DIG_BOTH + offset, toDisplay);
+    setDecodeMask(decodeMode | (uint8_t)(1<<offset));
+    setDigit(offset, toDisplay);
+}
+
+/**
+ * Set which digits use the hex character decode. The MAX chip is only written 
+ * if the mask has changed.
+ * @param mask one bit per digit, 1 for decode
+ */
+void setDecodeMask(uint8_t mask) {
+    if (mask != decodeMode) {
+        decodeMode = mask;
+        sendMxCmd( MX_DECODE, decodeMode);
+    }
+}
+
+/**
+ * @return the digits currently using hex character decode
+ */
+uint8_t getDecodeMask(void) {
+    return decodeMode;
+}
+
+/**
+ * Write a raw value to both planes of a digit. For a decoded digit the low
+ * nibble is the character and bit 7 the decimal point.
+ * @param offset the digit 0-7
+ * @param value the register value
+ */
+void setDigit(uint8_t offset, uint8_t value) {
+    ledsMap[0][0][offset] = value;
+    ledsMap[0][1][offset] = value;
+    dirtyDigits[0] &= (uint8_t)~(1 << offset);
+    groupDigits[0] &= (uint8_t)~(1 << offset);
+    sendMxCmd( MX_DIG_BOTH + offset, value);
+    SNAPSHOT_CHANGED();
+}
+
+/**
+ * Turn an LED off in a copy of the LED maps.
+ * @param map the NUM_MAX_CHIPS LED maps
+ * @param ledNumber the LED, 1 based
+ */
+void clearLedInMap(LedsMap * map, uint8_t ledNumber) {
+    uint8_t    digNum;
+    
+    digNum = ledDigit[--ledNumber];
+    map[digNum / 8][0][digNum % 8] &= (uint8_t)~ledSegMask[ledNumber];
+    map[digNum / 8][1][digNum % 8] &= (uint8_t)~ledSegMask[ledNumber];
+}
+
+/**
+ * Put back a previously saved copy of the LED maps and send them to the MAX chips.
+ * @param map the NUM_MAX_CHIPS LED maps to show
+ */
+void restoreLedsMap(LedsMap * map) {
+    uint8_t chip;
+    uint8_t digNum;
+    
+    memcpy((void *) ledsMap, (void *) map, sizeof(ledsMap));
+    SNAPSHOT_CHANGED();
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        dirtyDigits[chip] = 0;
+        groupDigits[chip] = 0;
+        mxBegin(chip);
+        for (digNum = 0; digNum < 8; digNum++) {
+            mxWrite( MX_DIG_P0 + digNum, ledsMap[chip][0][digNum]);
+            mxWrite( MX_DIG_P1 + digNum, ledsMap[chip][1][digNum]);
+        }
+        mxEnd();
+    }
 }
 
 // Display byte as 2 hex digits on the 7 segment display starting at the digit given by offset
@@ -327,8 +753,7 @@ void displayByte( uint8_t toDisplay, uint8_t offset ) {
 void displayChar( unsigned char  toDisplay, uint8_t offset ) {
     unsigned char genChar;
 
-    decodeMode &= ~(1<<offset);
-    sendMxCmd( MX_DECODE, decodeMode);   // Turn off decode for alphanumerics
+    setDecodeMask(decodeMode & (uint8_t)~(1<<offset));   // Turn off decode for alphanumerics
 
     genChar = (toDisplay == ' ' ? 0 : charGen[toDisplay - 0x30]);
     sendMxCmd( MX_DIG_BOTH + offset, genChar);
@@ -401,27 +826,99 @@ void doSwDelay( uint16_t milliseconds ) {
     }
 }
 
+/**
+ * Write a register of the first MAX chip, which has the 7 segment displays.
+ * @param mxRegister the register
+ * @param mxValue the value
+ */
 void sendMxCmd( uint8_t mxRegister, uint8_t mxValue) {
-    Boolean    intState;
-
-    intState = INTCON0bits.GIEL;
-    INTCON0bits.GIEL = 0;             // Disable low priority interrupts whilst using SPI, as common I/O pins may be used by ISR
-
-    SPI1CON0bits.EN = 1;            // Enable SPI
-    MX_CS_IO = 0;                   // Enable MAX chip
-    SPI1TXB = mxRegister;            // Send register address
-    WaitForDataByte();              // Wait for transfer to complete
-    SPI1TXB = mxValue;               // Send data value
-    WaitForDataByte();
-    MX_CS_IO = 1;                   // Transfers sent data into register
-    MX_CS_IO = 0;                   // Next command
-    SPI1TXB = MX_NOP;                // Finish with a nop so subsequent transitions on CS cause no problem
-    WaitForDataByte();
-    SPI1TXB = 0;
-    WaitForDataByte();
-    MX_CS_IO = 1;                   // Latch NOP command into MAX chip
-
-    SPI1CON0bits.EN = 0;          // Disable SPI so pins can be used for other things
-
-    INTCON0bits.GIEL = intState;
+    mxBegin(0);
+    mxWrite(mxRegister, mxValue);
+    mxEnd();
+}
+
+/**
+ * Write the same value to a register of every MAX chip.
+ * @param mxRegister the register
+ * @param mxValue the value
+ */
+static void sendMxCmdAll( uint8_t mxRegister, uint8_t mxValue) {
+    uint8_t chip;
+    
+    for (chip = 0; chip < NUM_MAX_CHIPS; chip++) {
+        mxBegin(chip);
+        mxWrite(mxRegister, mxValue);
+        mxEnd();
+    }
+}
+
+/**
+ * Select a MAX chip.
+ * @param chip the chip
+ * @param level 0 to select, 1 to deselect
+ */
+static void mxChipSelect(uint8_t chip, uint8_t level) {
+#if NUM_MAX_CHIPS > 1
+    if (chip == 1) {
+        MX_CS1_IO = level;
+        return;
+    }
+#endif
+#if NUM_MAX_CHIPS > 2
+    if (chip == 2) {
+        MX_CS2_IO = level;
+        return;
+    }
+#endif
+    MX_CS_IO = level;
+}
+
+/**
+ * Start an SPI session with a MAX chip. Any number of mxWrite() may follow
+ * before mxEnd().
+ * @param chip the chip
+ */
+static void mxBegin( uint8_t chip ) {
+    claimPinsForSpi();              // Hold off the key scan whilst using SPI, as common I/O pins are used by the strobes
+    mxChip = chip;
+#if NUM_MAX_CHIPS > 1
+    if (chip != 0) {
+        RC6PPS = 0x00;              // Keep the first chip's select, driven by the SPI SS, inactive
+    }
+#endif
+    MX_SPI_START();                 // Enable SPI
+}
+
+/**
+ * Write a register of the chip given to mxBegin().
+ * @param mxRegister the register
+ * @param mxValue the value
+ */
+static void mxWrite( uint8_t mxRegister, uint8_t mxValue ) {
+    PROFILE_START(PROFILE_MX_CMD);
+    mxStats.commands++;
+    mxChipSelect(mxChip, 0);        // Enable MAX chip
+    MX_SPI_WRITE(mxRegister);       // Send register address and wait for transfer to complete
+    MX_SPI_WRITE(mxValue);          // Send data value
+    mxChipSelect(mxChip, 1);        // Transfers sent data into register
+    PROFILE_END(PROFILE_MX_CMD);
+}
+
+/**
+ * Finish an SPI session.
+ */
+static void mxEnd( void ) {
+    if (mxChip == 0) {
+        MX_CS_IO = 0;               // Next command
+        MX_SPI_WRITE(MX_NOP);       // Finish with a nop so subsequent transitions on CS, which is also a strobe, cause no problem
+        MX_SPI_WRITE(0);
+        MX_CS_IO = 1;               // Latch NOP command into MAX chip
+    }
+    MX_SPI_STOP();                  // Disable SPI so pins can be used for other things
+#if NUM_MAX_CHIPS > 1
+    if (mxChip != 0) {
+        RC6PPS = 0x33;              // SPI1_SS back to the first chip
+    }
+#endif
+    releasePinsFromSpi();
 }
\ No newline at end of file
@@ -71,10 +71,21 @@ extern "C" {
 
 #define MX_CS_TRIS              (TRISCbits.TRISC6)
 #define MX_CS_IO                (LATCbits.LATC6)
+// Chip selects for the additional MAX chips
+#define MX_CS1_TRIS             (TRISAbits.TRISA4)
+#define MX_CS1_IO               (LATAbits.LATA4)
+#define MX_CS2_TRIS             (TRISAbits.TRISA6)
+#define MX_CS2_IO               (LATAbits.LATA6)     // needs OSC1/OSC2 free for I/O
 #define SCK_TRIS                (TRISCbits.TRISC3)
 #define SDO_TRIS                (TRISCbits.TRISC5)
     
 #define WaitForDataByte()       {while (SPI1CON2bits.BUSY);}
+
+// All access to the SPI peripheral when talking to the MAX chip goes through 
+// these so that the traffic can be counted
+#define MX_SPI_START()          {SPI1CON0bits.EN = 1;}
+#define MX_SPI_WRITE(b)         {SPI1TXB = (b); WaitForDataByte(); mxStats.spiBytes++;}
+#define MX_SPI_STOP()           {SPI1CON0bits.EN = 0;}
    
 
 // MAX6951 definitions - see Maxim data sheet
@@ -102,7 +113,18 @@ extern "C" {
 
 
 
+/**
+ * Counts of the traffic sent to the MAX chip. These wrap.
+ */
+typedef struct {
+    uint16_t commands;      // register writes
+    uint16_t spiBytes;      // bytes sent including the trailing NOPs
+} MxStats;
+
+extern MxStats mxStats;
+
 void initLedDriver(uint8_t brightness);
+void setLedIntensity(uint8_t brightness);
 void setLedTestMode(Boolean testMode);
 void runLedTest( uint8_t testPasses );
 Word ledTestCycle( Word testStatus );
@@ -112,8 +134,19 @@ void setOn( uint8_t ledNumber);
 void setOff( uint8_t ledNumber);
 void flashLed( uint8_t ledNumber );
 void antiFlashLed( uint8_t ledNumber );
+void loadLedMap( void );
+void resetLedMap( void );
+void setLedMapEntry( uint8_t ledNumber, uint8_t physical );
+uint8_t getLedMapEntry( uint8_t ledNumber );
+Processed ledMapNvMessage( Message * m );
+void setLedGroup( uint8_t group, uint8_t first, uint8_t last );
+void flushLeds( void );
+Boolean ledFlushPending( void );
 void displayNumber( uint16_t toDisplay, uint8_t offset, uint8_t digits, uint8_t format );
 void displayDigit( uint8_t toDisplay, uint8_t offset );
+void setDecodeMask( uint8_t mask );
+uint8_t getDecodeMask( void );
+void setDigit( uint8_t offset, uint8_t value );
 void displayByte( uint8_t toDisplay, uint8_t offset );
 void displayChar( unsigned char  toDisplay, uint8_t offset );
 void displayString( char *toDisplay, uint8_t offset);
@@ -130,12 +163,27 @@ void doSwDelay( uint16_t milliseconds );
 typedef uint8_t     DigitMap[8];    // One bit per segment/LED (on or off)
 typedef DigitMap    LedsMap[2];     // Two planes - for flashing status
 
+#define LEDS_PER_CHIP   64
+
+// EEPROM remap table, for each LED the LED number it is wired as
+#define LED_MAP_ADDRESS     0x300
+#define LED_MAP_NVM_TYPE    EEPROM_NVM_TYPE
+
+#if (NUM_MAX_CHIPS < 1) || (NUM_MAX_CHIPS > 3)
+#error "NUM_MAX_CHIPS must be 1 to 3"
+#endif
+
 typedef struct
 {
     uint8_t    dig;
     uint8_t    seg;
 } Segment;
 
+extern LedsMap ledsMap[NUM_MAX_CHIPS];     // one per chip
+
+void restoreLedsMap( LedsMap * map );
+void clearLedInMap( LedsMap * map, uint8_t ledNumber );
+
 #ifdef	__cplusplus
 }
 #endif
@@ -39,20 +39,27 @@
 
 #include "statusLeds.h"
 #include "panelNv.h"
+#include "matrix.h"
 //
 // VLCB Service options first
 //
-// The data version stored at NV#0
-#define APP_NVM_VERSION 1
+// The data version stored at NV#0, changed when NVs are added so they are set to their defaults
+#define APP_NVM_VERSION 3
 #define NUM_SERVICES 9
+// The number of entries in the loop() task table
+#define NUM_TASKS   7
 
 // The hardware
 #define CANPANEL
 /*******************************************************************
  * IO pin configuration
  */
-#define NUM_PB      64
-#define NUM_LED     64
+#define NUM_PB      (COLUMN_OUTPUTS*ROW_INPUTS)   // set by the matrix dimensions
+#ifndef NUM_MAX_CHIPS
+#define NUM_MAX_CHIPS   1   // MAX6951 chips, 1 to 3, each drives 64 LEDs
+#endif
+#define NUM_LED     (64*NUM_MAX_CHIPS)
+#define NUM_LED_GROUPS  8   // exclusive LED groups, see NV_LED_GROUP_FIRST
 
 
 #if defined(_18FXXQ83_FAMILY_)
@@ -65,10 +72,16 @@
 //
 // NV service
 //
-#define NV_NUM  (NV_PB_FLAGS + NUM_PB)
+#define NV_NUM  NV_DIAG_CLEAR
+#if NV_NUM > 255
+#error "Too many PBs for the NVs and happenings, reduce the matrix size"
+#endif
 #if defined(_18F66K80_FAMILY_)
 #define NV_ADDRESS  0xFF80
 #define NV_NVM_TYPE FLASH_NVM_TYPE
+#if NV_NUM >= 0x80
+#error "NVs don't fit in the flash block, reduce the matrix size"
+#endif
 #endif
 #if defined(_18FXXQ83_FAMILY_)
 #define NV_ADDRESS  0x200
@@ -91,6 +104,15 @@
 #if defined(_18FXXQ83_FAMILY_)
 #define CAN_NUM_RXBUFFERS   8
 #endif
+// Depth of the transmit buffering, used to pace bulk responses
+#if defined(_18F66K80_FAMILY_)
+#define TX_FIFO_DEPTH       CAN_NUM_TXBUFFERS
+#endif
+#if defined(_18FXXQ83_FAMILY_)
+#define TX_FIFO_DEPTH       32      // hardware TX FIFO set up by the CAN driver
+#endif
+// Approximate number of standard frames the bus can carry at 125kbit/s
+#define CAN_FRAMES_PER_SECOND   960
 //
 // BOOT service
 //
@@ -196,4 +218,19 @@
 // Whether to support AREQ and ASRQ commands
 #define AREQ_SUPPORT
 
+// Whether to read the buttons from a timer interrupt, one column per interrupt
+//#define KEYSCAN_ISR
+
+// Whether to keep a snapshot of the LED state in EEPROM, uses EEPROM 0x000-0x1FF
+//#define LED_SNAPSHOT
+
+// Whether to measure the time spent in the main activities, uses Timer 1
+//#define PROFILE
+
+// Whether to keep histograms of the event to LED and button to event latencies
+//#define LATENCY
+
+// Whether to keep a timeline of events and LED changes which can be read over the bus
+//#define TRACE_BUFFER
+
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Work done by the panel's main operations.
+ *
+ * At opStart() the running counters are noted and at opEnd() the difference
+ * is kept as the cost of the operation, along with the highest cost seen.
+ * This gives the number of SPI commands, EV reads and flash writes behind 
+ * a route change or a SOD, so the effect of a firmware change can be 
+ * compared on a real panel. The values can be read and reset using RDGN, 
+ * see panelDiag.c.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include <string.h>
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "max6951.h"
+#include "flashSchedule.h"
+#include "opCost.h"
+
+uint16_t evReads;
+OpCost lastOpCost[NUM_OPS];
+OpCost maxOpCost[NUM_OPS];
+
+static OpCost startCount[NUM_OPS];
+static TickValue startTime[NUM_OPS];
+static uint8_t running;     // one bit per operation
+
+/**
+ * Clear the last and highest costs.
+ */
+void resetOpCost(void) {
+    memset((void *)lastOpCost, 0, sizeof(lastOpCost));
+    memset((void *)maxOpCost, 0, sizeof(maxOpCost));
+}
+
+/**
+ * Note the start of an operation, if it isn't already running.
+ * @param op the OP_ operation
+ */
+void opStart(uint8_t op) {
+    if (running & (1 << op)) {
+        return;
+    }
+    running |= (uint8_t)(1 << op);
+    startCount[op].mxCommands = mxStats.commands;
+    startCount[op].evReads = evReads;
+    startCount[op].flashWrites = flashStats.writes;
+    startTime[op].val = tickGet();
+}
+
+/**
+ * Record the cost of an operation which has finished.
+ * @param op the OP_ operation
+ */
+void opEnd(uint8_t op) {
+    OpCost * last;
+    OpCost * max;
+    uint32_t elapsed;
+    
+    if ( ! (running & (1 << op))) {
+        return;
+    }
+    running &= (uint8_t)~(1 << op);
+    last = &lastOpCost[op];
+    max = &maxOpCost[op];
+    last->mxCommands = mxStats.commands - startCount[op].mxCommands;
+    last->evReads = evReads - startCount[op].evReads;
+    last->flashWrites = flashStats.writes - startCount[op].flashWrites;
+    elapsed = tickTimeSince(startTime[op]) / ONE_MILI_SECOND;
+    last->time = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+    
+    if (last->mxCommands > max->mxCommands) max->mxCommands = last->mxCommands;
+    if (last->evReads > max->evReads) max->evReads = last->evReads;
+    if (last->flashWrites > max->flashWrites) max->flashWrites = last->flashWrites;
+    if (last->time > max->time) max->time = last->time;
+}
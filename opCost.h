@@ -0,0 +1,69 @@
+#ifndef _OPCOST_H_
+#define _OPCOST_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Measurement of the work done by the panel's main operations.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+
+// The operations measured
+#define OP_EVENT_TO_LED     0   // a consumed event until its LED changes are sent
+#define OP_SOD              1   // a start of day
+#define OP_STATE_REQUESTS   2   // the start up state requests
+#define NUM_OPS             3
+
+/**
+ * The work done by an operation.
+ */
+typedef struct {
+    uint16_t mxCommands;    // MAX chip register writes
+    uint16_t evReads;       // getEVs() calls
+    uint16_t flashWrites;   // flash writes allowed
+    uint16_t time;          // elapsed ms
+} OpCost;
+
+#define NUM_OP_COST_VALUES  4       // the words in OpCost, used by #if
+
+extern uint16_t evReads;
+extern OpCost lastOpCost[NUM_OPS];
+extern OpCost maxOpCost[NUM_OPS];
+
+void resetOpCost(void);
+void opStart(uint8_t op);
+void opEnd(uint8_t op);
+
+#endif
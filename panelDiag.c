@@ -0,0 +1,367 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * CANPANEL specific diagnostics.
+ *
+ * The library answers RQSD and RDGN for its own services, which it only
+ * lists up to NUM_SERVICES. These diagnostics are one more service at
+ * PANEL_DIAG_SERVICE_INDEX and only RQSD and RDGN for that index are answered
+ * here, so the service is not in the list for RQSD of all services and is
+ * asked for by its index. RDGN is answered with a single DGN, or with a DGN
+ * for every code of every section in turn for code 0 as in VLCB.
+ *
+ * Reading a diagnostic does not clear it. The counters are cleared by
+ * writing NV_DIAG_CLEAR, see panelDiagClear().
+ *
+ * The codes are sparse, each section starts at its PANEL_DIAG_ code and the
+ * build fails if one section runs into the next:
+ * <PRE>
+ * 0x01-0x1F  profile         0x70  trace freeze
+ * 0x20-0x3F  latency         0x71  trace restart
+ * 0x40-0x4F  bus             0x72-0x7F  bus queue
+ * 0x50-0x6F  operations      0x80-0xFF  trace data
+ * </PRE>
+ *
+ * The profile table is reported as 4 codes per region: the count, the
+ * longest time, then the high and low words of the total time. Times are
+ * in 0.5us units.
+ *
+ * The latency histograms follow at PANEL_DIAG_LATENCY, one code per bucket.
+ *
+ * The bus monitor is at PANEL_DIAG_BUS: the frames in the last second for
+ * each of the traffic BUS_CLASS_ and the utilisation percentage, then the 
+ * high water marks of the same values. PANEL_DIAG_BUS_QUEUE is laid out the
+ * same way with the dropped frame and lost arbitration counts and the 
+ * queueing delay in ms.
+ *
+ * The operation counters are at PANEL_DIAG_OPS: MAX chip register writes, 
+ * SPI bytes, getEVs() calls and flash writes. They wrap and are not cleared 
+ * by panelDiagClear(). They are followed by the OpCost of each operation, first the
+ * last cost then the highest.
+ *
+ * Reading PANEL_DIAG_TRACE freezes the trace buffer and gives the number of
+ * entries, which are then read from PANEL_DIAG_TRACE_DATA oldest first.
+ * PANEL_DIAG_TRACE_RESTART, or panelDiagClear(), starts a new trace.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include "vlcb.h"
+#include "module.h"
+#include "buttonscan.h"
+#include "mns.h"
+#include "timedResponse.h"
+#include "panelDiag.h"
+#include "profile.h"
+#include "latency.h"
+#include "busMonitor.h"
+#include "max6951.h"
+#include "flashSchedule.h"
+#include "opCost.h"
+#include "trace.h"
+
+#ifdef PROFILE
+#define NUM_PROFILE_CODES   (4*NUM_PROFILE_REGIONS)
+#else
+#define NUM_PROFILE_CODES   0
+#endif
+
+#ifdef LATENCY
+#define NUM_LATENCY_CODES   (NUM_LATENCY_BUCKETS*NUM_LATENCY_HISTOGRAMS)
+#else
+#define NUM_LATENCY_CODES   0
+#endif
+
+#define NUM_BUS_CODES       (2*(NUM_BUS_TRAFFIC_CLASSES+1))
+#define NUM_BUS_ERROR_CLASSES   (NUM_BUS_CLASSES - NUM_BUS_TRAFFIC_CLASSES)
+#define NUM_BUS_QUEUE_CODES     (2*(NUM_BUS_ERROR_CLASSES+1))
+
+#ifdef TRACE_BUFFER
+#define NUM_TRACE_CODES     (2 + TRACE_SIZE*TRACE_ENTRY_WORDS)
+#else
+#define NUM_TRACE_CODES     0
+#endif
+
+#define NUM_OP_COUNTERS     4
+#define NUM_OPS_CODES       (NUM_OP_COUNTERS + 2*NUM_OPS*NUM_OP_COST_VALUES)
+
+#if PANEL_DIAG_PROFILE + NUM_PROFILE_CODES > PANEL_DIAG_LATENCY
+#error "Profile diagnostic codes run into the latency codes"
+#endif
+#if PANEL_DIAG_LATENCY + NUM_LATENCY_CODES > PANEL_DIAG_BUS
+#error "Latency diagnostic codes run into the bus codes"
+#endif
+#if PANEL_DIAG_BUS + NUM_BUS_CODES > PANEL_DIAG_OPS
+#error "Bus diagnostic codes run into the operation codes"
+#endif
+#if PANEL_DIAG_OPS + NUM_OPS_CODES > PANEL_DIAG_TRACE
+#error "Operation diagnostic codes run into the trace codes"
+#endif
+#if PANEL_DIAG_BUS_QUEUE + NUM_BUS_QUEUE_CODES > PANEL_DIAG_TRACE_DATA
+#error "Bus queue diagnostic codes run into the trace data codes"
+#endif
+#if PANEL_DIAG_TRACE_DATA + NUM_TRACE_CODES - 2 > 0x100
+#error "Trace data diagnostic codes don't fit in a byte"
+#endif
+
+/*
+ * The sections reported for code 0. The trace freeze and restart codes are
+ * left out as reading them changes the trace.
+ */
+typedef struct {
+    uint8_t first;
+    uint8_t count;
+} DiagSection;
+
+static const DiagSection diagSections[] = {
+#ifdef PROFILE
+    {PANEL_DIAG_PROFILE, NUM_PROFILE_CODES},
+#endif
+#ifdef LATENCY
+    {PANEL_DIAG_LATENCY, NUM_LATENCY_CODES},
+#endif
+    {PANEL_DIAG_BUS, NUM_BUS_CODES},
+    {PANEL_DIAG_OPS, NUM_OPS_CODES},
+    {PANEL_DIAG_BUS_QUEUE, NUM_BUS_QUEUE_CODES},
+#ifdef TRACE_BUFFER
+    {PANEL_DIAG_TRACE_DATA, NUM_TRACE_CODES - 2},
+#endif
+};
+
+#define NUM_DIAG_SECTIONS   (sizeof(diagSections)/sizeof(DiagSection))
+
+static uint8_t allDiagSection;      // progress through the code 0 response
+static uint8_t allDiagCode;
+
+static TimedResponseResult allDiagCallback(uint8_t type, uint8_t serviceIndex, uint8_t step);
+
+// The timed responses are run under the MNS service index. startTimedResponse()
+// takes 1 based indexes and repeats the response for every service if given 0.
+#define TR_SERVICE_INDEX    (findServiceIndex(SERVICE_ID_MNS) + 1)
+
+#ifdef PROFILE
+/**
+ * Get a value from the profile table.
+ * @param index the code relative to PANEL_DIAG_PROFILE
+ * @return the value
+ */
+static uint16_t profileDiagnostic(uint8_t index) {
+    ProfileEntry e;
+    Boolean intState;
+    
+    // take a copy as the ISR may be updating it
+    holdKeyScan(intState);
+    e = profileTable[index/4];
+    resumeKeyScan(intState);
+    
+    switch (index % 4) {
+        case 0:
+            return e.count;
+        case 1:
+            return e.max;
+        case 2:
+            return (uint16_t)(e.total >> 16);
+        default:
+            return (uint16_t)e.total;
+    }
+}
+#endif
+
+/**
+ * Get a value from the bus monitor.
+ * @param index the code relative to PANEL_DIAG_BUS
+ * @return the value
+ */
+static uint16_t busDiagnostic(uint8_t index) {
+    if (index < NUM_BUS_TRAFFIC_CLASSES) {
+        return busFrames(index);
+    }
+    if (index == NUM_BUS_TRAFFIC_CLASSES) {
+        return busUtilisation();
+    }
+    index -= NUM_BUS_TRAFFIC_CLASSES+1;
+    if (index < NUM_BUS_TRAFFIC_CLASSES) {
+        return busHighWater[index];
+    }
+    return busUtilisationHighWater;
+}
+
+/**
+ * Get a value from the bus monitor's queueing and error counts.
+ * @param index the code relative to PANEL_DIAG_BUS_QUEUE
+ * @return the value
+ */
+static uint16_t busQueueDiagnostic(uint8_t index) {
+    if (index < NUM_BUS_ERROR_CLASSES) {
+        return busFrames(NUM_BUS_TRAFFIC_CLASSES + index);
+    }
+    if (index == NUM_BUS_ERROR_CLASSES) {
+        return busQueueDelay();
+    }
+    index -= NUM_BUS_ERROR_CLASSES+1;
+    if (index < NUM_BUS_ERROR_CLASSES) {
+        return busHighWater[NUM_BUS_TRAFFIC_CLASSES + index];
+    }
+    return busQueueDelayHighWater;
+}
+
+/**
+ * Get an operation counter.
+ * @param index the code relative to PANEL_DIAG_OPS
+ * @return the value
+ */
+static uint16_t opsDiagnostic(uint8_t index) {
+    switch (index) {
+        case 0:
+            return mxStats.commands;
+        case 1:
+            return mxStats.spiBytes;
+        case 2:
+            return evReads;
+        case 3:
+            return flashStats.writes;
+    }
+    index -= NUM_OP_COUNTERS;
+    if (index < NUM_OPS*NUM_OP_COST_VALUES) {
+        return ((uint16_t *)lastOpCost)[index];
+    }
+    return ((uint16_t *)maxOpCost)[index - NUM_OPS*NUM_OP_COST_VALUES];
+}
+
+/**
+ * Read a diagnostic.
+ * @param code the diagnostic code
+ * @param value set to the value
+ * @return TRUE if the code is valid
+ */
+static Boolean panelDiagnostic(uint8_t code, uint16_t * value) {
+    if ((code >= PANEL_DIAG_BUS) && (code < PANEL_DIAG_BUS + NUM_BUS_CODES)) {
+        *value = busDiagnostic(code - PANEL_DIAG_BUS);
+#ifdef PROFILE
+    } else if ((code >= PANEL_DIAG_PROFILE) && (code < PANEL_DIAG_PROFILE + NUM_PROFILE_CODES)) {
+        *value = profileDiagnostic(code - PANEL_DIAG_PROFILE);
+#endif
+#ifdef LATENCY
+    } else if ((code >= PANEL_DIAG_LATENCY) && (code < PANEL_DIAG_LATENCY + NUM_LATENCY_CODES)) {
+        *value = ((uint16_t *)latencyHistogram)[code - PANEL_DIAG_LATENCY];
+#endif
+    } else if ((code >= PANEL_DIAG_BUS_QUEUE) && (code < PANEL_DIAG_BUS_QUEUE + NUM_BUS_QUEUE_CODES)) {
+        *value = busQueueDiagnostic(code - PANEL_DIAG_BUS_QUEUE);
+    } else if ((code >= PANEL_DIAG_OPS) && (code < PANEL_DIAG_OPS + NUM_OPS_CODES)) {
+        *value = opsDiagnostic(code - PANEL_DIAG_OPS);
+#ifdef TRACE_BUFFER
+    } else if (code == PANEL_DIAG_TRACE) {
+        *value = traceFreeze();
+    } else if (code == PANEL_DIAG_TRACE_RESTART) {
+        traceReset();
+        *value = 0;
+    } else if ((code >= PANEL_DIAG_TRACE_DATA) && (code < PANEL_DIAG_TRACE_DATA + TRACE_SIZE*TRACE_ENTRY_WORDS)) {
+        *value = traceWord(code - PANEL_DIAG_TRACE_DATA);
+#endif
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Clear the counters and start a new trace, when NV_DIAG_CLEAR is written.
+ * The operation counters are left to wrap.
+ */
+void panelDiagClear(void) {
+#ifdef PROFILE
+    resetProfile();
+#endif
+#ifdef LATENCY
+    resetLatency();
+#endif
+    busMonitorReset();
+    resetOpCost();
+#ifdef TRACE_BUFFER
+    traceReset();
+#endif
+}
+
+/**
+ * Handle a RQSD or RDGN for the CANPANEL service index.
+ * @param m the received message
+ * @return PROCESSED if the message was a request for CANPANEL diagnostics
+ */
+Processed panelDiagMessage(Message * m) {
+    uint8_t code;
+    uint16_t value;
+    
+    if ((m->len < 4) || (m->bytes[0] != nn.bytes.hi) || (m->bytes[1] != nn.bytes.lo)) {
+        return NOT_PROCESSED;
+    }
+    if ((m->opc == OPC_RQSD) && (m->bytes[2] == PANEL_DIAG_SERVICE_INDEX)) {
+        sendMessage7(OPC_ESD, nn.bytes.hi, nn.bytes.lo, PANEL_DIAG_SERVICE_INDEX, PANEL_DIAG_SERVICE_ID, 0, 0, 0);
+        return PROCESSED;
+    }
+    if ((m->opc != OPC_RDGN) || (m->len < 5) || (m->bytes[2] != PANEL_DIAG_SERVICE_INDEX)) {
+        return NOT_PROCESSED;
+    }
+    code = m->bytes[3];
+    if (code == 0) {
+        allDiagSection = 0;
+        allDiagCode = 0;
+        startTimedResponse(TIMED_RESPONSE_RDGN, TR_SERVICE_INDEX, allDiagCallback);
+        return PROCESSED;
+    }
+    if ( ! panelDiagnostic(code, &value)) {
+        sendMessage5(OPC_GRSP, nn.bytes.hi, nn.bytes.lo, OPC_RDGN, PANEL_DIAG_SERVICE_INDEX, GRSP_INVALID_DIAGNOSTIC);
+        return PROCESSED;
+    }
+    sendMessage6(OPC_DGN, nn.bytes.hi, nn.bytes.lo, PANEL_DIAG_SERVICE_INDEX, code, value >> 8, value & 0xFF);
+    return PROCESSED;
+}
+
+/**
+ * Send the next diagnostic of the response to code 0.
+ */
+static TimedResponseResult allDiagCallback(uint8_t type, uint8_t serviceIndex, uint8_t step) {
+    uint8_t code;
+    uint16_t value;
+    
+    if (allDiagSection >= NUM_DIAG_SECTIONS) {
+        return TIMED_RESPONSE_RESULT_FINISHED;
+    }
+    code = diagSections[allDiagSection].first + allDiagCode;
+    panelDiagnostic(code, &value);
+    sendMessage6(OPC_DGN, nn.bytes.hi, nn.bytes.lo, PANEL_DIAG_SERVICE_INDEX, code, value >> 8, value & 0xFF);
+    if (++allDiagCode >= diagSections[allDiagSection].count) {
+        allDiagCode = 0;
+        allDiagSection++;
+    }
+    return TIMED_RESPONSE_RESULT_NEXT;
+}
@@ -0,0 +1,63 @@
+#ifndef _PANELDIAG_H_
+#define _PANELDIAG_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * CANPANEL specific diagnostics, read using RDGN with a service index one
+ * above the library's services.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+
+// The service index used for the CANPANEL diagnostics
+#define PANEL_DIAG_SERVICE_INDEX    (NUM_SERVICES+1)
+// VLCB has no module specific service type so one outside the defined types is reported
+#define PANEL_DIAG_SERVICE_ID       0xFE
+
+// Diagnostic codes, 0 gives all of them
+#define PANEL_DIAG_PROFILE          0x01    // 4 codes per profile region
+#define PANEL_DIAG_LATENCY          0x20    // NUM_LATENCY_BUCKETS codes per histogram
+#define PANEL_DIAG_BUS              0x40    // bus monitor, see panelDiag.c
+#define PANEL_DIAG_OPS              0x50    // operation counters, see panelDiag.c
+#define PANEL_DIAG_TRACE            0x70    // freeze the trace, gives the number of entries
+#define PANEL_DIAG_TRACE_RESTART    0x71    // empty the trace and record again
+#define PANEL_DIAG_BUS_QUEUE        0x72    // bus monitor queueing and errors, see panelDiag.c
+#define PANEL_DIAG_TRACE_DATA       0x80    // TRACE_ENTRY_WORDS codes per trace entry
+
+void panelDiagClear(void);
+Processed panelDiagMessage(Message * m);
+
+#endif
@@ -53,13 +53,101 @@
 #include "panelEvents.h"
 #include "max6951.h"
 #include "nv.h"
+#include "ticktime.h"
+#include "flashSchedule.h"
+#include "profile.h"
+#include "latency.h"
+#include "busMonitor.h"
+#include "buttonscan.h"
+#include "opCost.h"
+#include "trace.h"
+#include "ledTimer.h"
 
 
 // forward declarations
 void doSOD(void);
 TimedResponseResult sodTRCallback(uint8_t type, uint8_t serviceIndex, uint8_t step);
+static void doActions(uint8_t tableIndex, EventState state, Boolean allowSpecials);
+static uint8_t actionLed(uint8_t ledNo, uint8_t flags);
+
+/*
+ * The PBs which take part in SOD together with a copy of their flags so the 
+ * SOD doesn't have to step through every PB nor read the NVs again.
+ */
+static uint8_t sodPb[NUM_PB];
+static uint8_t sodFlags[NUM_PB];
+static uint8_t sodCount;
+static uint8_t sodNext;     // next entry in the list to be sent
+
+/*
+ * State requests. The events whose state has been requested, or heard, since
+ * the requests started are marked in stateKnown so each is only asked once.
+ * This is kept per event rather than per producer as an AREQ asks a producer
+ * for a single event, so a producer of several of our events must be asked 
+ * for each of them, and the table holds each producer and event only once.
+ */
+static uint8_t stateKnown[(NUM_EVENTS+7)/8];
+static uint8_t stateRequestIndex = NO_INDEX;    // next table entry to look at, NO_INDEX when idle
+static uint32_t stateRequestInterval;
+static TickValue lastStateRequestTime;
+
+static Boolean bulkHeld;
+static TickValue bulkHeldSince;
 
 void panelEventsInit(void) {
+    buildSodList();
+}
+
+/**
+ * Build the compact list of the PBs which have NV_PB_FLAGS_ENABLE_SOD set.
+ * Needs to be called again whenever a PB flags NV is changed.
+ */
+void buildSodList(void) {
+    uint8_t pb;
+    uint8_t flags;
+    
+    sodCount = 0;
+    for (pb=0; pb<NUM_PB; pb++) {
+        flags = (uint8_t)getNV(NV_PB_FLAGS + pb);
+        if (flags & NV_PB_FLAGS_ENABLE_SOD) {
+            sodPb[sodCount] = pb;
+            sodFlags[sodCount] = flags;
+            sodCount++;
+        }
+    }
+    sodNext = sodCount;     // any SOD in progress is abandoned
+}
+
+/**
+ * Work out how many bulk frames, the SOD responses and state requests, may be
+ * queued now. The events from the buttons go ahead of them: bulk frames are
+ * held back whilst a button being debounced is about to send an event and may
+ * only fill BULK_TX_LIMIT of the TX buffers. So that bulk still finishes, 
+ * after being held for BULK_MAX_HOLD one frame is let through if that stays
+ * within BULK_TX_LIMIT.
+ * @return the number of bulk frames which may be sent
+ */
+static uint8_t bulkTxAllowance(void) {
+    uint8_t free;
+    uint8_t queued;
+    
+    free = txBuffersFree();
+    queued = TX_FIFO_DEPTH - free;
+    if ( ! keyEventPending() && (queued < BULK_TX_LIMIT) && (free > SOD_TX_HEADROOM)) {
+        bulkHeld = FALSE;
+        queued = BULK_TX_LIMIT - queued;
+        return (queued > SOD_MAX_BURST) ? SOD_MAX_BURST : queued;
+    }
+    if ( ! bulkHeld) {
+        bulkHeld = TRUE;
+        bulkHeldSince.val = tickGet();
+        return 0;
+    }
+    if ((queued < BULK_TX_LIMIT) && (tickTimeSince(bulkHeldSince) > (uint32_t)BULK_MAX_HOLD * ONE_MILI_SECOND)) {
+        bulkHeldSince.val = tickGet();
+        return 1;
+    }
+    return 0;
 }
 
 /**
@@ -110,13 +198,10 @@ uint8_t APP_addEvent(uint16_t nodeNumber, uint16_t eventNumber, uint8_t evNum, u
 
 
 Processed APP_processConsumedEvent(uint8_t tableIndex, Message * m) {
-    uint8_t ledNo;
-    uint8_t flags;
-    uint8_t e;
-    uint8_t pol;
-    
     if (m->len < 5) return NOT_PROCESSED;
 
+    LATENCY_START(LATENCY_RX_TO_LED);
+
     switch (m->opc) {
         case OPC_ACON:
 #ifdef HANDLE_DATA_EVENTS
@@ -144,20 +229,65 @@ Processed APP_processConsumedEvent(uint8_t tableIndex, Message * m) {
 #endif
             break;
         default:
+            if ( ! ledFlushPending()) {
+                LATENCY_CANCEL(LATENCY_RX_TO_LED);
+            }
             return NOT_PROCESSED;
     }
+    PROFILE_START(PROFILE_CONSUMED_EVENT);
+    doActions(tableIndex, ( ! ((m->opc)&EVENT_ON_MASK)) ? EVENT_ON : EVENT_OFF, TRUE);
+    PROFILE_END(PROFILE_CONSUMED_EVENT);
+    return PROCESSED;
+}
+
+/**
+ * Get the LED an action is for.
+ * @param ledNo the LED number byte of the action
+ * @param flags the flags byte of the action
+ * @return the LED number 1..NUM_LED, or 0 if the action isn't for an LED
+ */
+static uint8_t actionLed(uint8_t ledNo, uint8_t flags) {
+    if ((ledNo == NO_ACTION) || (ledNo > LEDS_PER_BANK)) {
+        return 0;
+    }
+    if (flags & ACTION_FLAGS_LED_BANK) {
+        if (ledNo > NUM_LED - LEDS_PER_BANK) {
+            return 0;
+        }
+        ledNo += LEDS_PER_BANK;
+    }
+    return ledNo;
+}
+
+/**
+ * Perform the LED actions for an event.
+ * Used for the consumed events and for the responses to our state requests.
+ * 
+ * @param tableIndex the event table index of the event
+ * @param state whether the event is ON or OFF
+ * @param allowSpecials whether the special actions (SOD) may be done
+ */
+static void doActions(uint8_t tableIndex, EventState state, Boolean allowSpecials) {
+    uint8_t ledNo;
+    uint8_t flags;
+    uint8_t e;
+    uint8_t pol;
 
+    opStart(OP_EVENT_TO_LED);
+    evReads++;
     e = getEVs(tableIndex);
 #ifdef SAFETY
     if (e != 0) {
-        return PROCESSED; // error getting EVs. Can't report the error so just return
+        return; // error getting EVs. Can't report the error so just return
     }
 #endif
+    stateKnown[tableIndex>>3] |= (uint8_t)(1 << (tableIndex & 7));
+    flashNoteConsumedEvent();
+    TRACE(TRACE_EVENT, tableIndex, state, allowSpecials);
     
     // ON events work up through the EVs
     // EV#0 is for produced event so start at 1
-    // TODO would be more efficient to get all the EVs in one go and then work through them. getEV() isn't quick)
-    for (e=1; e<EVperEVT ;e+=2) { 
+    for (e=1; e<EVperEVT-1 ;e+=2) { 
         ledNo = evs[e];
         flags = evs[e+1];
 
@@ -167,33 +297,29 @@ Processed APP_processConsumedEvent(uint8_t tableIndex, Message * m) {
         // Check for SOD
         if ((ledNo == ACTION_SPECIALS) && (flags == ACTION_SPECIAL_SOD)) {
             // Do the SOD
-            doSOD();
+            if (allowSpecials) {
+                doSOD();
+            }
             continue;
         }
         // check for a valid action
-        if (ledNo > NUM_ACTIONS) {
+        ledNo = actionLed(ledNo, flags);
+        if (ledNo == 0) {
             continue;
         }
-        // check the OPC if this is an ON or OFF event
-        if ( ! ((m->opc)&EVENT_ON_MASK)) {
-            // ON event
-            if (flags & ACTION_FLAGS_ENABLEON) {
-                if (flags & ACTION_FLAGS_INVERT_EVENT) {
-                    pol = 0;
-                } else {
-                    pol = 1;
-                }
+        // check whether this action uses ON or OFF events
+        if (state == EVENT_ON) {
+            if ( ! (flags & ACTION_FLAGS_ENABLEON)) {
+                continue;
             }
+            pol = (flags & ACTION_FLAGS_INVERT_EVENT) ? 0 : 1;
         } else {
-            // OFF event
-            if (flags & ACTION_FLAGS_ENABLEOFF) {
-                if (flags & ACTION_FLAGS_INVERT_EVENT) {
-                    pol = 1;
-                } else {
-                    pol = 0;
-                }
+            if ( ! (flags & ACTION_FLAGS_ENABLEOFF)) {
+                continue;
             }
+            pol = (flags & ACTION_FLAGS_INVERT_EVENT) ? 1 : 0;
         }
+        ledTimerCancel(ledNo);      // this action replaces any timed change
         if ((flags & ACTION_FLAGS_FLASH) && (pol == 1)) {
             if (flags & ACTION_FLAGS_INVERT_FLASH) {
                 antiFlashLed(ledNo);
@@ -205,7 +331,184 @@ Processed APP_processConsumedEvent(uint8_t tableIndex, Message * m) {
         } else {
             setOff(ledNo);
         }
+        if ((flags & ACTION_FLAGS_TIMER) && (pol == 1)) {
+            ledTimerStart(ledNo, (uint8_t)getNV(NV_LED_DURATION((flags & ACTION_FLAGS_TIMER) >> ACTION_FLAGS_TIMER_SHIFT)));
+        }
+    }
+    if ( ! ledFlushPending()) {
+        LATENCY_CANCEL(LATENCY_RX_TO_LED);  // nothing to send to the MAX chip
+        opEnd(OP_EVENT_TO_LED);
+    }
+}
+
+/**
+ * Start requesting the state of the consumed events from their producers so
+ * the LEDs can be set up without waiting for something to change.
+ * Does nothing unless enabled by NV_PANEL_FLAGS_STATE_REQUEST.
+ */
+void startStateRequests(void) {
+    uint16_t interval;
+    uint8_t share;
+    uint8_t i;
+    
+    if ( ! (getNV(NV_PANEL_FLAGS) & NV_PANEL_FLAGS_STATE_REQUEST)) {
+        return;
+    }
+    // each request costs a request and a response on the bus
+    interval = (uint16_t)getNV(NV_STATE_REQUEST_INTERVAL);
+    share = (uint8_t)getNV(NV_STATE_REQUEST_SHARE);
+    if ((share > 0) && (interval < (2 * 100 * 1000UL)/((uint32_t)share * CAN_FRAMES_PER_SECOND))) {
+        interval = (uint16_t)((2 * 100 * 1000UL)/((uint32_t)share * CAN_FRAMES_PER_SECOND));
+    }
+    stateRequestInterval = interval * ONE_MILI_SECOND;
+    for (i=0; i<sizeof(stateKnown); i++) {
+        stateKnown[i] = 0;
+    }
+    stateRequestIndex = 0;
+    lastStateRequestTime.val = tickGet();
+    opStart(OP_STATE_REQUESTS);
+}
+
+/**
+ * Check whether a table entry has any LED actions.
+ * @param tableIndex the event table index
+ * @return TRUE if the state of this event is of interest
+ */
+static Boolean hasLedAction(uint8_t tableIndex) {
+    uint8_t e;
+    
+    evReads++;
+    if (getEVs(tableIndex) != 0) {
+        return FALSE;
+    }
+    for (e=1; e<EVperEVT-1 ;e+=2) { 
+        if (actionLed(evs[e], evs[e+1]) != 0) {
+            return TRUE;
+        }
     }
+    return FALSE;
+}
+
+/**
+ * Send the next state request, if it is time to. 
+ * The event table is walked looking for events which have LED actions and 
+ * whose state is not yet known. Events we produce ourselves and events 
+ * already heard from since the requests started are skipped.
+ */
+void pollStateRequests(void) {
+    uint8_t n;
+    uint16_t producer;
+    uint16_t en;
+    
+    if (stateRequestIndex == NO_INDEX) {
+        return;
+    }
+    if (tickTimeSince(lastStateRequestTime) < stateRequestInterval) {
+        return;
+    }
+    if (bulkTxAllowance() == 0) {
+        return;
+    }
+    // only look at a few entries each time round as getEVs() is slow
+    for (n=0; n<STATE_REQUEST_SEARCH; n++) {
+        if (stateRequestIndex >= NUM_EVENTS) {
+            stateRequestIndex = NO_INDEX;
+            opEnd(OP_STATE_REQUESTS);
+            return;
+        }
+        if (validStart(stateRequestIndex) &&
+                ! (stateKnown[stateRequestIndex>>3] & (1 << (stateRequestIndex & 7))) &&
+                hasLedAction(stateRequestIndex)) {
+            producer = getNN(stateRequestIndex);
+            en = getEN(stateRequestIndex);
+            if (producer == 0) {
+                sendMessage4(OPC_ASRQ, 0, 0, (uint8_t)(en>>8), (uint8_t)(en&0xFF));
+            } else if (producer != nn.word) {
+                sendMessage4(OPC_AREQ, (uint8_t)(producer>>8), (uint8_t)(producer&0xFF), (uint8_t)(en>>8), (uint8_t)(en&0xFF));
+            } else {
+                stateRequestIndex++;
+                continue;
+            }
+            stateKnown[stateRequestIndex>>3] |= (uint8_t)(1 << (stateRequestIndex & 7));
+            TRACE(TRACE_STATE_REQUEST, stateRequestIndex, 0, 0);
+            stateRequestIndex++;
+            lastStateRequestTime.val = tickGet();
+            return;
+        }
+        stateRequestIndex++;
+    }
+}
+
+/**
+ * Handle the responses to state requests. These aren't events so are not
+ * passed to APP_processConsumedEvent by the library.
+ * Format is OPC <NN hi><NN lo><EN hi><EN lo>, for the short responses the NN
+ * is the responding node and the event is looked up as a short event.
+ * 
+ * @param m the received message
+ * @return PROCESSED if the message was a state response for one of our events
+ */
+Processed stateResponseMessage(Message * m) {
+    uint8_t tableIndex;
+    EventState state;
+    uint16_t en;
+    
+    switch (m->opc) {
+        case OPC_ARON:
+        case OPC_ARSON:
+#ifdef HANDLE_DATA_EVENTS
+        case OPC_ARON1:
+        case OPC_ARON2:
+        case OPC_ARON3:
+        case OPC_ARSON1:
+        case OPC_ARSON2:
+        case OPC_ARSON3:
+#endif
+            state = EVENT_ON;
+            break;
+        case OPC_AROF:
+        case OPC_ARSOF:
+#ifdef HANDLE_DATA_EVENTS
+        case OPC_AROF1:
+        case OPC_AROF2:
+        case OPC_AROF3:
+        case OPC_ARSOF1:
+        case OPC_ARSOF2:
+        case OPC_ARSOF3:
+#endif
+            state = EVENT_OFF;
+            break;
+        default:
+            return NOT_PROCESSED;
+    }
+    if (m->len < 5) {
+        return NOT_PROCESSED;
+    }
+    if ( ! (getNV(NV_PANEL_FLAGS) & NV_PANEL_FLAGS_STATE_REQUEST)) {
+        return NOT_PROCESSED;
+    }
+    en = (uint16_t)((m->bytes[2]<<8) | m->bytes[3]);
+    switch (m->opc) {
+        case OPC_ARON:
+        case OPC_AROF:
+#ifdef HANDLE_DATA_EVENTS
+        case OPC_ARON1:
+        case OPC_AROF1:
+        case OPC_ARON2:
+        case OPC_AROF2:
+        case OPC_ARON3:
+        case OPC_AROF3:
+#endif
+            tableIndex = findEvent((uint16_t)((m->bytes[0]<<8) | m->bytes[1]), en);
+            break;
+        default:
+            tableIndex = findEvent(0, en);
+            break;
+    }
+    if (tableIndex == NO_INDEX) {
+        return NOT_PROCESSED;
+    }
+    doActions(tableIndex, state, FALSE);
     return PROCESSED;
 }
 
@@ -241,52 +544,58 @@ Boolean alwaysSendInvertedProducedEvent(Happening action, EventState state, Bool
 
 /**
  * Do the consumed SOD. 
- * This sets things up so that timedResponse will call back into APP_doSOD() whenever another response is
+ * This sets things up so that timedResponse will call back into sodTRCallback() whenever another response is
  * required.
  */
 void doSOD(void) {
+    sodNext = 0;
+    opStart(OP_SOD);
+    TRACE(TRACE_SOD, 1, 0, 0);
     startTimedResponse(TIMED_RESPONSE_SOD, findServiceIndex(SERVICE_ID_PRODUCER), sodTRCallback);
 }
 
 /**
- * Send one response message and increment the step counter ready for the next call.
+ * Send a burst of response messages working through the list of SOD enabled PBs.
  * 
- * Here I use step 0 to 63 for 64 keys.
+ * The size of the burst depends upon how much room there is in the CAN TX
+ * buffers so the SOD takes as long as the bus needs to carry the responses 
+ * rather than a fixed time per PB.
  * 
- * This is the callback used by the service discovery responses.
- * @param type always set to TIMED_RESPONSE_NVRD
+ * This is the callback used by the timedResponse.
+ * @param type always set to TIMED_RESPONSE_SOD
  * @param serviceIndex indicates the service requesting the responses
- * @param step loops through each service to be discovered
+ * @param step counts the bursts, the position in the list is held in sodNext
  * @return whether all of the responses have been sent yet.
  */
 TimedResponseResult sodTRCallback(uint8_t type, uint8_t serviceIndex, uint8_t step) {
-    uint8_t io;
+    uint8_t burst;
     uint8_t happeningIndex;
-	Boolean send_on_ok;
-	Boolean send_off_ok;
-	Boolean event_inverted;
     uint8_t flags;
     EventState value;
 
-    // The step is used to index through the events and the channels
-    if (step >= NUM_PB) {
-        return TIMED_RESPONSE_RESULT_FINISHED;
-    }
-    flags = (uint8_t)getNV(NV_PB_FLAGS + step);
-    if (!(flags & NV_PB_FLAGS_ENABLE_SOD)) {
-        return TIMED_RESPONSE_RESULT_NEXT;
+    burst = bulkTxAllowance();
+    if (burst == 0) {
+        return TIMED_RESPONSE_RESULT_RETRY;     // wait for the bus or the buttons
     }
     
-    happeningIndex = PB_2_HAPPENING(step);
-    event_inverted = flags & NV_PB_FLAGS_POLARITY;
-    send_on_ok  = flags & NV_PB_FLAGS_SEND_ON;
-    send_off_ok = flags & NV_PB_FLAGS_SEND_OFF;
-
-    value = APP_GetEventState(happeningIndex);
-             
-    if (value != EVENT_UNKNOWN) {
-        sendInvertedProducedEvent(happeningIndex, value, event_inverted, send_on_ok, send_off_ok);
+    while (burst-- && (sodNext < sodCount)) {
+        happeningIndex = PB_2_HAPPENING(sodPb[sodNext]);
+        flags = sodFlags[sodNext];
+        value = APP_GetEventState(happeningIndex);
+        if (value != EVENT_UNKNOWN) {
+            if (! sendInvertedProducedEvent(happeningIndex, value, 
+                    flags & NV_PB_FLAGS_POLARITY, 
+                    flags & NV_PB_FLAGS_SEND_ON, 
+                    flags & NV_PB_FLAGS_SEND_OFF)) {
+                return TIMED_RESPONSE_RESULT_RETRY;     // try this one again next time
+            }
+        }
+        sodNext++;
+    }
+    if (sodNext >= sodCount) {
+        opEnd(OP_SOD);
+        TRACE(TRACE_SOD, 0, 0, 0);
+        return TIMED_RESPONSE_RESULT_FINISHED;
     }
     return TIMED_RESPONSE_RESULT_NEXT;
 }
-
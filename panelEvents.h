@@ -2,6 +2,7 @@
 #define _PANELEVENTS_H_
 
 #include "module.h"
+#include "vlcb.h"
 
 #define PB_2_HAPPENING(pb) (pb+1)
 #define HAPPENING_2_PB(h)  (h-1)
@@ -10,21 +11,48 @@
 
 //
 // The Action is a 2 byte value.
-// Byte 1 is the LED number 1..64 (65=Specials ))
+// Byte 1 is the LED number 1..LEDS_PER_BANK (LEDS_PER_BANK+1=Specials )
 // Byte 2 is the flags
+// With more than 128 LEDs the LEDs above 128 are in a second bank, selected
+// by ACTION_FLAGS_LED_BANK.
 #define ACTION_FLAGS_ENABLEON       0x01
 #define ACTION_FLAGS_ENABLEOFF      0x02
 #define ACTION_FLAGS_INVERT_EVENT   0x04
 #define ACTION_FLAGS_FLASH          0x08
 #define ACTION_FLAGS_INVERT_FLASH   0x10
+#define ACTION_FLAGS_LED_BANK       0x20
+#define ACTION_FLAGS_TIMER          0xC0    // 1..3 selects NV_LED_DURATION, the LED goes off after it
+#define ACTION_FLAGS_TIMER_SHIFT    6
 
-#define ACTION_SPECIALS         (NUM_LED + 1)
+#if NUM_LED > 128
+#define LEDS_PER_BANK           128
+#else
+#define LEDS_PER_BANK           NUM_LED
+#endif
+
+#define ACTION_SPECIALS         (LEDS_PER_BANK + 1)
 // Special Actions go into the flags byte
 #define ACTION_SPECIAL_SOD      1
 
-#define NUM_ACTIONS             (NUM_LED + 1)
+#define NUM_ACTIONS             (LEDS_PER_BANK + 1)
+
+// SOD responses are sent in bursts limited by the free space in the CAN TX
+// buffers. Leave some room for other traffic and don't hog a single poll.
+#define SOD_TX_HEADROOM         4
+#define SOD_MAX_BURST           8
+// Bulk frames (SOD and state requests) may only keep this many frames in the
+// TX buffers so that a button's event never waits behind more than these
+#define BULK_TX_LIMIT           4
+// Longest bulk frames are held back for operator activity (ms)
+#define BULK_MAX_HOLD           100
+// Number of event table entries examined for each state request poll
+#define STATE_REQUEST_SEARCH    8
 
 void factoryResetGlobalEvents(void);
 void panelEventsInit(void);
+void buildSodList(void);
+void startStateRequests(void);
+void pollStateRequests(void);
+Processed stateResponseMessage(Message * m);
 
 #endif
\ No newline at end of file
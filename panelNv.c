@@ -40,6 +40,42 @@
 #include "panelNv.h"
 #include "nvm.h"
 #include "nv.h"
+#include "panelEvents.h"
+#include "timedResponse.h"
+#include "buttonscan.h"
+#include "max6951.h"
+#include "fastClock.h"
+#include "busMonitor.h"
+#include "panelDiag.h"
+
+/*
+ * The values derived from the NVs which are held by the rest of the code.
+ */
+#define DERIVED_INTENSITY       0x01    // MAX6951 intensity register
+#define DERIVED_RESPONSE_DELAY  0x02    // timed response delay
+#define DERIVED_DECODE_MASK     0x04    // MAX6951 hex decode digits
+#define DERIVED_PB_MASKS        0x08    // per column PB flag masks used by the key scan
+#define DERIVED_SOD_LIST        0x10    // the PBs which take part in SOD
+#define DERIVED_FAST_CLOCK      0x20    // the fast clock window
+#define DERIVED_LED_MAP         0x40    // the LED translation and its NV window
+#define DERIVED_LED_GROUPS      0x80    // the exclusive LED group masks
+
+typedef struct {
+    uint8_t first;      // first NV of the range
+    uint8_t last;       // last NV of the range
+    uint8_t derived;    // DERIVED_ values which depend upon this range
+} NvDependency;
+
+static const NvDependency nvDependencies[] = {
+    {NV_BRIGHTNESS,     NV_BRIGHTNESS,              DERIVED_INTENSITY},
+    {NV_RESPONSE_DELAY, NV_RESPONSE_DELAY,          DERIVED_RESPONSE_DELAY},
+    {NV_SEG_OUTPUTS,    NV_SEG_OUTPUTS,             DERIVED_DECODE_MASK},
+    {NV_PB_FLAGS,       NV_PB_FLAGS + NUM_PB - 1,   DERIVED_PB_MASKS | DERIVED_SOD_LIST},
+    {NV_FAST_CLOCK,     NV_FAST_CLOCK,              DERIVED_FAST_CLOCK},
+    {NV_RESPONSE_DELAY_MIN, NV_RESPONSE_DELAY_MIN,  DERIVED_RESPONSE_DELAY},
+    {NV_LED_MAP_SELECT, NV_LED_MAP_VALUE,           DERIVED_LED_MAP},
+    {NV_LED_GROUPS,     NV_LED_GROUP_LAST(NUM_LED_GROUPS - 1),  DERIVED_LED_GROUPS}
+};
 
 /**
  * The Application specific NV defaults are defined here.
@@ -58,16 +94,79 @@ uint8_t APP_nvDefault(uint8_t index) {
             return 0;
         case NV_BRIGHTNESS:
             return 0;
-        default:    // PB_FLAGS
+        case NV_FAST_CLOCK:
+            return 0;
+        case NV_STATE_REQUEST_INTERVAL:
+            return 20;
+        case NV_STATE_REQUEST_SHARE:
+            return 10;
+        case NV_RESPONSE_DELAY_MIN:
+            return 0xFF;    // fixed NV_RESPONSE_DELAY
+        case NV_LED_MAP_SELECT:
+            return 0;
+        case NV_LED_MAP_VALUE:
+            return 0;
+        case NV_LED_DURATION(1):
+            return 10;      // 1s
+        case NV_LED_DURATION(2):
+            return 50;      // 5s
+        case NV_LED_DURATION(3):
+            return 100;     // 10s
+        case NV_DIAG_CLEAR:
+            return 0;
+        default:    // PB_FLAGS and LED groups
             return 0;
     }
 } 
 
 /**
  * We perform the necessary action when an NV changes value.
+ * Only the values derived from the changed NV are rebuilt, so the change takes
+ * effect straight away without the rest of the code having to read the NVs.
  */
 void APP_nvValueChanged(uint8_t index, uint8_t value, uint8_t oldValue) {
-
+    uint8_t i;
+    uint8_t derived;
+    
+    if (index == NV_DIAG_CLEAR) {
+        panelDiagClear();   // a command, so even if written with the same value
+        return;
+    }
+    if ((value == oldValue) && (index != NV_LED_MAP_VALUE)) {
+        return;     // the stored NV_LED_MAP_VALUE may be for another LED
+    }
+    derived = 0;
+    for (i=0; i<sizeof(nvDependencies)/sizeof(NvDependency); i++) {
+        if ((index >= nvDependencies[i].first) && (index <= nvDependencies[i].last)) {
+            derived |= nvDependencies[i].derived;
+        }
+    }
+    if (derived & DERIVED_INTENSITY) {
+        setLedIntensity(value);
+    }
+    if (derived & DERIVED_RESPONSE_DELAY) {
+        setResponseDelayBounds((uint8_t)getNV(NV_RESPONSE_DELAY_MIN), (uint8_t)getNV(NV_RESPONSE_DELAY));
+    }
+    if (derived & DERIVED_DECODE_MASK) {
+        // only the 7 segment blocks may use hex decode
+        setDecodeMask(getDecodeMask() & (value | fastClockDecodeMask()));
+    }
+    if (derived & DERIVED_PB_MASKS) {
+        buildPbMasks((index - NV_PB_FLAGS) / ROW_INPUTS);
+    }
+    if (derived & DERIVED_SOD_LIST) {
+        buildSodList();
+    }
+    if (derived & DERIVED_FAST_CLOCK) {
+        fastClockInit();
+    }
+    if ((derived & DERIVED_LED_MAP) && (index == NV_LED_MAP_VALUE)) {
+        setLedMapEntry((uint8_t)getNV(NV_LED_MAP_SELECT), value);
+    }
+    if (derived & DERIVED_LED_GROUPS) {
+        i = (index - NV_LED_GROUPS) / 2;
+        setLedGroup(i, (uint8_t)getNV(NV_LED_GROUP_FIRST(i)), (uint8_t)getNV(NV_LED_GROUP_LAST(i)));
+    }
 }
 
 /**
@@ -75,5 +174,14 @@ void APP_nvValueChanged(uint8_t index, uint8_t value, uint8_t oldValue) {
  *
  */
 NvValidation APP_nvValidate(uint8_t index, uint8_t value)  {
+    if ((index == NV_FAST_CLOCK) && (value > 5)) {
+        return INVALID;     // HH:MM must fit in the 8 digits
+    }
+    if ((index == NV_STATE_REQUEST_SHARE) && (value > 100)) {
+        return INVALID;
+    }
+    if ((index >= NV_LED_MAP_SELECT) && (index <= NV_LED_GROUP_LAST(NUM_LED_GROUPS - 1)) && (value > NUM_LED)) {
+        return INVALID;
+    }
     return VALID;
 }
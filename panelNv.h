@@ -44,7 +44,22 @@
 #define NV_TEST_MODE                    7
 // PB flags (NUM_PB) NVs
 #define NV_PB_FLAGS                     8 //send on event, send off event, polarity, toggle, include SoD, uninitialised
-// free at NV_PB_FLAGS + NUM_PB
+// Global NVs following the PB flags
+#define NV_FAST_CLOCK                   (NV_PB_FLAGS + NUM_PB)   // 0 = off, else first digit (1..5) for HH:MM
+#define NV_STATE_REQUEST_INTERVAL       (NV_FAST_CLOCK + 1)     // minimum ms between start up state requests
+#define NV_STATE_REQUEST_SHARE          (NV_FAST_CLOCK + 2)     // max % of the bus used by state requests, 0 no limit
+#define NV_RESPONSE_DELAY_MIN           (NV_FAST_CLOCK + 3)     // ms between responses on a quiet bus, NV_RESPONSE_DELAY is used when busy. Not below NV_RESPONSE_DELAY, e.g. 0xFF, for a fixed delay
+#define NV_LED_MAP_SELECT               (NV_FAST_CLOCK + 4)     // LED whose remap table entry is shown in NV_LED_MAP_VALUE
+#define NV_LED_MAP_VALUE                (NV_FAST_CLOCK + 5)     // LED number the selected LED is wired as, 0 not remapped. Read from the remap table
+#define NV_LED_GROUPS                   (NV_FAST_CLOCK + 6)     // NUM_LED_GROUPS pairs of NVs
+#define NV_LED_GROUP_FIRST(g)           (NV_LED_GROUPS + 2*(g))     // first LED of an exclusive group, 0 unused
+#define NV_LED_GROUP_LAST(g)            (NV_LED_GROUPS + 2*(g) + 1) // last LED of an exclusive group
+#define NV_LED_DURATION(n)              (NV_LED_GROUP_LAST(NUM_LED_GROUPS - 1) + (n))  // n=1..3, timed LED actions in 100ms
+#define NV_DIAG_CLEAR                   (NV_LED_DURATION(3) + 1)    // any write clears the CANPANEL diagnostic counters
+// free at NV_DIAG_CLEAR + 1
+
+#define NV_PANEL_FLAGS_STATE_REQUEST    0x08    // request the state of consumed events at start up
+#define NV_PANEL_FLAGS_SNAPSHOT         0x10    // save the LED state to EEPROM and show it at power up
 
 #define NV_PB_FLAGS_SEND_ON             0x01
 #define NV_PB_FLAGS_SEND_OFF            0x02
@@ -52,5 +67,4 @@
 #define NV_PB_FLAGS_TOGGLE              0x08
 #define NV_PB_FLAGS_ENABLE_SOD         0x10
 
-
 #endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * PORTC arbiter for the CANPANEL.
+ *
+ * PORTC carries the button column strobes but RC3, RC5 and RC6 are also the
+ * SPI clock, data and chip select for the MAX6951. When the buttons are read
+ * by the timer interrupt (KEYSCAN_ISR) the pins are owned by one side at a 
+ * time:
+ * <UL>
+ * <LI>Every SPI session claims the pins in mxBegin() and releases them in
+ * mxEnd(). Whilst claimed the key scan interrupt is held off, so a column read
+ * which falls due waits and runs as soon as the pins are released.</LI>
+ * <LI>flushLeds() only starts a batch of up to LED_BATCH_DIGITS digits if the 
+ * next column read isn't due within LED_SLOT_MARGIN, so the batch fits in the 
+ * gap between reads.</LI>
+ * </UL>
+ * So a column read is delayed by at most one batch and LED updates only wait
+ * for the gap after the next read.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include "vlcb.h"
+#include "module.h"
+#include "portArbiter.h"
+#include "buttonscan.h"
+
+ArbiterStats arbiterStats;
+
+#ifdef KEYSCAN_ISR
+
+static Boolean keyScanEnable;      // key scan interrupt enable to restore
+static uint8_t claims;             // nested claims, so a caller can hold the pins across sessions
+
+/**
+ * Check whether an LED batch fits before the next column read. Called from
+ * the main loop before starting a batch.
+ * On the K80 the Timer 2 postscaler count can't be read, so the margin is 
+ * checked against the end of every timer period. That refuses some slots 
+ * which were in fact free but never grants one which isn't.
+ * @return TRUE if there is time for a batch
+ */
+Boolean spiSlotFree(void) {
+    uint8_t remaining;
+    
+#if defined(_18FXXQ83_FAMILY_)
+    remaining = (uint8_t)(T2PR - T2TMR);
+#endif
+#if defined(_18F66K80_FAMILY_)
+    remaining = (uint8_t)(PR2 - TMR2);
+#endif
+    if (remaining < LED_SLOT_MARGIN) {
+        arbiterStats.spiRefusals++;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Claim the pins for an SPI session. Called by mxBegin() so every write to 
+ * the MAX chips is covered, and may also be called around several sessions
+ * to keep the pins between them. A column read which falls due before the
+ * last releasePinsFromSpi() waits until then.
+ */
+void claimPinsForSpi(void) {
+    if (claims++ == 0) {
+        holdKeyScan(keyScanEnable);
+        arbiterStats.spiGrants++;
+    }
+}
+
+/**
+ * Give the pins back at the end of an SPI session. If a column read was held
+ * back the interrupt is taken straight away.
+ */
+void releasePinsFromSpi(void) {
+    if (--claims != 0) {
+        return;
+    }
+    if (KEYSCAN_TIMER_IF) {
+        arbiterStats.strobeDeferrals++;
+    }
+    resumeKeyScan(keyScanEnable);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef _PORTARBITER_H_
+#define _PORTARBITER_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Share the PORTC pins between the button column strobes and the SPI to the
+ * MAX6951.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+
+// Most digits sent to the MAX chip each time the pins are granted
+#define LED_BATCH_DIGITS        4
+// Timer 2 counts needed before the next column read to start a batch
+#if defined(_18FXXQ83_FAMILY_)
+#define LED_SLOT_MARGIN         20      // 8us counts
+#endif
+#if defined(_18F66K80_FAMILY_)
+#define LED_SLOT_MARGIN         160     // 1us counts
+#endif
+
+/*
+ * Counts of what has happened, for diagnostics.
+ */
+typedef struct {
+    uint16_t spiGrants;         // times the pins were taken for SPI
+    uint16_t spiRefusals;       // LED batches held back for a column read
+    uint16_t strobeDeferrals;   // column reads held back for an SPI session
+} ArbiterStats;
+
+extern ArbiterStats arbiterStats;
+
+#ifdef KEYSCAN_ISR
+Boolean spiSlotFree(void);
+void claimPinsForSpi(void);
+void releasePinsFromSpi(void);
+#else
+// without the ISR the key scan and the LEDs are both run from loop()
+#define spiSlotFree()           TRUE
+#define claimPinsForSpi()
+#define releasePinsFromSpi()
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Cycle budget profiling for the CANPANEL.
+ *
+ * Timer 1 free runs at Fosc/32 (0.5us per count at 64MHz) and the start and
+ * end times of each profiled region are taken from it. Regions up to 32ms 
+ * long can be measured. The table can be read and reset using RDGN, see
+ * panelDiag.c.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include <string.h>
+#include "vlcb.h"
+#include "module.h"
+#include "buttonscan.h"
+#include "profile.h"
+
+#ifdef PROFILE
+
+ProfileEntry profileTable[NUM_PROFILE_REGIONS];
+
+/**
+ * Start the timer and clear the table.
+ */
+void initProfile(void) {
+#if defined(_18FXXQ83_FAMILY_)
+    T1CLK = 0x01;       // Fosc/4
+#endif
+    T1CON = 0x33;       // 1:8 prescale, 16 bit reads, on
+    resetProfile();
+}
+
+/**
+ * Clear the table.
+ */
+void resetProfile(void) {
+    Boolean intState;
+    
+    holdKeyScan(intState);
+    memset((void *)profileTable, 0, sizeof(profileTable));
+    resumeKeyScan(intState);
+}
+
+/**
+ * Add the time since start to the region's entry.
+ * @param region the PROFILE_ region
+ * @param start the Timer 1 value at the start of the region
+ */
+void profileRecord(uint8_t region, uint16_t start) {
+    uint16_t elapsed;
+    ProfileEntry * e;
+    
+    elapsed = profileTime() - start;
+    e = &profileTable[region];
+    e->count++;
+    e->total += elapsed;
+    if (elapsed > e->max) {
+        e->max = elapsed;
+    }
+}
+
+#endif
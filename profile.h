@@ -0,0 +1,76 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Optional measurement of where the CPU time goes.
+ * 
+ * Wrap a region of code in PROFILE_START(region) and PROFILE_END(region) and
+ * the number of times it ran, the total time and the longest time are kept in
+ * profileTable[]. Times are in Timer 1 counts of 0.5us. When PROFILE is not 
+ * defined the macros compile to nothing.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+
+#define PROFILE_LOOP            0   // loop()
+#define PROFILE_KEYSCAN         1   // keyScan()
+#define PROFILE_CONSUMED_EVENT  2   // APP_processConsumedEvent()
+#define PROFILE_MX_CMD          3   // a MAX chip register write
+#define PROFILE_FLASH_WRITE     4   // stall caused by a flash write
+#define PROFILE_KEYSCAN_ISR     5   // key scan timer interrupt
+#define NUM_PROFILE_REGIONS     6
+
+#ifdef PROFILE
+typedef struct {
+    uint16_t count;
+    uint16_t max;
+    uint32_t total;
+} ProfileEntry;
+
+extern ProfileEntry profileTable[NUM_PROFILE_REGIONS];
+
+void initProfile(void);
+void resetProfile(void);
+void profileRecord(uint8_t region, uint16_t start);
+#define profileTime()           (TMR1)
+#define PROFILE_START(region)   uint16_t profileStart##region = profileTime()
+#define PROFILE_END(region)     profileRecord(region, profileStart##region)
+#else
+#define PROFILE_START(region)
+#define PROFILE_END(region)
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Cooperative task scheduler for the CANPANEL.
+ *
+ * The activities which used to each have their own tickTimeSince() check in
+ * loop() are listed in the tasks[] table with how often they should run and
+ * how urgent they are. Each call of schedulerRun() runs the single most 
+ * urgent task which is due, so a slow task can delay the key scan by at most
+ * one task's runtime.
+ * 
+ * The number of runs, the worst runtime and the number of deadline misses are
+ * kept for each task in taskStats[].
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "scheduler.h"
+
+TaskStats taskStats[NUM_TASKS];
+
+/**
+ * Start all the tasks' periods from now.
+ */
+void schedulerInit(void) {
+    uint8_t t;
+    
+    for (t = 0; t < NUM_TASKS; t++) {
+        taskStats[t].lastRun.val = tickGet();
+        taskStats[t].runs = 0;
+        taskStats[t].worstRuntime = 0;
+        taskStats[t].misses = 0;
+    }
+}
+
+/**
+ * Run the most urgent task which is due. Called from loop().
+ */
+void schedulerRun(void) {
+    uint8_t t;
+    uint8_t best;
+    uint32_t now;
+    uint32_t late;
+    uint32_t runtime;
+    uint32_t bestLate;
+    
+    now = tickGet();
+    best = NUM_TASKS;
+    bestLate = 0;
+    for (t = 0; t < NUM_TASKS; t++) {
+        if (now - taskStats[t].lastRun.val < tasks[t].period) {
+            continue;
+        }
+        late = now - taskStats[t].lastRun.val - tasks[t].period;
+        // most urgent first then the one which has waited longest
+        if ((best == NUM_TASKS) || 
+                (tasks[t].priority < tasks[best].priority) ||
+                ((tasks[t].priority == tasks[best].priority) && (late > bestLate))) {
+            best = t;
+            bestLate = late;
+        }
+    }
+    if (best == NUM_TASKS) {
+        return;
+    }
+    
+    if ((tasks[best].period != 0) && (bestLate > tasks[best].deadline)) {
+        taskStats[best].misses++;
+    }
+    taskStats[best].lastRun.val = now;
+    tasks[best].run();
+    runtime = tickGet() - now;
+    if (runtime > 0xFFFF) {
+        runtime = 0xFFFF;
+    }
+    if (runtime > taskStats[best].worstRuntime) {
+        taskStats[best].worstRuntime = (uint16_t)runtime;
+    }
+    taskStats[best].runs++;
+}
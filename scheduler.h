@@ -0,0 +1,73 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * A simple cooperative scheduler for the activities run from loop().
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+#include "ticktime.h"
+
+/*
+ * A task is run when period ticks have passed since it last ran. If it hasn't
+ * run within deadline ticks of becoming due that is counted as a miss.
+ * When several tasks are due the one with the lowest priority value runs.
+ */
+typedef struct {
+    void (* run)(void);
+    uint16_t period;        // ticks between runs, 0 for every time round (use the lowest priority)
+    uint16_t deadline;      // ticks after becoming due
+    uint8_t priority;       // 0 is the most urgent
+} Task;
+
+/*
+ * Times are in ticks (16us) and saturate at 0xFFFF.
+ */
+typedef struct {
+    TickValue lastRun;
+    uint16_t runs;
+    uint16_t worstRuntime;
+    uint16_t misses;
+} TaskStats;
+
+// The task table is provided by the application
+extern const Task tasks[NUM_TASKS];
+extern TaskStats taskStats[NUM_TASKS];
+
+void schedulerInit(void);
+void schedulerRun(void);
+
+#endif
@@ -0,0 +1,108 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Start of day scheduling for the CANPANEL.
+ *
+ * Every panel waits for the power up delay plus NV_SOD_DELAY before sending
+ * its SOD. When a whole layout is powered up together this puts the SODs, and
+ * all the responses they generate, on the bus at the same time. 
+ * 
+ * To spread them out each panel picks a slot within the TWO_SECOND wait from
+ * its node number and CANID. This is deterministic so a panel always starts 
+ * in the same slot and different panels on the same layout nearly always get
+ * different slots. Once the slot is reached the SOD is held back whilst the 
+ * bus is busy with other panels' start of day traffic, but never beyond the 
+ * end of the original wait so no panel starts later than it used to.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include "vlcb.h"
+#include "module.h"
+#include "nvm.h"
+#include "nv.h"
+#include "mns.h"
+#include "ticktime.h"
+#include "startup.h"
+#include "busMonitor.h"
+
+#define NUM_STAGGER_SLOTS   (STARTUP_STAGGER_WINDOW/STARTUP_STAGGER_SLOT)
+
+static TickValue startTime;             // when the power up delay started
+static uint32_t startDelay;             // ticks from startTime until the SOD is due
+static uint32_t latestStart;            // ticks from startTime after which the SOD isn't held back
+static Boolean done;
+
+/**
+ * Work out when this panel's SOD is due. Called once at power up.
+ */
+void startupInit(void) {
+    uint16_t hash;
+    uint8_t canid;
+
+    canid = (uint8_t)readNVM(CANID_NVM_TYPE, CANID_ADDRESS);
+    // mix the bits so that consecutive node numbers are spread across the window
+    hash = nn.word ^ (nn.word >> 7);
+    hash = (uint16_t)(hash * 31 + canid);
+    hash ^= hash >> 5;
+
+    latestStart = TWO_SECOND + (uint32_t)getNV(NV_SOD_DELAY) * HUNDRED_MILI_SECOND;
+    startDelay = (uint32_t)getNV(NV_SOD_DELAY) * HUNDRED_MILI_SECOND + 
+            (uint32_t)STARTUP_MIN_DELAY * ONE_MILI_SECOND +
+            (uint32_t)(hash % NUM_STAGGER_SLOTS) * STARTUP_STAGGER_SLOT * ONE_MILI_SECOND;
+
+    startTime.val = tickGet();
+    done = FALSE;
+}
+
+/**
+ * Check whether it is time to send the SOD. 
+ * @return TRUE once, when the SOD should be sent
+ */
+Boolean startupDue(void) {
+    uint32_t elapsed;
+
+    if (done) {
+        return FALSE;
+    }
+    elapsed = tickTimeSince(startTime);
+    if (elapsed <= startDelay) {
+        return FALSE;
+    }
+    // hold back whilst other panels are busy, but not beyond the original wait
+    if ((busLastSlotFrames() > STARTUP_BUSY_MESSAGES) && (elapsed <= latestStart)) {
+        return FALSE;
+    }
+    done = TRUE;
+    return TRUE;
+}
@@ -0,0 +1,57 @@
+#ifndef _STARTUP_H_
+#define _STARTUP_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Schedule the start of day so that many panels powered up together don't
+ * all send their SOD at the same instant.
+ *
+ * @date October 2026
+ */ 
+
+#include "vlcb.h"
+
+// Shortest wait after power up before the SOD (ms)
+#define STARTUP_MIN_DELAY           500
+// Window over which the node number/CANID derived offset is spread (ms). The
+// SOD is due by the end of the original TWO_SECOND wait.
+#define STARTUP_STAGGER_WINDOW      (2000 - STARTUP_MIN_DELAY)
+// Granularity of the offset within the window (ms)
+#define STARTUP_STAGGER_SLOT        20
+// Number of messages received in a BUS_SLOT_TIME above which the bus is busy
+#define STARTUP_BUSY_MESSAGES       30
+
+void startupInit(void);
+Boolean startupDue(void);
+
+#endif
@@ -0,0 +1,124 @@
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Trace buffer for the CANPANEL.
+ *
+ * The last TRACE_SIZE consumed events, state responses, LED writes, produced
+ * events and state requests are kept with the time they happened. Reading
+ * the trace using RDGN (see panelDiag.c) first freezes it so that the entries
+ * don't move whilst they are read out, the trace restarts when reset.
+ *
+ * @date October 2026
+ */ 
+
+#include <xc.h>
+#include "vlcb.h"
+#include "module.h"
+#include "ticktime.h"
+#include "trace.h"
+
+#ifdef TRACE_BUFFER
+
+static TraceEntry traceBuffer[TRACE_SIZE];
+static uint8_t traceNext;       // where the next entry goes
+static uint8_t traceCount;
+static Boolean traceFrozen;
+
+/**
+ * Add an entry to the trace, replacing the oldest once the trace is full.
+ * @param type the TRACE_ type
+ * @param a first data byte
+ * @param b second data byte
+ * @param c third data byte
+ */
+void traceAdd(uint8_t type, uint8_t a, uint8_t b, uint8_t c) {
+    TraceEntry * t;
+    
+    if (traceFrozen) {
+        return;
+    }
+    t = &traceBuffer[traceNext];
+    t->time = (uint16_t)(tickGet() / ONE_MILI_SECOND);
+    t->type = type;
+    t->data[0] = a;
+    t->data[1] = b;
+    t->data[2] = c;
+    traceNext = (traceNext + 1) & (TRACE_SIZE - 1);
+    if (traceCount < TRACE_SIZE) {
+        traceCount++;
+    }
+}
+
+/**
+ * Empty the trace and start recording again.
+ */
+void traceReset(void) {
+    traceNext = 0;
+    traceCount = 0;
+    traceFrozen = FALSE;
+}
+
+/**
+ * Stop recording so the trace can be read.
+ * @return the number of entries
+ */
+uint8_t traceFreeze(void) {
+    traceFrozen = TRUE;
+    return traceCount;
+}
+
+/**
+ * Get part of an entry. Each entry is TRACE_ENTRY_WORDS words: the time, 
+ * then the type and first data byte, then the other two data bytes.
+ * @param index the word, counting from the oldest entry
+ * @return the value
+ */
+uint16_t traceWord(uint8_t index) {
+    TraceEntry * t;
+    uint8_t entry;
+    
+    entry = index / TRACE_ENTRY_WORDS;
+    if (entry >= traceCount) {
+        return 0;
+    }
+    t = &traceBuffer[(traceNext - traceCount + entry) & (TRACE_SIZE - 1)];
+    switch (index % TRACE_ENTRY_WORDS) {
+        case 0:
+            return t->time;
+        case 1:
+            return (uint16_t)((t->type << 8) | t->data[0]);
+        default:
+            return (uint16_t)((t->data[1] << 8) | t->data[2]);
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/*
+  This work is licensed under the:
+      Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+   To view a copy of this license, visit:
+      http://creativecommons.org/licenses/by-nc-sa/4.0/
+   or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+   License summary:
+    You are free to:
+      Share, copy and redistribute the material in any medium or format
+      Adapt, remix, transform, and build upon the material
+
+    The licensor cannot revoke these freedoms as long as you follow the license terms.
+
+    Attribution : You must give appropriate credit, provide a link to the license,
+                   and indicate if changes were made. You may do so in any reasonable manner,
+                   but not in any way that suggests the licensor endorses you or your use.
+
+    NonCommercial : You may not use the material for commercial purposes. **(see note below)
+
+    ShareAlike : If you remix, transform, or build upon the material, you must distribute
+                  your contributions under the same license as the original.
+
+    No additional restrictions : You may not apply legal terms or technological measures that
+                                  legally restrict others from doing anything the license permits.
+
+   ** For commercial use, please contact the original copyright holder(s) to agree licensing terms
+
+    This software is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE
+ */
+/**
+ * Optional timeline of what the panel has been doing, so a problem seen on
+ * the layout can be read back over the bus.
+ * 
+ * TRACE(type, a, b, c) adds an entry. When TRACE_BUFFER is not defined it 
+ * compiles to nothing.
+ *
+ * @date October 2026
+ */ 
+
+#include "module.h"
+
+#define TRACE_SIZE          32      // entries kept, must be a power of 2
+
+// Entry types and their data
+#define TRACE_EVENT         1       // table index, state, 1 if consumed or 0 if a state response
+#define TRACE_LED           2       // chip*8 + digit, plane 0, plane 1 as sent to the MAX chip
+#define TRACE_PRODUCED      3       // PB, state, 0
+#define TRACE_STATE_REQUEST 4       // table index, 0, 0
+#define TRACE_SOD           5       // 1 at the start, 0 at the end, 0
+
+typedef struct {
+    uint16_t time;          // ms, wraps
+    uint8_t type;
+    uint8_t data[3];
+} TraceEntry;
+
+#define TRACE_ENTRY_WORDS   3       // the words in TraceEntry, used by #if
+
+#ifdef TRACE_BUFFER
+void traceAdd(uint8_t type, uint8_t a, uint8_t b, uint8_t c);
+void traceReset(void);
+uint8_t traceFreeze(void);
+uint16_t traceWord(uint8_t index);
+#define TRACE(type, a, b, c)    traceAdd(type, a, b, c)
+#else
+#define TRACE(type, a, b, c)
+#endif
+
+#endif